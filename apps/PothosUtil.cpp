@@ -21,7 +21,8 @@ public:
         _docParseRequested(false),
         _deviceInfoRequested(false),
         _runTopologyRequested(false),
-        _simdFeaturesRequested(false)
+        _simdFeaturesRequested(false),
+        _benchmarksRequested(false)
     {
         this->setUnixOptions(true); //always unix style --option
 
@@ -132,6 +133,27 @@ protected:
             .argument("pluginPath")
             .callback(Poco::Util::OptionCallback<PothosUtil>(this, &PothosUtil::selfTestOne)));
 
+        options.addOption(Poco::Util::Option("benchmarks", "",
+            "Run the benchmark suite and report the results as JSON.\n"
+            "Specify an optional plugin path or glob rule to select benchmarks. "
+            "Use with --output to write the results to file.")
+            .required(false)
+            .repeatable(false)
+            .argument("pluginPath", false/*optional*/)
+            .binding("benchmarksPath"));
+
+        options.addOption(Poco::Util::Option("bench-module", "", "the benchmark suite module to load (default: the installed module)")
+            .required(false)
+            .repeatable(false)
+            .argument("benchModule")
+            .binding("benchModule"));
+
+        options.addOption(Poco::Util::Option("bench-time", "", "the measurement time in seconds for each benchmark result (default 1.0)")
+            .required(false)
+            .repeatable(false)
+            .argument("benchTime")
+            .binding("benchTime"));
+
         options.addOption(Poco::Util::Option("num-trials", "", "how many times to run each self test")
             .required(false)
             .repeatable(false)
@@ -203,6 +225,7 @@ protected:
         if (name == "device-info") _deviceInfoRequested = true;
         if (name == "run-topology") _runTopologyRequested = true;
         if (name == "simd-features") _simdFeaturesRequested = true;
+        if (name == "benchmarks") _benchmarksRequested = true;
         if (name == "help") this->stopOptionsProcessing();
 
         //store --var options into the ordered vars map
@@ -238,6 +261,7 @@ protected:
             else if (_deviceInfoRequested) this->printDeviceInfo();
             else if (_runTopologyRequested) this->runTopology();
             else if (_simdFeaturesRequested) this->printSIMDFeatures();
+            else if (_benchmarksRequested) this->runBenchmarks();
         }
         catch(const Pothos::Exception &ex)
         {
@@ -254,6 +278,7 @@ private:
     bool _deviceInfoRequested;
     bool _runTopologyRequested;
     bool _simdFeaturesRequested;
+    bool _benchmarksRequested;
 };
 
 int main(int argc, char *argv[])
@@ -0,0 +1,115 @@
+// Copyright (c) 2013-2020 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PothosUtil.hpp"
+#include <Pothos/Plugin.hpp>
+#include <Pothos/System.hpp>
+#include <Pothos/Exception.hpp>
+#include <Poco/Path.h>
+#include <Poco/File.h>
+#include <Poco/Glob.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+static void findBenchmarksR(const Pothos::PluginPath &path, Poco::Glob &glob, std::vector<Pothos::PluginPath> &paths)
+{
+    if (not Pothos::PluginRegistry::empty(path) and glob.match(path.toString()))
+    {
+        const auto plugin = Pothos::PluginRegistry::get(path);
+        if (plugin.getObject().type() == typeid(Pothos::Callable)) paths.push_back(path);
+    }
+    for (const auto &name : Pothos::PluginRegistry::list(path))
+    {
+        findBenchmarksR(path.join(name), glob, paths);
+    }
+}
+
+void PothosUtilBase::runBenchmarks(void)
+{
+    Pothos::ScopedInit init;
+
+    //the suite is a separate module which is only loaded here
+    Poco::Path defaultModulePath(Pothos::System::getPothosDevLibraryPath());
+    defaultModulePath.append("Pothos");
+    defaultModulePath.append("benchmarks");
+    defaultModulePath.append("PothosBenchmarks" POTHOS_MODULE_SUFFIX);
+    const auto modulePath = this->config().getString("benchModule", defaultModulePath.toString());
+    if (not Poco::File(modulePath).exists())
+    {
+        throw Pothos::FileNotFoundException("PothosUtilBase::runBenchmarks()",
+            modulePath+" (configure with -DENABLE_BENCHMARKS=ON)");
+    }
+    Pothos::PluginModule module(modulePath);
+
+    //the benchmarks are located under /benchmarks, path is a subtree or a glob rule
+    const auto path = this->config().getString("benchmarksPath", "");
+    const auto benchTime = this->config().getDouble("benchTime", 1.0);
+    std::vector<Pothos::PluginPath> paths;
+    if (path.find('*') == std::string::npos)
+    {
+        Poco::Glob glob("*"); //not globing, match all
+        findBenchmarksR(path.empty()? "/benchmarks" : path, glob, paths);
+    }
+    else
+    {
+        Poco::Glob glob(path);
+        findBenchmarksR("/benchmarks", glob, paths);
+    }
+
+    //describe the system so results can be compared between releases
+    const auto info = Pothos::System::HostInfo::get();
+    json top;
+    top["apiVersion"] = Pothos::System::getApiVersion();
+    top["abiVersion"] = Pothos::System::getAbiVersion();
+    top["libVersion"] = Pothos::System::getLibVersion();
+    top["osName"] = info.osName;
+    top["osVersion"] = info.osVersion;
+    top["osArchitecture"] = info.osArchitecture;
+    top["processorCount"] = info.processorCount;
+    top["benchTime"] = benchTime;
+    top["benchmarks"] = json::array();
+
+    //progress goes to stderr so that stdout only has the results
+    for (const auto &benchPath : paths)
+    {
+        std::cerr << ">>> Benchmark " << benchPath.toString() << "... " << std::flush;
+        json benchObj;
+        benchObj["path"] = benchPath.toString();
+        try
+        {
+            auto call = Pothos::PluginRegistry::get(benchPath).getObject().extract<Pothos::Callable>();
+            benchObj["results"] = json::parse(call.call<std::string>(benchTime));
+            std::cerr << "done" << std::endl;
+        }
+        catch (const Pothos::Exception &ex)
+        {
+            benchObj["error"] = ex.displayText();
+            std::cerr << "FAIL: " << ex.displayText() << std::endl;
+        }
+        catch (const std::exception &ex)
+        {
+            benchObj["error"] = ex.what();
+            std::cerr << "FAIL: " << ex.what() << std::endl;
+        }
+        top["benchmarks"].push_back(benchObj);
+    }
+
+    //dump the results to file
+    if (this->config().has("outputFile"))
+    {
+        const auto resultsFile = this->config().getString("outputFile");
+        std::cerr << ">>> Dumping results: " << resultsFile << std::endl;
+        std::ofstream ofs(Poco::Path::expand(resultsFile));
+        ofs << top.dump(4) << std::endl;
+    }
+    //or otherwise to stdout
+    else
+    {
+        std::cout << top.dump(4) << std::endl;
+    }
+}
@@ -8,8 +8,12 @@
 #include <Poco/Net/ServerSocket.h>
 #include <Poco/Net/SocketStream.h>
 #include <Poco/Net/TCPServer.h>
+#include <Poco/Net/TCPServerParams.h>
+#include <Poco/ThreadPool.h>
 #include <Poco/Process.h>
+#include <Poco/File.h>
 #include <Poco/URI.h>
+#include <memory>
 #include <mutex>
 #include <cassert>
 #include <iostream>
@@ -67,7 +71,8 @@ public:
     MyTCPServerConnection(MyTCPServerConnectionFactory &factory, const Poco::Net::StreamSocket &socket):
         Poco::Net::TCPServerConnection(socket),
         _factory(factory),
-        _handler(Pothos::RemoteHandler(socket.peerAddress().host().toString()))
+        _local(isLocalSocket(socket)),
+        _handler(Pothos::RemoteHandler(_local?"127.0.0.1":socket.peerAddress().host().toString()))
     {
         _factory.connectionStart();
     }
@@ -79,13 +84,25 @@ public:
 
     void run(void)
     {
-        this->socket().setNoDelay(true);
+        if (not _local) this->socket().setNoDelay(true);
         Poco::Net::SocketStream socketStream(this->socket());
         _handler.runHandler(socketStream, socketStream);
     }
 
 private:
+    //! Connections on the local socket come from clients on this host
+    static bool isLocalSocket(const Poco::Net::StreamSocket &socket)
+    {
+        #ifdef POCO_HAS_UNIX_SOCKET
+        return socket.address().family() == Poco::Net::SocketAddress::UNIX_LOCAL;
+        #else
+        (void)socket;
+        return false;
+        #endif
+    }
+
     MyTCPServerConnectionFactory &_factory;
+    const bool _local;
     Pothos::RemoteHandler _handler;
 };
 
@@ -133,13 +150,61 @@ void PothosUtilBase::proxyServer(const std::string &, const std::string &uriStr)
     Poco::Net::ServerSocket serverSocket(sa);
     Poco::Net::TCPServerConnectionFactory::Ptr factory;
     factory = new MyTCPServerConnectionFactory(this->config().hasOption("requireActive"));
-    Poco::Net::TCPServer tcpServer(factory, serverSocket);
+
+    //each connection holds a thread until the client disconnects,
+    //so that one busy client does not block the other clients,
+    //the default pool would queue connections past its capacity
+    const int maxConnections = 1024;
+    Poco::ThreadPool threadPool(2, maxConnections);
+    Poco::Net::TCPServerParams::Ptr params(new Poco::Net::TCPServerParams());
+    params->setMaxThreads(maxConnections);
+    Poco::Net::TCPServer tcpServer(factory, threadPool, serverSocket, params);
 
     //start the server
     tcpServer.start();
+
+    //clients on this host connect through a local socket when supported
+    const auto actualPort = std::to_string(serverSocket.address().port());
+    const auto localPath = Pothos::RemoteServer::getLocalSocketPath(actualPort);
+    std::unique_ptr<Poco::Net::TCPServer> localServer;
+    #ifdef POCO_HAS_UNIX_SOCKET
+    if (localPath.empty())
+    {
+        std::cerr << "Proxy server: local socket unavailable - per-user socket directory is not private" << std::endl;
+    }
+    else
+    {
+        try
+        {
+            //a stale file from a server that exited uncleanly fails the bind,
+            //only this user can create files in the per-user directory
+            Poco::File localFile(localPath);
+            if (localFile.exists()) localFile.remove();
+            Poco::Net::ServerSocket localSocket(Poco::Net::SocketAddress(Poco::Net::SocketAddress::UNIX_LOCAL, localPath));
+            Poco::Net::TCPServerParams::Ptr localParams(new Poco::Net::TCPServerParams());
+            localParams->setMaxThreads(maxConnections);
+            localServer.reset(new Poco::Net::TCPServer(factory, threadPool, localSocket, localParams));
+            localServer->start();
+            std::cout << "Local: " << localPath << std::endl;
+        }
+        catch (const Poco::Exception &ex)
+        {
+            //clients fall back to TCP
+            std::cerr << "Proxy server: local socket unavailable - " << ex.displayText() << std::endl;
+            localServer.reset();
+        }
+    }
+    #endif
+
     std::cout << "Host: " << serverSocket.address().host().toString() << std::endl;
-    std::cout << "Port: " << serverSocket.address().port() << std::endl;
+    std::cout << "Port: " << actualPort << std::endl;
 
     //wait here until the term signal is received
     this->waitForTerminationRequest();
+
+    if (localServer)
+    {
+        localServer->stop();
+        Poco::File(localPath).remove();
+    }
 }
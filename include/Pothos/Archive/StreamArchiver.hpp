@@ -14,6 +14,20 @@
 #include <iosfwd>
 #include <cstddef> //size_t
 
+/*!
+ * The archive version that every release can read.
+ * Numeric vectors are serialized element by element.
+ * Archivers write this version unless a version is specified.
+ */
+#define POTHOS_ARCHIVE_VERSION_COMPAT 2
+
+/*!
+ * The newest archive version, numeric vectors are serialized as a block.
+ * Readers before this version do not check the version of an archive,
+ * so only write this version to a reader that reported support for it.
+ */
+#define POTHOS_ARCHIVE_VERSION 3
+
 namespace Pothos {
 namespace Archive {
 
@@ -25,10 +39,19 @@ class POTHOS_API OStreamArchiver
 public:
     /*!
      * Create an output stream archiver
+     * that writes the version every release can read.
      * \param os the stream to write to
      */
     OStreamArchiver(std::ostream &os);
 
+    /*!
+     * Create an output stream archiver for a specific version.
+     * \throws ArchiveException when the version is not supported
+     * \param os the stream to write to
+     * \param version the archive version to write
+     */
+    OStreamArchiver(std::ostream &os, const unsigned int version);
+
     //! Tell the invoker that this archiver saves
     typedef std::true_type isSave;
 
@@ -65,6 +88,7 @@ class POTHOS_API IStreamArchiver
 public:
     /*!
      * Create an input stream archiver
+     * \throws ArchiveException when the archive version is not supported
      * \param is the stream to read from
      */
     IStreamArchiver(std::istream &is);
@@ -3,6 +3,11 @@
 ///
 /// Vector support for serialization.
 ///
+/// Since archive version 3, vectors of numbers and complex numbers
+/// are serialized as a single block of little endian elements.
+/// Like the individual numbers, long types are serialized as 8 bytes.
+/// Earlier versions serialize each element individually.
+///
 /// \copyright
 /// Copyright (c) 2016-2019 Josh Blum
 /// SPDX-License-Identifier: BSL-1.0
@@ -12,7 +17,12 @@
 #include <Pothos/Config.hpp>
 #include <Pothos/Archive/Invoke.hpp>
 #include <Pothos/Archive/Numbers.hpp>
+#include <Pothos/Archive/Complex.hpp>
+#include <Pothos/Archive/BinaryObject.hpp>
+#include <type_traits>
+#include <algorithm> //reverse
 #include <utility> //move
+#include <complex>
 #include <vector>
 
 namespace Pothos {
@@ -43,9 +53,145 @@ void load(Archive &ar, std::vector<bool, Allocator> &t, const unsigned int)
     }
 }
 
+//------------ numeric vectors use a block of elements --------------//
+namespace detail {
+
+//! Numbers and complex numbers that are serialized as a block
+template <typename T>
+struct isBlockElement : std::integral_constant<bool,
+    std::is_arithmetic<T>::value and not std::is_same<T, bool>::value>
+{};
+
+template <typename T>
+struct isBlockElement<std::complex<T>> : isBlockElement<T>
+{};
+
+//! The type of an element in the block, long types are always 8 bytes
+template <typename T>
+struct blockWire
+{
+    typedef T type;
+};
+
+template <>
+struct blockWire<long>
+{
+    typedef long long type;
+};
+
+template <>
+struct blockWire<unsigned long>
+{
+    typedef unsigned long long type;
+};
+
+//! The scalar type which determines the byte order of an element
+template <typename T>
+struct blockScalar
+{
+    typedef T type;
+};
+
+template <typename T>
+struct blockScalar<std::complex<T>>
+{
+    typedef T type;
+};
+
+inline bool isLittleEndian(void)
+{
+    const unsigned short one(1);
+    return *reinterpret_cast<const unsigned char *>(&one) == 1;
+}
+
+//! Swap the byte order of each scalar in a block of elements
+template <typename T>
+void swapBlockBytes(T *elems, const size_t numElems)
+{
+    const size_t width = sizeof(typename blockScalar<T>::type);
+    auto p = reinterpret_cast<unsigned char *>(elems);
+    for (size_t i = 0; i < numElems*sizeof(T); i += width)
+    {
+        std::reverse(p+i, p+i+width);
+    }
+}
+
+} //namespace detail
+
+template<typename Archive, typename T, typename Allocator>
+typename std::enable_if<detail::isBlockElement<T>::value>::type
+save(Archive &ar, const std::vector<T, Allocator> &t, const unsigned int ver)
+{
+    typedef typename detail::blockWire<T>::type WireType;
+    ar << unsigned(t.size());
+
+    //archives before version 3 serialize each element
+    if (ver < 3)
+    {
+        for (const auto &elem : t)
+        {
+            ar << elem;
+        }
+        return;
+    }
+
+    //write the elements in place when they are already in wire format
+    if (sizeof(WireType) == sizeof(T) and detail::isLittleEndian())
+    {
+        BinaryObject bo(t.data(), t.size()*sizeof(T));
+        ar << bo;
+        return;
+    }
+
+    std::vector<WireType> wire(t.begin(), t.end());
+    if (not detail::isLittleEndian()) detail::swapBlockBytes(wire.data(), wire.size());
+    BinaryObject bo(wire.data(), wire.size()*sizeof(WireType));
+    ar << bo;
+}
+
+template<typename Archive, typename T, typename Allocator>
+typename std::enable_if<detail::isBlockElement<T>::value>::type
+load(Archive &ar, std::vector<T, Allocator> &t, const unsigned int ver)
+{
+    typedef typename detail::blockWire<T>::type WireType;
+    unsigned size(0);
+    ar >> size;
+    t.clear();
+
+    //archives before version 3 serialize each element
+    if (ver < 3)
+    {
+        t.reserve(size);
+        for (size_t i = 0; i < size_t(size); i++)
+        {
+            T elem;
+            ar >> elem;
+            t.push_back(elem);
+        }
+        return;
+    }
+
+    //read the elements in place when they are the same size
+    if (sizeof(WireType) == sizeof(T))
+    {
+        t.resize(size);
+        BinaryObject bo(t.data(), t.size()*sizeof(T));
+        ar >> bo;
+        if (not detail::isLittleEndian()) detail::swapBlockBytes(t.data(), t.size());
+        return;
+    }
+
+    std::vector<WireType> wire(size);
+    BinaryObject bo(wire.data(), wire.size()*sizeof(WireType));
+    ar >> bo;
+    if (not detail::isLittleEndian()) detail::swapBlockBytes(wire.data(), wire.size());
+    t.assign(wire.begin(), wire.end());
+}
+
 //------------ a vector of any type --------------//
 template<typename Archive, typename T, typename Allocator>
-void save(Archive &ar, const std::vector<T, Allocator> &t, const unsigned int)
+typename std::enable_if<not detail::isBlockElement<T>::value>::type
+save(Archive &ar, const std::vector<T, Allocator> &t, const unsigned int)
 {
     ar << unsigned(t.size());
     for (const auto &elem : t)
@@ -55,7 +201,8 @@ void save(Archive &ar, const std::vector<T, Allocator> &t, const unsigned int)
 }
 
 template<typename Archive, typename T, typename Allocator>
-void load(Archive &ar, std::vector<T, Allocator> &t, const unsigned int)
+typename std::enable_if<not detail::isBlockElement<T>::value>::type
+load(Archive &ar, std::vector<T, Allocator> &t, const unsigned int)
 {
     unsigned size(0);
     ar >> size;
@@ -17,10 +17,15 @@
 #include <functional> //std::function
 #include <type_traits> //std::type_info, std::is_void
 #include <utility> //std::forward
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace Pothos {
 namespace Detail {
 
+struct CallPlan;
+
 struct POTHOS_API CallableContainer
 {
     CallableContainer(void);
@@ -28,6 +33,13 @@ struct POTHOS_API CallableContainer
     virtual size_t getNumArgs(void) const = 0;
     virtual const std::type_info &type(const int argNo) = 0;
     virtual Object call(const Object *args) = 0;
+
+    //! Argument conversion plans cached by Callable::opaqueCall()
+    std::atomic<CallPlan *> plans;
+
+    //! Serializes publishing, and holds replaced plan lists until unused
+    std::mutex plansMutex;
+    std::vector<CallPlan *> retiredPlans;
 };
 
 } //namespace Detail
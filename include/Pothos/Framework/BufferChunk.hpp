@@ -200,6 +200,24 @@ public:
      */
     void append(const BufferChunk &other);
 
+    /*!
+     * A conversion function resolved by getConverter().
+     * The number of elements is counted in primitive input elements:
+     * the number of input elements multiplied by the input dimension.
+     */
+    typedef void (*ConvertFcn)(const void *in, void *out, const size_t numElems);
+
+    /*!
+     * Get the function that convert() uses between two data types.
+     * Resolve the converter once, for example in activate(),
+     * then call it on each buffer without the lookup overhead.
+     * \throws BufferConvertError when the conversion is not possible
+     * \param inDType the data type of the input buffer
+     * \param outDType the data type of the output buffer
+     * \return the conversion function
+     */
+    static ConvertFcn getConverter(const DType &inDType, const DType &outDType);
+
     /*!
      * Convert a buffer chunk to the specified data type.
      * When the number of elements are 0, the entire buffer is converted.
@@ -243,6 +261,70 @@ public:
      */
     size_t convertComplex(const BufferChunk &outBuffRe, const BufferChunk &outBuffIm, const size_t numElems = 0) const;
 
+    /*!
+     * Merge this buffer of real components and a buffer of imaginary
+     * components into a buffer of complex elements (inverse of convertComplex).
+     * When the number of elements are 0, the entire buffer is converted.
+     * \throws BufferConvertError when the conversion is not possible
+     * \param imBuff the imaginary components with the same dtype as this buffer
+     * \param dtype the complex data type of the result buffer
+     * \param numElems the number of elements to convert
+     * \return a new buffer chunk with complex elements
+     */
+    BufferChunk mergeComplex(const BufferChunk &imBuff, const DType &dtype, const size_t numElems = 0) const;
+
+    /*!
+     * Merge this buffer of real components and a buffer of imaginary
+     * components into the specified output buffer of complex elements.
+     * When the number of elements are 0, the entire buffer is converted.
+     * The buffer length should be large enough to contain the entire conversion.
+     * \throws BufferConvertError when the conversion is not possible
+     * \param imBuff the imaginary components with the same dtype as this buffer
+     * \param [out] outBuff the complex output buffer, also specifies the dtype
+     * \param numElems the number of elements to convert
+     * \return the number of output elements written to the buffer
+     */
+    size_t mergeComplex(const BufferChunk &imBuff, const BufferChunk &outBuff, const size_t numElems = 0) const;
+
+    //! Flags for the scaled conversions, combine with bitwise or
+    enum : int
+    {
+        CONVERT_TRUNCATE = 0, //!< round towards zero, out of range integers are undefined
+        CONVERT_ROUND = 1 << 0, //!< round integer outputs to the nearest (ties to even)
+        CONVERT_SATURATE = 1 << 1, //!< clamp integer outputs to the range of the type, NaN becomes zero
+    };
+
+    /*!
+     * Convert a buffer chunk to the specified data type with out = in*scale + offset.
+     * The scale, offset, rounding, and saturation are applied in a single pass.
+     * Complex elements apply the scale and offset to each component.
+     * Supported types are int8, int16, int32, float, double, and their complex forms.
+     * Example: int16 Q15 to float uses a scale of 1.0/(1 << 15).
+     * When the number of elements are 0, the entire buffer is converted.
+     * \throws BufferConvertError when the conversion is not possible
+     * \param dtype the data type of the result buffer
+     * \param scale the multiplier applied to each input
+     * \param offset the value added after the scale
+     * \param flags the rounding and saturation flags for integer outputs
+     * \param numElems the number of elements to convert
+     * \return a new buffer chunk with converted elements
+     */
+    BufferChunk convert(const DType &dtype, const double scale, const double offset, const int flags, const size_t numElems = 0) const;
+
+    /*!
+     * Convert a buffer chunk into the specified output buffer with out = in*scale + offset.
+     * When the number of elements are 0, the entire buffer is converted.
+     * The buffer length should be large enough to contain the entire conversion.
+     * \throws BufferConvertError when the conversion is not possible
+     * \param [out] outBuff the output buffer, also specifies the dtype
+     * \param scale the multiplier applied to each input
+     * \param offset the value added after the scale
+     * \param flags the rounding and saturation flags for integer outputs
+     * \param numElems the number of elements to convert
+     * \return the number of output elements written to the buffer
+     */
+    size_t convert(const BufferChunk &outBuff, const double scale, const double offset, const int flags, const size_t numElems = 0) const;
+
 private:
     friend BufferAccumulator;
     ManagedBuffer _managedBuffer;
@@ -42,11 +42,28 @@ struct POTHOS_API BufferManagerArgs
     size_t bufferSize;
 
     /*!
-     * The NUMA node affinity for the generic slab allocator.
+     * The NUMA node affinity for the generic and circular allocators.
      * This argument is not used for the special-case managers.
      * Default: -1 or unspecified affinity
      */
     long nodeAffinity;
+
+    /*!
+     * Back the circular allocator with huge pages (2 MiB) when possible.
+     * Huge pages reduce TLB pressure for large circular buffers.
+     * The allocator falls back to regular pages when unavailable.
+     * Default: false
+     */
+    bool hugePages;
+
+    /*!
+     * The file backing the memory mapped managers.
+     * The mmap_reader manager serves the file contents in order,
+     * and the mmap_writer manager records into a growing file.
+     * The read-ahead window is numBuffers times bufferSize.
+     * Default: empty, not used by the other managers
+     */
+    std::string filePath;
 };
 
 /*!
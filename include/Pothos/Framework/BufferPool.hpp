@@ -17,9 +17,14 @@ namespace Pothos {
 
 /*!
  * The simple buffer pool holds a collection of re-usable buffers.
+ * Buffers are kept in power of two size classes (8 KiB and up).
  * When the client requests a particular buffer size from the pool,
  * the pool first looks for an existing and unused buffer
- * that matches the requested size, or allocates a new buffer.
+ * in the smallest class that fits the requested size,
+ * then in the larger classes, or allocates a new buffer.
+ * The unused buffers of a size class are freed once the class
+ * goes unused for a number of requests, so that the pool only
+ * holds on to the sizes that the client currently requests.
  */
 class POTHOS_API BufferPool
 {
@@ -36,13 +41,15 @@ public:
     /*!
      * Get a buffer from the pool or make one if none available.
      * \param numBytes the size of the requested buffer in bytes
-     * \return an available buffer chunk of at least numBytes size
+     * \return an available buffer chunk with a length of numBytes,
+     * the underlying buffer may be larger than the requested size
      */
     const Pothos::BufferChunk &get(const size_t numBytes);
 
 private:
-    size_t _minBuffSize;
-    std::vector<Pothos::BufferChunk> _buffs;
+    std::vector<std::vector<Pothos::BufferChunk>> _classes;
+    std::vector<unsigned long long> _lastUsed; //!< request number per size class
+    unsigned long long _numRequests;
 };
 
 } //namespace Pothos
@@ -18,11 +18,14 @@
 #include <Pothos/Util/RingDeque.hpp>
 #include <Pothos/Util/SpinLock.hpp>
 #include <string>
+#include <memory>
 
 namespace Pothos {
 
 class WorkerActor;
 class OutputPort;
+class InputPortInbox;
+class InputPortBatch;
 
 /*!
  * InputPort provides methods to interact with a worker's input ports.
@@ -237,10 +240,11 @@ private:
     Util::RingDeque<std::pair<Object, BufferChunk>> _slotCalls;
 
     std::vector<Label> _inlineMessages; //user api structure
-    Util::RingDeque<Label> _inputInlineMessages; //shared structure
+    Util::RingDeque<Label> _inputInlineMessages; //worker owned structure
+    BufferAccumulator _bufferAccumulator; //worker owned structure
 
-    Util::SpinLock _bufferAccumulatorLock;
-    BufferAccumulator _bufferAccumulator;
+    //delivers buffers and labels from producers to the worker
+    std::unique_ptr<InputPortInbox> _inbox;
 
     std::vector<OutputPort *> _subscribers;
 
@@ -262,6 +266,7 @@ private:
     void inlineMessagesClear(void);
 
     /////// input buffer interface /////////
+    void inboxDrain(void);
     void bufferAccumulatorFront(BufferChunk &);
     void bufferAccumulatorPush(const BufferChunk &buffer);
     void bufferAccumulatorPushNoLock(BufferChunk &&buffer);
@@ -274,6 +279,7 @@ private:
         const bool enableMove,
         std::vector<Label> &postedLabels,
         Util::RingDeque<BufferChunk> &postedBuffers);
+    void bufferBatchPush(const std::shared_ptr<InputPortBatch> &batch);
 
     InputPort(void);
     InputPort(const InputPort &) = delete; // non construction-copyable
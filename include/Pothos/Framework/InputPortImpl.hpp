@@ -144,47 +144,3 @@ inline Pothos::Object Pothos::InputPort::asyncMessagesPeek(void)
     if (_asyncMessages.empty()) return Pothos::Object();
     return _asyncMessages.front().first;
 }
-
-inline void Pothos::InputPort::inlineMessagesPush(const Pothos::Label &label)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
-    _inputInlineMessages.push_back(label);
-}
-
-inline void Pothos::InputPort::inlineMessagesClear(void)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    _inputInlineMessages.clear();
-    _inlineMessages.clear();
-}
-
-inline void Pothos::InputPort::bufferAccumulatorFront(Pothos::BufferChunk &buff)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    while (not _inputInlineMessages.empty())
-    {
-        _inlineMessages.push_back(std::move(_inputInlineMessages.front()));
-        _inlineMessages.back().adjust(1, this->dtype().size());
-        _inputInlineMessages.pop_front();
-    }
-    buff = _bufferAccumulator.front();
-}
-
-inline void Pothos::InputPort::bufferAccumulatorPush(const BufferChunk &buffer)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    this->bufferAccumulatorPushNoLock(BufferChunk(buffer));
-}
-
-inline void Pothos::InputPort::bufferAccumulatorRequire(const size_t numBytes)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    _bufferAccumulator.require(numBytes);
-}
-
-inline void Pothos::InputPort::bufferAccumulatorClear(void)
-{
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    _bufferAccumulator = BufferAccumulator();
-}
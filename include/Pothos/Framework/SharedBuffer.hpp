@@ -51,11 +51,16 @@ public:
      * When the SharedBuffer is deleted, the memory will be freed as well.
      * The node affinity is used to allocate physical memory on a NUMA node.
      *
+     * When huge pages are requested, the length is rounded up to a multiple
+     * of the huge page size (2 MiB). The allocation falls back to regular
+     * pages when huge pages are not supported or none are available.
+     *
      * \param numBytes the number of bytes to allocate in this buffer
      * \param nodeAffinity which NUMA node to allocate on (-1 for don't care)
+     * \param hugePages true to back the buffer with huge pages when possible
      * \return a new circular shared buffer object
      */
-    static SharedBuffer makeCirc(const size_t numBytes, const long nodeAffinity = -1);
+    static SharedBuffer makeCirc(const size_t numBytes, const long nodeAffinity = -1, const bool hugePages = false);
 
     /*!
      * Create a SharedBuffer backed by a memory-mapped file.
@@ -137,7 +142,7 @@ public:
     const std::shared_ptr<void> &getContainer(void) const;
 
 private:
-    static SharedBuffer makeCircUnprotected(const size_t numBytes, const long nodeAffinity);
+    static SharedBuffer makeCircUnprotected(const size_t numBytes, const long nodeAffinity, const bool hugePages);
     size_t _address;
     size_t _length;
     size_t _alias;
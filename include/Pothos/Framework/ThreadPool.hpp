@@ -42,7 +42,11 @@ public:
      *     "priority" : 0.5,
      *     "affinityMode" : "CPU",
      *     "affinity" : [0, 2, 4, 6],
-     *     "yieldMode" : "SPIN"
+     *     "yieldMode" : "SPIN",
+     *     "burstIterations" : 16,
+     *     "burstTime" : 0.0001,
+     *     "adaptiveBuffers" : true,
+     *     "circularFanout" : true
      * }
      * \endcode
      * \param json a JSON object markup string
@@ -74,6 +78,10 @@ public:
      *  - "ALL" - affinitize to all available CPUs
      *  - "CPU" - affinity list specifies CPUs
      *  - "NUMA" - affinity list specifies NUMA nodes
+     *  - "AUTO" - automatic placement when set on a Topology's thread pool:
+     *    the topology partitions its blocks into NUMA-local groups
+     *    and creates one thread pool per NUMA node with these args.
+     *    Otherwise this mode behaves like "ALL".
      *
      * The default is "ALL".
      */
@@ -88,10 +96,60 @@ public:
      *  - "CONDITION" - Threads wait on condition variables when no work is available.
      *  - "HYBRID" - Threads spin for a while, then yield to other threads, when no work is available.
      *  - "SPIN" - Threads busy-wait, without yielding, when no work is available.
+     *  - "STEAL" - Threads only visit blocks that have been flagged with a change.
+     *    Runnable blocks are placed onto per-thread ready queues,
+     *    and idle threads steal work from the queues of other threads.
+     *    Threads wait on a condition variable when no block is runnable.
+     *    This mode only applies to pool-mode (positive numThreads).
      *
      * The default is "CONDITION".
      */
     std::string yieldMode;
+
+    /*!
+     * The maximum number of work() calls per block acquisition.
+     * Once a thread has acquired a block, it keeps calling work()
+     * while the block remains backlogged: that is, while each call
+     * consumed or produced and the block was flagged with a change.
+     * The burst ends when the input drops below the reserve,
+     * the output buffers run out, an external call is pending,
+     * or the iteration or time budget expires.
+     *
+     * The default is 1 (one work() call per acquisition).
+     */
+    size_t burstIterations;
+
+    /*!
+     * The time budget in seconds for a burst of work() calls.
+     * The value 0.0 means that only burstIterations limits the burst.
+     *
+     * The default is 0.0 (no time limit).
+     */
+    double burstTime;
+
+    /*!
+     * Adapt the size of the default output buffers at runtime.
+     * Blocks in this pool measure the production on each output port
+     * that uses a framework-provided buffer manager (not custom managers).
+     * Buffers grow on ports where work() fills the buffer at a high rate,
+     * and shrink on ports that only produce a small part of each buffer.
+     * The selected sizes are reported in the topology's JSON stats.
+     *
+     * The default is false (fixed default buffer sizes).
+     */
+    bool adaptiveBuffers;
+
+    /*!
+     * Use circular buffers for the default managers of fan-out outputs.
+     * Output ports with multiple subscribers and no custom manager
+     * use a double-mapped "circular" buffer manager, so that subscribers
+     * do not copy in require() when the data wraps around the pool.
+     * When the circular manager is unavailable, a warning is logged
+     * and the output port uses the generic buffer manager.
+     *
+     * The default is false (generic buffers on every output).
+     */
+    bool circularFanout;
 };
 
 /*!
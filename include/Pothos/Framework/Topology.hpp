@@ -160,6 +160,19 @@ public:
     //! Get the thread pool used by all blocks in this topology.
     const ThreadPool &getThreadPool(void) const;
 
+    /*!
+     * Set the ring capacity of shared memory flows.
+     * The topology connects processes on the same host with shared memory
+     * blocks, and each connection buffers up to this many bytes in its ring.
+     * The capacity applies to connections created by the next commit().
+     * Default: 8 MiB
+     * \param numBytes the ring capacity in bytes
+     */
+    void setSharedMemoryCapacity(const size_t numBytes);
+
+    //! Get the ring capacity of shared memory flows.
+    size_t getSharedMemoryCapacity(void) const;
+
     /*!
      * Set the displayable alias for the specified input port.
      */
@@ -282,6 +295,16 @@ public:
      * }
      * \endcode
      *
+     * When the POTHOS_WORK_PROFILER environment variable is set
+     * at block creation time, each block's stats also contain
+     * a "workProfiler" object with log-bucketed histograms for
+     * workDuration, schedulingDelay (both in clock ticks),
+     * elementsConsumed, and elementsProduced per work() call.
+     *
+     * When the thread pool enables adaptiveBuffers, output port stats
+     * contain an "adaptiveBuffers" object with the selected
+     * numBuffers, bufferSize, and the number of resizes.
+     *
      * \return a JSON formatted object string
      */
     std::string queryJSONStats(void);
@@ -20,6 +20,15 @@
 namespace Pothos {
 namespace Detail {
 
+/***********************************************************************
+ * Small container allocation: containers of small values come from
+ * per-thread free lists instead of the heap. Copies of an Object still
+ * share the one container, only the allocation is cheaper.
+ **********************************************************************/
+POTHOS_API void *allocObjectContainer(const size_t size);
+
+POTHOS_API void freeObjectContainer(void *p, const size_t size);
+
 /***********************************************************************
  * ObjectContainer interface
  **********************************************************************/
@@ -55,6 +64,16 @@ struct POTHOS_TEMPLATE_API ObjectContainerT : ObjectContainer
         return;
     }
 
+    static void *operator new(const size_t size)
+    {
+        return allocObjectContainer(size);
+    }
+
+    static void operator delete(void *p, const size_t size)
+    {
+        freeObjectContainer(p, size);
+    }
+
     ValueType value;
 };
 
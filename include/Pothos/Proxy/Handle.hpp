@@ -4,7 +4,7 @@
 /// Definitions for the ProxyHandle interface class.
 ///
 /// \copyright
-/// Copyright (c) 2013-2014 Josh Blum
+/// Copyright (c) 2013-2017 Josh Blum
 /// SPDX-License-Identifier: BSL-1.0
 ///
 
@@ -14,6 +14,7 @@
 #include <typeinfo>
 #include <string>
 #include <memory>
+#include <future>
 
 namespace Pothos {
 
@@ -55,6 +56,20 @@ public:
      */
     virtual Proxy call(const std::string &name, const Proxy *args, const size_t numArgs) = 0;
 
+    /*!
+     * Make a call on this handle without waiting for the result.
+     * Handles that support pipelining send the request immediately
+     * and wait for the reply when the future is accessed,
+     * so that many calls can be in flight from a single thread.
+     * The default implementation makes the call synchronously.
+     *
+     * \param name the name of the method
+     * \param args an array of Proxy object arguments
+     * \param numArgs the number of arguments in the array
+     * \return a future for the Proxy result of the call
+     */
+    virtual std::future<Proxy> callAsync(const std::string &name, const Proxy *args, const size_t numArgs);
+
     /*!
      * Returns a negative integer, zero, or a positive integer as this object is
      * less than, equal to, or greater than the specified object.
@@ -14,6 +14,7 @@
 #include <Pothos/Object/Object.hpp>
 #include <memory>
 #include <string>
+#include <future>
 
 namespace Pothos {
 
@@ -87,6 +88,15 @@ public:
     template <typename... ArgsType>
     Proxy call(const std::string &name, ArgsType&&... args) const;
 
+    /*!
+     * Call a method without waiting for the result.
+     * Remote environments pipeline the request on the connection,
+     * and the future blocks on the reply when it is accessed.
+     * Every future should be accessed to retrieve the reply.
+     */
+    template <typename... ArgsType>
+    std::future<Proxy> callAsync(const std::string &name, ArgsType&&... args) const;
+
     /*!
      * Call a method with a Proxy return and variable args
      * \deprecated use call overload without return type
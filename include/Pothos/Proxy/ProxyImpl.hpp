@@ -93,6 +93,15 @@ Proxy Proxy::call(const std::string &name, ArgsType&&... args) const
     return handle->call(name, proxyArgs.data(), sizeof...(args));
 }
 
+template <typename... ArgsType>
+std::future<Proxy> Proxy::callAsync(const std::string &name, ArgsType&&... args) const
+{
+    const std::array<Proxy, sizeof...(ArgsType)> proxyArgs{{Detail::makeProxy(this->getEnvironment(), std::forward<ArgsType>(args))...}};
+    auto handle = this->getHandle();
+    assert(handle);
+    return handle->callAsync(name, proxyArgs.data(), sizeof...(args));
+}
+
 template <typename... ArgsType>
 Proxy Proxy::callProxy(const std::string &name, ArgsType&&... args) const
 {
@@ -52,6 +52,9 @@ public:
 
     /*!
      * Create a proxy environment that is interfaced through this remote client object.
+     * The args are passed to the environment on the server, except for these options:
+     * "wireFormat" set to "stream" disables the chunked wire format,
+     * and "batch" set to "false" disables batched requests.
      */
     ProxyEnvironment::Sptr makeEnvironment(const std::string &name, const ProxyEnvironmentArgs &args = ProxyEnvironmentArgs());
 
@@ -48,6 +48,7 @@ public:
 
 private:
     const std::string _peerAddr;
+    unsigned int _archiveVersion; //!< the archive version negotiated with the client
 };
 
 } //namespace Pothos
@@ -51,6 +51,17 @@ public:
      */
     static std::string getLocatorPort(void);
 
+    /*!
+     * Get the local socket path for a server running on this host.
+     * The server listens on this path in addition to its TCP port,
+     * and clients connecting to a loopback address use it instead.
+     * The path is in a per-user directory that is created with mode 0700.
+     * \param port the TCP port that the server is running on
+     * \return the socket path or empty when local sockets are unsupported
+     * or when the per-user directory is not owned by and private to the user
+     */
+    static std::string getLocalSocketPath(const std::string &port);
+
     //! Get the actual port that the server is running on
     std::string getActualPort(void) const;
 
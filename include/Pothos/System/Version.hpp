@@ -36,7 +36,7 @@
  * and <i>bump</i> signifies a change to the ABI during library development.
  * The ABI should remain constant across patch releases of the library.
  */
-#define POTHOS_ABI_VERSION "0.7-4"
+#define POTHOS_ABI_VERSION "0.8-14"
 
 namespace Pothos {
 namespace System {
@@ -3,13 +3,21 @@
 
 #include <Pothos/Archive/StreamArchiver.hpp>
 #include <Pothos/Archive/Numbers.hpp>
+#include <Pothos/Archive/Exception.hpp>
 #include <iostream>
-
-#define POTHOS_ARCHIVE_VERSION 2
+#include <string>
 
 Pothos::Archive::OStreamArchiver::OStreamArchiver(std::ostream &os):
-    os(os), ver(POTHOS_ARCHIVE_VERSION)
+    os(os), ver(POTHOS_ARCHIVE_VERSION_COMPAT)
+{
+    *this << ver;
+}
+
+Pothos::Archive::OStreamArchiver::OStreamArchiver(std::ostream &os, const unsigned int version):
+    os(os), ver(version)
 {
+    if (ver > POTHOS_ARCHIVE_VERSION) throw Pothos::ArchiveException(
+        "OStreamArchiver()", "unsupported version "+std::to_string(ver));
     *this << ver;
 }
 
@@ -23,6 +31,8 @@ Pothos::Archive::IStreamArchiver::IStreamArchiver(std::istream &is):
     is(is), ver(0)
 {
     *this >> ver;
+    if (ver > POTHOS_ARCHIVE_VERSION) throw Pothos::ArchiveException(
+        "IStreamArchiver()", "unsupported version "+std::to_string(ver));
 }
 
 void Pothos::Archive::IStreamArchiver::readBytes(void *buff, const size_t len)
@@ -186,3 +186,147 @@ POTHOS_TEST_BLOCK("/archive/tests", test_vector)
 
     POTHOS_TEST_EQUALV(x, y);
 }
+
+template <typename T>
+static void testNumericVector(const std::vector<T> &x)
+{
+    for (const unsigned version : {POTHOS_ARCHIVE_VERSION_COMPAT, POTHOS_ARCHIVE_VERSION})
+    {
+        std::stringstream so;
+        Pothos::Archive::OStreamArchiver ao(so, version);
+        ao << x;
+
+        std::stringstream si(so.str());
+        Pothos::Archive::IStreamArchiver ai(si);
+        std::vector<T> y; ai >> y;
+
+        POTHOS_TEST_EQUALV(x, y);
+    }
+}
+
+POTHOS_TEST_BLOCK("/archive/tests", test_numeric_vectors)
+{
+    std::vector<signed char> v8;
+    std::vector<short> v16;
+    std::vector<int> v32;
+    std::vector<long> vlong;
+    std::vector<unsigned long long> v64;
+    std::vector<float> vf32;
+    std::vector<double> vf64;
+    std::vector<std::complex<float>> vcf32;
+    std::vector<std::complex<short>> vcs16;
+    for (int i = 0; i < numIters; i++)
+    {
+        v8.push_back(static_cast<signed char>(std::rand()));
+        v16.push_back(static_cast<short>(std::rand()));
+        v32.push_back(std::rand() - RAND_MAX/2);
+        vlong.push_back(-std::rand());
+        v64.push_back((static_cast<unsigned long long>(std::rand()) << 32) | std::rand());
+        vf32.push_back(float(std::rand())/3);
+        vf64.push_back(double(std::rand())/3);
+        vcf32.emplace_back(float(std::rand())/3, -float(std::rand())/3);
+        vcs16.emplace_back(static_cast<short>(std::rand()), static_cast<short>(std::rand()));
+    }
+    testNumericVector(v8);
+    testNumericVector(v16);
+    testNumericVector(v32);
+    testNumericVector(vlong);
+    testNumericVector(v64);
+    testNumericVector(vf32);
+    testNumericVector(vf64);
+    testNumericVector(vcf32);
+    testNumericVector(vcs16);
+    testNumericVector(std::vector<float>());
+}
+
+POTHOS_TEST_BLOCK("/archive/tests", test_numeric_vectors_version2)
+{
+    //version 2 archives have each element serialized individually
+    std::vector<int> x;
+    std::vector<std::complex<float>> xc;
+    for (int i = 0; i < numIters; i++)
+    {
+        x.push_back(std::rand() - RAND_MAX/2);
+        xc.emplace_back(float(std::rand())/3, -float(std::rand())/3);
+    }
+    std::stringstream so;
+    Pothos::Archive::OStreamArchiver ao(so);
+    ao << unsigned(x.size());
+    for (const auto &elem : x) ao << elem;
+    ao << unsigned(xc.size());
+    for (const auto &elem : xc) ao << elem;
+
+    //replace the version number which is one byte
+    auto archive = so.str();
+    archive[0] = char(2);
+
+    std::stringstream si(archive);
+    Pothos::Archive::IStreamArchiver ai(si);
+    std::vector<int> y; ai >> y;
+    std::vector<std::complex<float>> yc; ai >> yc;
+
+    POTHOS_TEST_EQUALV(x, y);
+    POTHOS_TEST_EQUALV(xc, yc);
+}
+
+//! The vector reader of releases before version 3, which ignored the version
+template <typename T>
+static std::vector<T> loadVersion2Reader(const std::string &archive)
+{
+    std::stringstream si(archive);
+    Pothos::Archive::IStreamArchiver ai(si);
+    unsigned size(0); ai >> size;
+    std::vector<T> y;
+    for (size_t i = 0; i < size_t(size) and si; i++)
+    {
+        T elem; ai >> elem;
+        y.push_back(elem);
+    }
+    return y;
+}
+
+POTHOS_TEST_BLOCK("/archive/tests", test_numeric_vectors_interop)
+{
+    std::vector<int> x;
+    for (int i = 0; i < numIters; i++) x.push_back(std::rand() - RAND_MAX/2);
+
+    //the default archive is decoded by the version 2 reader
+    std::stringstream soCompat;
+    {
+        Pothos::Archive::OStreamArchiver ao(soCompat);
+        ao << x;
+    }
+    POTHOS_TEST_EQUAL(int(soCompat.str().at(0)), POTHOS_ARCHIVE_VERSION_COMPAT);
+    POTHOS_TEST_EQUALV(loadVersion2Reader<int>(soCompat.str()), x);
+
+    //the version 3 block is misread by the version 2 reader,
+    //which is why it is only written to a reader that supports it
+    std::stringstream soBlock;
+    {
+        Pothos::Archive::OStreamArchiver ao(soBlock, POTHOS_ARCHIVE_VERSION);
+        ao << x;
+    }
+    POTHOS_TEST_EQUAL(int(soBlock.str().at(0)), POTHOS_ARCHIVE_VERSION);
+    bool misread = true;
+    try
+    {
+        misread = loadVersion2Reader<int>(soBlock.str()) != x;
+    }
+    catch (const Pothos::ArchiveException &){}
+    POTHOS_TEST_TRUE(misread);
+
+    //and the current reader decodes both versions
+    for (const auto &archive : {soCompat.str(), soBlock.str()})
+    {
+        std::stringstream si(archive);
+        Pothos::Archive::IStreamArchiver ai(si);
+        std::vector<int> y; ai >> y;
+        POTHOS_TEST_EQUALV(x, y);
+    }
+
+    //versions from the future are rejected rather than misread
+    auto future = soBlock.str();
+    future[0] = char(POTHOS_ARCHIVE_VERSION+1);
+    std::stringstream si(future);
+    POTHOS_TEST_THROWS(Pothos::Archive::IStreamArchiver ai(si), Pothos::ArchiveException);
+}
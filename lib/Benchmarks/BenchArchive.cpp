@@ -0,0 +1,66 @@
+// Copyright (c) 2016-2018 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Benchmarks/Benchmark.hpp"
+#include <Pothos/Archive.hpp>
+#include <complex>
+#include <sstream>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const double MB = 1e6;
+
+/***********************************************************************
+ * Vector serialization as a block versus each element
+ **********************************************************************/
+template <typename T>
+static json benchVectorArchive(const double seconds)
+{
+    json results;
+    const std::vector<T> x(1024*1024);
+    const auto numBytes = x.size()*sizeof(T);
+
+    std::stringstream blockStream;
+    results["block_save_MBps"] = measureRate([&]
+    {
+        blockStream.str("");
+        Pothos::Archive::OStreamArchiver ao(blockStream, POTHOS_ARCHIVE_VERSION);
+        ao << x;
+        return numBytes;
+    }, seconds)/MB;
+    results["block_load_MBps"] = measureRate([&]
+    {
+        std::stringstream is(blockStream.str());
+        Pothos::Archive::IStreamArchiver ai(is);
+        std::vector<T> y; ai >> y;
+        return numBytes;
+    }, seconds)/MB;
+
+    //the element by element format of version 2 archives
+    std::stringstream elemStream;
+    results["element_save_MBps"] = measureRate([&]
+    {
+        elemStream.str("");
+        Pothos::Archive::OStreamArchiver ao(elemStream, POTHOS_ARCHIVE_VERSION_COMPAT);
+        ao << x;
+        return numBytes;
+    }, seconds)/MB;
+    results["element_load_MBps"] = measureRate([&]
+    {
+        std::stringstream is(elemStream.str());
+        Pothos::Archive::IStreamArchiver ai(is);
+        std::vector<T> y; ai >> y;
+        return numBytes;
+    }, seconds)/MB;
+    return results;
+}
+
+POTHOS_BENCHMARK("/archive", bench_vector_archive)
+{
+    json results;
+    results["float32"] = benchVectorArchive<float>(seconds);
+    results["int32"] = benchVectorArchive<int>(seconds);
+    results["complex_float32"] = benchVectorArchive<std::complex<float>>(seconds);
+    return results;
+}
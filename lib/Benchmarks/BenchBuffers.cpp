@@ -0,0 +1,369 @@
+// Copyright (c) 2014-2017 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Benchmarks/Benchmark.hpp"
+#include <Pothos/Framework/BufferAccumulator.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Framework/BufferPool.hpp>
+#include <Poco/TemporaryFile.h>
+#include <algorithm>
+#include <complex>
+#include <cstring> //memset
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const double GB = 1e9;
+
+/***********************************************************************
+ * Buffer accumulator require with fragment patterns
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/buffers", bench_buffer_accumulator)
+{
+    json results;
+    for (const size_t fragSize : {size_t(1000), size_t(4096), size_t(700*1024)})
+    {
+        //fragments in separate buffers are copied together by require()
+        std::vector<Pothos::BufferChunk> separate;
+        for (size_t i = 0; i < 4; i++) separate.emplace_back(fragSize);
+
+        //adjacent fragments of one buffer are merged without copies
+        std::vector<Pothos::BufferChunk> adjacent;
+        Pothos::BufferChunk whole(4*fragSize);
+        for (size_t i = 0; i < 4; i++)
+        {
+            adjacent.push_back(whole);
+            adjacent.back().address += i*fragSize;
+            adjacent.back().length = fragSize;
+        }
+
+        for (const auto *fragments : {&separate, &adjacent})
+        {
+            Pothos::BufferAccumulator accumulator;
+            const auto bytesPerSec = measureRate([&]
+            {
+                for (auto fragment : *fragments) accumulator.push(std::move(fragment));
+                accumulator.require(3*fragSize+1);
+                accumulator.pop(3*fragSize+1);
+                accumulator.pop(accumulator.getTotalBytesAvailable());
+                return 4*fragSize;
+            }, seconds);
+            const auto key = ((fragments == &separate)?"separate_":"adjacent_")+std::to_string(fragSize)+"_GBps";
+            results[key] = bytesPerSec/GB;
+        }
+    }
+
+    Pothos::BufferPool pool;
+    results["pool_gets_per_sec"] = measureRate([&]
+    {
+        const auto buff0 = pool.get(1000);
+        const auto buff1 = pool.get(20000);
+        return 2;
+    }, seconds);
+    return results;
+}
+
+/***********************************************************************
+ * Buffer conversions between common data types
+ **********************************************************************/
+static const size_t numConvertElems = 64*1024;
+
+//! The rate of a conversion in input bytes per second
+static double convertGBps(const std::string &inDType, const std::string &outDType, const double seconds)
+{
+    const Pothos::BufferChunk in(inDType, numConvertElems);
+    const Pothos::BufferChunk out(outDType, numConvertElems);
+    std::memset(in.as<void *>(), 0, in.length);
+    return measureRate([&]{in.convert(out); return in.length;}, seconds)/GB;
+}
+
+//! Scalar element conversions, the reference for the dispatched kernels
+template <typename OutType, typename InType>
+static OutType scalarConvert(const InType &in, OutType *)
+{
+    return OutType(in);
+}
+
+template <typename OutType, typename InType>
+static std::complex<OutType> scalarConvert(const InType &in, std::complex<OutType> *)
+{
+    return std::complex<OutType>(OutType(in), OutType(0));
+}
+
+template <typename OutType, typename InType>
+static std::complex<OutType> scalarConvert(const std::complex<InType> &in, std::complex<OutType> *)
+{
+    return std::complex<OutType>(OutType(in.real()), OutType(in.imag()));
+}
+
+//! The rate of a scalar reference loop in input bytes per second
+template <typename InType, typename OutType>
+static double scalarConvertGBps(const double seconds)
+{
+    const std::vector<InType> in(numConvertElems);
+    std::vector<OutType> out(numConvertElems);
+    return measureRate([&]
+    {
+        for (size_t i = 0; i < numConvertElems; i++) out[i] = scalarConvert(in[i], (OutType *)nullptr);
+        return numConvertElems*sizeof(InType);
+    }, seconds)/GB;
+}
+
+//! Complex to separate planes with a scalar reference loop
+template <typename InType, typename OutType>
+static double scalarComponentsGBps(const double seconds)
+{
+    const std::vector<std::complex<InType>> in(numConvertElems);
+    std::vector<OutType> re(numConvertElems), im(numConvertElems);
+    return measureRate([&]
+    {
+        for (size_t i = 0; i < numConvertElems; i++)
+        {
+            re[i] = OutType(in[i].real());
+            im[i] = OutType(in[i].imag());
+        }
+        return numConvertElems*sizeof(std::complex<InType>);
+    }, seconds)/GB;
+}
+
+//! Separate planes to complex with a scalar reference loop
+template <typename InType, typename OutType>
+static double scalarMergeGBps(const double seconds)
+{
+    const std::vector<InType> re(numConvertElems), im(numConvertElems);
+    std::vector<std::complex<OutType>> out(numConvertElems);
+    return measureRate([&]
+    {
+        for (size_t i = 0; i < numConvertElems; i++)
+        {
+            out[i] = std::complex<OutType>(OutType(re[i]), OutType(im[i]));
+        }
+        return numConvertElems*sizeof(std::complex<OutType>);
+    }, seconds)/GB;
+}
+
+//! The rate of complex to components in input bytes per second
+static double componentsGBps(const std::string &inDType, const std::string &outDType, const double seconds)
+{
+    const Pothos::BufferChunk complexBuff(inDType, numConvertElems);
+    const Pothos::BufferChunk reBuff(outDType, numConvertElems);
+    const Pothos::BufferChunk imBuff(outDType, numConvertElems);
+    std::memset(complexBuff.as<void *>(), 0, complexBuff.length);
+    return measureRate([&]
+    {
+        complexBuff.convertComplex(reBuff, imBuff);
+        return complexBuff.length;
+    }, seconds)/GB;
+}
+
+//! The rate of components to complex in output bytes per second
+static double mergeGBps(const std::string &inDType, const std::string &outDType, const double seconds)
+{
+    const Pothos::BufferChunk reBuff(inDType, numConvertElems);
+    const Pothos::BufferChunk imBuff(inDType, numConvertElems);
+    const Pothos::BufferChunk complexBuff(outDType, numConvertElems);
+    std::memset(reBuff.as<void *>(), 0, reBuff.length);
+    std::memset(imBuff.as<void *>(), 0, imBuff.length);
+    return measureRate([&]
+    {
+        reBuff.mergeComplex(imBuff, complexBuff);
+        return complexBuff.length;
+    }, seconds)/GB;
+}
+
+POTHOS_BENCHMARK("/framework/buffers", bench_convert)
+{
+    //the dispatched conversions and a scalar reference loop side by side
+    json results;
+    const auto addPair = [&](const std::string &key, const double simd, const double scalar)
+    {
+        results[key]["simd_GBps"] = simd;
+        results[key]["scalar_GBps"] = scalar;
+    };
+    addPair("int8_to_float32", convertGBps("int8", "float32", seconds), scalarConvertGBps<int8_t, float>(seconds));
+    addPair("int16_to_float32", convertGBps("int16", "float32", seconds), scalarConvertGBps<int16_t, float>(seconds));
+    addPair("float32_to_int16", convertGBps("float32", "int16", seconds), scalarConvertGBps<float, int16_t>(seconds));
+    addPair("int32_to_float64", convertGBps("int32", "float64", seconds), scalarConvertGBps<int32_t, double>(seconds));
+    addPair("float32_to_complex_float32", convertGBps("float32", "complex_float32", seconds),
+        scalarConvertGBps<float, std::complex<float>>(seconds));
+    addPair("int16_to_complex_float32", convertGBps("int16", "complex_float32", seconds),
+        scalarConvertGBps<int16_t, std::complex<float>>(seconds));
+    addPair("complex_int16_to_complex_float32", convertGBps("complex_int16", "complex_float32", seconds),
+        scalarConvertGBps<std::complex<int16_t>, std::complex<float>>(seconds));
+    addPair("complex_float32_to_complex_int16", convertGBps("complex_float32", "complex_int16", seconds),
+        scalarConvertGBps<std::complex<float>, std::complex<int16_t>>(seconds));
+
+    //complex to components and back again
+    addPair("complex_float32_to_float32_components", componentsGBps("complex_float32", "float32", seconds),
+        scalarComponentsGBps<float, float>(seconds));
+    addPair("complex_int16_to_float32_components", componentsGBps("complex_int16", "float32", seconds),
+        scalarComponentsGBps<int16_t, float>(seconds));
+    addPair("float32_components_to_complex_float32", mergeGBps("float32", "complex_float32", seconds),
+        scalarMergeGBps<float, float>(seconds));
+    addPair("float32_components_to_complex_int16", mergeGBps("float32", "complex_int16", seconds),
+        scalarMergeGBps<float, int16_t>(seconds));
+    return results;
+}
+
+/***********************************************************************
+ * Scaled Q15 conversions: fused versus a conversion and a scale pass
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/buffers", bench_convert_scaled)
+{
+    json results;
+    const Pothos::BufferChunk q15("int16", numConvertElems);
+    const Pothos::BufferChunk floats("float32", numConvertElems);
+    std::memset(q15.as<void *>(), 0, q15.length);
+    std::memset(floats.as<void *>(), 0, floats.length);
+    const auto f = floats.as<float *>();
+
+    results["int16_to_float32_fused_GBps"] = measureRate([&]
+    {
+        q15.convert(floats, 1.0/(1 << 15), 0.0, Pothos::BufferChunk::CONVERT_TRUNCATE);
+        return q15.length;
+    }, seconds)/GB;
+    results["int16_to_float32_two_pass_GBps"] = measureRate([&]
+    {
+        q15.convert(floats);
+        for (size_t i = 0; i < numConvertElems; i++) f[i] *= 1.0f/(1 << 15);
+        return q15.length;
+    }, seconds)/GB;
+
+    const Pothos::BufferChunk scaled("float32", numConvertElems);
+    const auto s = scaled.as<float *>();
+    results["float32_to_int16_fused_GBps"] = measureRate([&]
+    {
+        floats.convert(q15, (1 << 15), 0.0, Pothos::BufferChunk::CONVERT_ROUND | Pothos::BufferChunk::CONVERT_SATURATE);
+        return floats.length;
+    }, seconds)/GB;
+    results["float32_to_int16_two_pass_GBps"] = measureRate([&]
+    {
+        for (size_t i = 0; i < numConvertElems; i++) s[i] = std::min(std::max(f[i]*(1 << 15), -32768.0f), 32767.0f);
+        scaled.convert(q15);
+        return floats.length;
+    }, seconds)/GB;
+    return results;
+}
+
+/***********************************************************************
+ * Call overhead of small conversions: convert() versus getConverter()
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/buffers", bench_convert_small)
+{
+    json results;
+    const auto converter = Pothos::BufferChunk::getConverter("int16", "float32");
+    for (const size_t numElems : {16, 64, 256})
+    {
+        const Pothos::BufferChunk in("int16", numElems);
+        const Pothos::BufferChunk out("float32", numElems);
+        std::memset(in.as<void *>(), 0, in.length);
+        const auto key = std::to_string(numElems)+"_elements";
+        results[key]["convert_calls_per_sec"] = measureRate([&]
+        {
+            in.convert(out);
+            return 1;
+        }, seconds);
+        results[key]["converter_calls_per_sec"] = measureRate([&]
+        {
+            converter(in.as<const void *>(), out.as<void *>(), numElems);
+            return 1;
+        }, seconds);
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Memory mapped file buffer managers versus stream file access
+ **********************************************************************/
+static const size_t fileBenchSize = 256*1024*1024;
+
+static Pothos::BufferManagerArgs fileBenchArgs(const std::string &path)
+{
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 8;
+    args.bufferSize = 1024*1024;
+    args.filePath = path;
+    return args;
+}
+
+//! Read every word so that the pages are really accessed
+static uint64_t checksum(const Pothos::BufferChunk &buff)
+{
+    uint64_t sum = 0;
+    const auto p = buff.as<const uint64_t *>();
+    for (size_t i = 0; i < buff.length/sizeof(uint64_t); i++) sum += p[i];
+    return sum;
+}
+
+POTHOS_BENCHMARK("/framework/buffers", bench_memory_mapped_files)
+{
+    json results;
+    Poco::TemporaryFile tempFile;
+    const auto args = fileBenchArgs(tempFile.path());
+    volatile uint64_t sum = 0;
+
+    //record the file with the mmap writer and stream writes
+    results["mmap_writer_GBps"] = measureRate([&]
+    {
+        auto manager = Pothos::BufferManager::make("mmap_writer", args);
+        for (size_t total = 0; total < fileBenchSize;)
+        {
+            const auto &buff = manager->front();
+            std::memset(buff.as<void *>(), int(total), buff.length);
+            total += buff.length;
+            manager->pop(buff.length);
+        }
+        return fileBenchSize;
+    }, seconds)/GB;
+    results["ofstream_write_GBps"] = measureRate([&]
+    {
+        auto manager = Pothos::BufferManager::make("generic", args);
+        std::ofstream ofile(tempFile.path(), std::ios::binary | std::ios::trunc);
+        for (size_t total = 0; total < fileBenchSize;)
+        {
+            const auto buff = manager->front();
+            std::memset(buff.as<void *>(), int(total), buff.length);
+            ofile.write(buff.as<const char *>(), buff.length);
+            total += buff.length;
+            manager->pop(buff.length);
+        }
+        return fileBenchSize;
+    }, seconds)/GB;
+
+    //read the file back with the mmap reader and stream reads (warm cache)
+    results["mmap_reader_GBps"] = measureRate([&]
+    {
+        auto manager = Pothos::BufferManager::make("mmap_reader", args);
+        size_t total = 0;
+        while (not manager->empty())
+        {
+            const auto buff = manager->front();
+            sum = sum + checksum(buff);
+            total += buff.length;
+            manager->pop(buff.length);
+        }
+        return total;
+    }, seconds)/GB;
+    results["ifstream_read_GBps"] = measureRate([&]
+    {
+        auto manager = Pothos::BufferManager::make("generic", args);
+        std::ifstream ifile(tempFile.path(), std::ios::binary);
+        size_t total = 0;
+        while (ifile)
+        {
+            auto buff = manager->front();
+            ifile.read(buff.as<char *>(), buff.length);
+            buff.length = size_t(ifile.gcount());
+            sum = sum + checksum(buff);
+            total += buff.length;
+            manager->pop(buff.length);
+        }
+        return total;
+    }, seconds)/GB;
+    results["file_size_MiB"] = fileBenchSize/(1024*1024);
+    return results;
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2013-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Benchmarks/Benchmark.hpp"
+#include <Pothos/Object.hpp>
+#include <Pothos/Callable.hpp>
+#include <Pothos/Framework/Label.hpp>
+#include <Pothos/Managed.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <complex>
+#include <future>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const double NS = 1e9;
+
+/***********************************************************************
+ * Object create and copy for pooled and heap allocated containers
+ **********************************************************************/
+template <typename T>
+static json benchObjectType(const T &value, const double seconds)
+{
+    json results;
+    const Pothos::Object obj(value);
+    results["pooled"] = sizeof(Pothos::Detail::ObjectContainerT<T>) <= 64;
+    results["create_ns_per_op"] = NS/measureRate([&]
+    {
+        const Pothos::Object tmp(value);
+        return 1;
+    }, seconds);
+    results["copy_ns_per_op"] = NS/measureRate([&]
+    {
+        const Pothos::Object tmp(obj);
+        return 1;
+    }, seconds);
+    return results;
+}
+
+POTHOS_BENCHMARK("/object", bench_object_create)
+{
+    json results;
+    results["int"] = benchObjectType(int(42), seconds);
+    results["double"] = benchObjectType(double(1.5), seconds);
+    results["complex_double"] = benchObjectType(std::complex<double>(1.0, 2.0), seconds);
+    results["string"] = benchObjectType(std::string("hello"), seconds);
+    results["vector"] = benchObjectType(std::vector<int>(16), seconds);
+    return results;
+}
+
+/***********************************************************************
+ * Label creation with small data and opaque calls with scalar arguments
+ **********************************************************************/
+static int addInts(const int a, const int b)
+{
+    return a + b;
+}
+
+POTHOS_BENCHMARK("/object", bench_object_labels_calls)
+{
+    json results;
+    const std::string id("rxTime");
+    unsigned long long index = 0;
+    results["label_ns_per_op"] = NS/measureRate([&]
+    {
+        const Pothos::Label label(id, index++, 0);
+        return 1;
+    }, seconds);
+
+    const Pothos::Callable call(&addInts);
+    const Pothos::Object args[2] = {Pothos::Object(1), Pothos::Object(2)};
+    results["opaque_call_ns_per_op"] = NS/measureRate([&]
+    {
+        call.opaqueCall(args, 2);
+        return 1;
+    }, seconds);
+    const Pothos::Object convertArgs[2] = {Pothos::Object(short(1)), Pothos::Object(long(2))};
+    results["opaque_call_converted_ns_per_op"] = NS/measureRate([&]
+    {
+        call.opaqueCall(convertArgs, 2);
+        return 1;
+    }, seconds);
+    results["call_ns_per_op"] = NS/measureRate([&]
+    {
+        call.call(1, 2);
+        return 1;
+    }, seconds);
+    return results;
+}
+
+/***********************************************************************
+ * Registry reads from many threads: conversions and lookups per second
+ **********************************************************************/
+template <typename Fcn>
+static double measureThreadsRate(const size_t numThreads, const Fcn &fcn, const double seconds)
+{
+    std::vector<std::future<double>> rates;
+    for (size_t i = 0; i < numThreads; i++)
+    {
+        rates.push_back(std::async(std::launch::async, [&]{return measureRate(fcn, seconds);}));
+    }
+    double total = 0;
+    for (auto &rate : rates) total += rate.get();
+    return total;
+}
+
+POTHOS_BENCHMARK("/object", bench_object_registry_scaling)
+{
+    json results;
+    const Pothos::Object intObj(int(42));
+    const Pothos::PluginPath path("/benchmarks/object/bench_object_registry_scaling");
+    for (const size_t numThreads : {1, 2, 4, 8, 16, 32, 64})
+    {
+        const auto key = std::to_string(numThreads)+"_threads";
+        results["conversions_per_sec"][key] = measureThreadsRate(numThreads, [&]
+        {
+            intObj.convert<long>();
+            return 1;
+        }, seconds);
+        results["class_lookups_per_sec"][key] = measureThreadsRate(numThreads, []
+        {
+            Pothos::ManagedClass::lookup(typeid(Pothos::BufferChunk));
+            return 1;
+        }, seconds);
+        results["plugin_gets_per_sec"][key] = measureThreadsRate(numThreads, [&]
+        {
+            Pothos::PluginRegistry::get(path);
+            return 1;
+        }, seconds);
+    }
+    return results;
+}
@@ -0,0 +1,174 @@
+// Copyright (c) 2013-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Benchmarks/Benchmark.hpp"
+#include <Pothos/Proxy.hpp>
+#include <Pothos/Remote.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Util/Network.hpp>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Net/SocketStream.h>
+#include <Poco/Net/SocketAddress.h>
+#include <future>
+#include <memory>
+#include <vector>
+
+using json = nlohmann::json;
+
+static const double MB = 1e6;
+
+/***********************************************************************
+ * A proxy server process on this host and a client environment
+ **********************************************************************/
+struct RemoteBench
+{
+    RemoteBench(const Pothos::ProxyEnvironmentArgs &args = Pothos::ProxyEnvironmentArgs()):
+        server("tcp://"+Pothos::Util::getWildcardAddr()),
+        uri("tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort())),
+        client(uri),
+        env(client.makeEnvironment("managed", args))
+    {
+        return;
+    }
+
+    Pothos::RemoteServer server;
+    const std::string uri;
+    Pothos::RemoteClient client;
+    Pothos::ProxyEnvironment::Sptr env;
+};
+
+//! Round trips of a small call on a remote object
+static double measureCalls(const Pothos::ProxyEnvironment::Sptr &env, const double seconds)
+{
+    auto chunk = env->findProxy("Pothos/BufferChunk")(size_t(16));
+    return measureRate([&]{chunk.call<size_t>("getEnd"); return 1;}, seconds);
+}
+
+/***********************************************************************
+ * Loopback call round trips and buffer payloads per wire format
+ **********************************************************************/
+POTHOS_BENCHMARK("/remote", bench_remote_calls)
+{
+    json results;
+    for (const std::string format : {"stream", "chunked"})
+    {
+        Pothos::ProxyEnvironmentArgs args;
+        args["wireFormat"] = format;
+        RemoteBench bench(args);
+        results[format]["calls_per_sec"] = measureCalls(bench.env, seconds);
+
+        //send a buffer to the server and get it back again
+        auto chunkClass = bench.env->findProxy("Pothos/BufferChunk");
+        for (const size_t numBytes : {size_t(4*1024), size_t(1024*1024)})
+        {
+            const Pothos::BufferChunk buff(numBytes);
+            results[format][std::to_string(numBytes/1024)+"_KiB_payload_MBps"] = measureRate([&]
+            {
+                auto chunk = chunkClass();
+                chunk.call("append", buff);
+                chunk.toObject();
+                return 2*numBytes;
+            }, seconds)/MB;
+        }
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Pipelined asynchronous calls versus synchronous calls
+ **********************************************************************/
+POTHOS_BENCHMARK("/remote", bench_remote_async_calls)
+{
+    json results;
+    RemoteBench bench;
+    auto chunk = bench.env->findProxy("Pothos/BufferChunk")(size_t(16));
+    results["sync_calls_per_sec"] = measureCalls(bench.env, seconds);
+    for (const size_t depth : {8, 64})
+    {
+        results["async_depth_"+std::to_string(depth)+"_calls_per_sec"] = measureRate([&]
+        {
+            std::vector<std::future<Pothos::Proxy>> futures;
+            for (size_t i = 0; i < depth; i++) futures.push_back(chunk.callAsync("getEnd"));
+            for (auto &future : futures) future.get();
+            return depth;
+        }, seconds);
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Remote handle create and release churn
+ **********************************************************************/
+POTHOS_BENCHMARK("/remote", bench_remote_handle_churn)
+{
+    json results;
+    for (const bool batch : {false, true})
+    {
+        Pothos::ProxyEnvironmentArgs args;
+        args["batch"] = batch?"true":"false";
+        RemoteBench bench(args);
+        auto chunkClass = bench.env->findProxy("Pothos/BufferChunk");
+        results[batch?"coalesced_releases":"synchronous_releases"]["handles_per_sec"] = measureRate([&]
+        {
+            auto chunk = chunkClass(size_t(16));
+            return 1;
+        }, seconds);
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Many clients creating, querying, and releasing objects on one server
+ **********************************************************************/
+POTHOS_BENCHMARK("/remote", bench_remote_multi_client)
+{
+    json results;
+    Pothos::RemoteServer server("tcp://"+Pothos::Util::getWildcardAddr());
+    const auto uri = "tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort());
+    for (const size_t numClients : {1, 8})
+    {
+        auto clientTask = [uri, seconds](void)
+        {
+            Pothos::RemoteClient client(uri);
+            auto env = client.makeEnvironment("managed");
+            auto chunkClass = env->findProxy("Pothos/BufferChunk");
+            return measureRate([&]
+            {
+                auto chunk = chunkClass(size_t(16));
+                chunk.get<size_t>("length");
+                return 1;
+            }, seconds);
+        };
+
+        std::vector<std::future<double>> rates;
+        for (size_t i = 0; i < numClients; i++)
+        {
+            rates.push_back(std::async(std::launch::async, clientTask));
+        }
+        double total = 0;
+        for (auto &rate : rates) total += rate.get();
+        results[std::to_string(numClients)+"_clients_ops_per_sec"] = total;
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Same-host calls over the local socket versus a TCP socket
+ **********************************************************************/
+POTHOS_BENCHMARK("/remote", bench_remote_local_socket)
+{
+    json results;
+    RemoteBench bench;
+    results["client_calls_per_sec"] = measureCalls(bench.env, seconds);
+    results["local_socket"] = not Pothos::RemoteServer::getLocalSocketPath(bench.server.getActualPort()).empty();
+
+    //a client connection that always uses TCP
+    Poco::Net::StreamSocket socket(Poco::Net::SocketAddress(Pothos::Util::getLoopbackAddr(bench.server.getActualPort())));
+    socket.setNoDelay(true);
+    Poco::Net::SocketStream socketStream(socket);
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(socketStream, "managed");
+        results["tcp_calls_per_sec"] = measureCalls(env, seconds);
+    }
+    return results;
+}
@@ -0,0 +1,527 @@
+// Copyright (c) 2014-2017 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Benchmarks/Benchmark.hpp"
+#include <Pothos/Framework.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring> //memcpy
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+/***********************************************************************
+ * Helper blocks for the benchmark topologies
+ **********************************************************************/
+struct BenchSource : Pothos::Block
+{
+    BenchSource(const Pothos::DType &dtype, const size_t labelInterval = 0,
+        const std::string &bufferManager = "", const bool hugePages = false):
+        _labelInterval(labelInterval),
+        _bufferManager(bufferManager),
+        _hugePages(hugePages),
+        _total(0)
+    {
+        this->setupOutput(0, dtype);
+        this->setName("BenchSource");
+    }
+
+    void work(void)
+    {
+        auto out0 = this->output(0);
+        const size_t n = out0->elements();
+        if (n == 0) return;
+
+        //labels at a fixed interval over the stream
+        if (_labelInterval != 0)
+        {
+            for (size_t i = (_labelInterval - (_total % _labelInterval)) % _labelInterval; i < n; i += _labelInterval)
+            {
+                out0->postLabel("bench", Pothos::Object(), i);
+            }
+        }
+        _total += n;
+        out0->produce(n);
+    }
+
+    std::shared_ptr<Pothos::BufferManager> getOutputBufferManager(const std::string &name, const std::string &domain)
+    {
+        if (_bufferManager.empty() or not domain.empty()) return Pothos::Block::getOutputBufferManager(name, domain);
+        Pothos::BufferManagerArgs args;
+        args.hugePages = _hugePages;
+        return Pothos::BufferManager::make(_bufferManager, args);
+    }
+
+    const size_t _labelInterval;
+    const std::string _bufferManager;
+    const bool _hugePages;
+    unsigned long long _total;
+};
+
+struct BenchCopy : Pothos::Block
+{
+    BenchCopy(const Pothos::DType &dtype)
+    {
+        this->setupInput(0, dtype);
+        this->setupOutput(0, dtype);
+        this->setName("BenchCopy");
+    }
+
+    void work(void)
+    {
+        const size_t n = this->workInfo().minElements;
+        if (n == 0) return;
+        auto in0 = this->input(0);
+        auto out0 = this->output(0);
+        std::memcpy(out0->buffer().as<void *>(), in0->buffer().as<const void *>(), n*in0->dtype().size());
+        in0->consume(n);
+        out0->produce(n);
+    }
+};
+
+struct BenchAdder : Pothos::Block
+{
+    BenchAdder(const size_t numInputs)
+    {
+        for (size_t i = 0; i < numInputs; i++) this->setupInput(i, "float32");
+        this->setupOutput(0, "float32");
+        this->setName("BenchAdder");
+    }
+
+    void work(void)
+    {
+        const size_t n = this->workInfo().minElements;
+        if (n == 0) return;
+        const auto &inputs = this->inputs();
+        auto out = this->output(0)->buffer().as<float *>();
+        std::memcpy(out, inputs[0]->buffer().as<const void *>(), n*sizeof(float));
+        for (size_t i = 1; i < inputs.size(); i++)
+        {
+            const auto in = inputs[i]->buffer().as<const float *>();
+            for (size_t j = 0; j < n; j++) out[j] += in[j];
+        }
+        for (auto input : inputs) input->consume(n);
+        this->output(0)->produce(n);
+    }
+};
+
+struct BenchSink : Pothos::Block
+{
+    BenchSink(const Pothos::DType &dtype, const size_t reserve = 0):
+        bytes(0),
+        labels(0),
+        workCalls(0)
+    {
+        this->setupInput(0, dtype);
+        this->input(0)->setReserve(reserve);
+        this->setName("BenchSink");
+    }
+
+    void work(void)
+    {
+        workCalls.fetch_add(1, std::memory_order_relaxed);
+        auto in0 = this->input(0);
+        const size_t n = in0->elements();
+        if (n == 0) return;
+        size_t numLabels = 0;
+        for (const auto &label : in0->labels())
+        {
+            if (label.index < n) numLabels++;
+        }
+        labels.fetch_add(numLabels, std::memory_order_relaxed);
+        bytes.fetch_add(n*in0->dtype().size(), std::memory_order_relaxed);
+        in0->consume(n);
+    }
+
+    std::atomic<unsigned long long> bytes;
+    std::atomic<unsigned long long> labels;
+    std::atomic<unsigned long long> workCalls;
+};
+
+//! Forward messages around a ring, the first relay injects the tokens
+struct BenchRelay : Pothos::Block
+{
+    BenchRelay(const size_t tokens = 0):
+        hops(0),
+        _tokens(tokens)
+    {
+        this->setupInput(0);
+        this->setupOutput(0);
+        this->setName("BenchRelay");
+    }
+
+    void work(void)
+    {
+        auto in0 = this->input(0);
+        auto out0 = this->output(0);
+        for (; _tokens != 0; _tokens--) out0->postMessage(_tokens);
+        while (in0->hasMessage())
+        {
+            out0->postMessage(in0->popMessage());
+            hops.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<unsigned long long> hops;
+    size_t _tokens;
+};
+
+//! Forward tokens around a ring of signals and overloaded slots
+struct BenchSlotRelay : Pothos::Block
+{
+    BenchSlotRelay(const size_t tokens = 0):
+        hops(0),
+        _tokens(tokens)
+    {
+        this->registerSignal("token");
+        this->registerCall(this, "handleToken", &BenchSlotRelay::handleInt);
+        this->registerCall(this, "handleToken", &BenchSlotRelay::handleDouble);
+        this->setName("BenchSlotRelay");
+    }
+
+    void activate(void)
+    {
+        for (size_t i = 0; i < _tokens; i++)
+        {
+            if (i % 2 == 0) this->emitSignal("token", int(i));
+            else this->emitSignal("token", double(i));
+        }
+    }
+
+    void handleInt(const int token)
+    {
+        hops.fetch_add(1, std::memory_order_relaxed);
+        this->emitSignal("token", token);
+    }
+
+    void handleDouble(const double token)
+    {
+        hops.fetch_add(1, std::memory_order_relaxed);
+        this->emitSignal("token", token);
+    }
+
+    std::atomic<unsigned long long> hops;
+    const size_t _tokens;
+};
+
+/***********************************************************************
+ * Helper methods for the topology benchmarks
+ **********************************************************************/
+//! The thread pool for a named mode: "thread_per_block", "condition", or "steal"
+//! Shared pools use numThreads threads, or one per hardware thread when 0.
+static Pothos::ThreadPool makeThreadPool(const std::string &mode, const bool adaptiveBuffers = false, const size_t numThreads = 0)
+{
+    Pothos::ThreadPoolArgs args;
+    if (mode != "thread_per_block") args.numThreads = (numThreads != 0)?numThreads:std::max<size_t>(1, std::thread::hardware_concurrency());
+    if (mode == "steal") args.yieldMode = "STEAL";
+    args.adaptiveBuffers = adaptiveBuffers;
+    return Pothos::ThreadPool(args);
+}
+
+//! Run the topology and measure the counter, then stop the topology
+template <typename Fcn>
+static double runAndMeasure(Pothos::Topology &topology, Fcn &&counter, const double seconds)
+{
+    topology.commit();
+    const auto rate = measureCounterRate(counter, seconds);
+    topology.disconnectAll();
+    return rate;
+}
+
+static const double MB = 1e6;
+
+/***********************************************************************
+ * Throughput of a chain of copy blocks
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_chain_throughput)
+{
+    json results;
+    for (const std::string mode : {"thread_per_block", "condition", "steal"})
+    {
+        for (const size_t numBlocks : {10, 100, 1000})
+        {
+            auto source = std::make_shared<BenchSource>("int32");
+            auto sink = std::make_shared<BenchSink>("int32");
+            std::vector<std::shared_ptr<BenchCopy>> copies;
+            Pothos::Topology topology;
+            topology.setThreadPool(makeThreadPool(mode));
+            std::shared_ptr<Pothos::Block> last = source;
+            for (size_t i = 0; i < numBlocks; i++)
+            {
+                copies.push_back(std::make_shared<BenchCopy>("int32"));
+                topology.connect(last, 0, copies.back(), 0);
+                last = copies.back();
+            }
+            topology.connect(last, 0, sink, 0);
+            results[mode][std::to_string(numBlocks)+"_blocks_MBps"] = runAndMeasure(
+                topology, [&]{return sink->bytes.load();}, seconds)/MB;
+        }
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Latency of a message hop with one token circulating in a ring
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_hop_latency)
+{
+    json results;
+    for (const std::string mode : {"thread_per_block", "condition", "steal"})
+    {
+        for (const size_t numBlocks : {2, 10, 20, 100})
+        {
+            std::vector<std::shared_ptr<BenchRelay>> relays;
+            for (size_t i = 0; i < numBlocks; i++) relays.push_back(std::make_shared<BenchRelay>((i == 0)?1:0));
+            Pothos::Topology topology;
+            topology.setThreadPool(makeThreadPool(mode));
+            for (size_t i = 0; i < numBlocks; i++) topology.connect(relays[i], 0, relays[(i+1)%numBlocks], 0);
+            const auto hopsPerSec = runAndMeasure(topology, [&]{return relays[0]->hops.load()*numBlocks;}, seconds);
+            results[mode][std::to_string(numBlocks)+"_blocks_us_per_hop"] = 1e6/hopsPerSec;
+        }
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Message-only flows with many tokens in flight
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_message_flow)
+{
+    json results;
+    for (const std::string mode : {"thread_per_block", "condition", "steal"})
+    {
+        const size_t numBlocks = 8;
+        std::vector<std::shared_ptr<BenchRelay>> relays;
+        for (size_t i = 0; i < numBlocks; i++) relays.push_back(std::make_shared<BenchRelay>((i == 0)?64:0));
+        Pothos::Topology topology;
+        topology.setThreadPool(makeThreadPool(mode));
+        for (size_t i = 0; i < numBlocks; i++) topology.connect(relays[i], 0, relays[(i+1)%numBlocks], 0);
+        results[mode]["messages_per_sec"] = runAndMeasure(topology, [&]
+        {
+            unsigned long long hops = 0;
+            for (const auto &relay : relays) hops += relay->hops.load();
+            return hops;
+        }, seconds);
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Slot calls with overloaded slots and many tokens in flight
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_slot_calls)
+{
+    json results;
+    for (const std::string mode : {"thread_per_block", "condition", "steal"})
+    {
+        const size_t numBlocks = 8;
+        std::vector<std::shared_ptr<BenchSlotRelay>> relays;
+        for (size_t i = 0; i < numBlocks; i++) relays.push_back(std::make_shared<BenchSlotRelay>((i == 0)?64:0));
+        Pothos::Topology topology;
+        topology.setThreadPool(makeThreadPool(mode));
+        for (size_t i = 0; i < numBlocks; i++) topology.connect(relays[i], "token", relays[(i+1)%numBlocks], "handleToken");
+        results[mode]["slot_calls_per_sec"] = runAndMeasure(topology, [&]
+        {
+            unsigned long long hops = 0;
+            for (const auto &relay : relays) hops += relay->hops.load();
+            return hops;
+        }, seconds);
+    }
+    return results;
+}
+
+/***********************************************************************
+ * One source subscribed by 8 sinks, and 8 sources added into 1 sink
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_fan_out_fan_in)
+{
+    json results;
+    const size_t fanSize = 8;
+    for (const std::string mode : {"thread_per_block", "condition", "steal"})
+    {
+        {
+            auto source = std::make_shared<BenchSource>("float32");
+            std::vector<std::shared_ptr<BenchSink>> sinks;
+            Pothos::Topology topology;
+            topology.setThreadPool(makeThreadPool(mode));
+            for (size_t i = 0; i < fanSize; i++)
+            {
+                sinks.push_back(std::make_shared<BenchSink>("float32"));
+                topology.connect(source, 0, sinks.back(), 0);
+            }
+            results[mode]["fan_out_per_sink_MBps"] = runAndMeasure(
+                topology, [&]{return sinks.back()->bytes.load();}, seconds)/MB;
+        }
+        {
+            auto adder = std::make_shared<BenchAdder>(fanSize);
+            auto sink = std::make_shared<BenchSink>("float32");
+            std::vector<std::shared_ptr<BenchSource>> sources;
+            Pothos::Topology topology;
+            topology.setThreadPool(makeThreadPool(mode));
+            for (size_t i = 0; i < fanSize; i++)
+            {
+                sources.push_back(std::make_shared<BenchSource>("float32"));
+                topology.connect(sources.back(), 0, adder, i);
+            }
+            topology.connect(adder, 0, sink, 0);
+            results[mode]["fan_in_output_MBps"] = runAndMeasure(
+                topology, [&]{return sink->bytes.load();}, seconds)/MB;
+        }
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Pool contention: more blocks than threads in a small and a large pool
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_pool_contention)
+{
+    json results;
+    const size_t numBlocks = 32;
+    for (const std::string mode : {"condition", "steal"})
+    {
+        for (const size_t numThreads : {2, 16})
+        {
+            auto &modeResults = results[mode][std::to_string(numThreads)+"_threads"];
+            {
+                auto source = std::make_shared<BenchSource>("int32");
+                auto sink = std::make_shared<BenchSink>("int32");
+                std::vector<std::shared_ptr<BenchCopy>> copies;
+                Pothos::Topology topology;
+                topology.setThreadPool(makeThreadPool(mode, false, numThreads));
+                std::shared_ptr<Pothos::Block> last = source;
+                for (size_t i = 0; i < numBlocks; i++)
+                {
+                    copies.push_back(std::make_shared<BenchCopy>("int32"));
+                    topology.connect(last, 0, copies.back(), 0);
+                    last = copies.back();
+                }
+                topology.connect(last, 0, sink, 0);
+                modeResults["chain_MBps"] = runAndMeasure(
+                    topology, [&]{return sink->bytes.load();}, seconds)/MB;
+            }
+            {
+                auto source = std::make_shared<BenchSource>("float32");
+                std::vector<std::shared_ptr<BenchSink>> sinks;
+                Pothos::Topology topology;
+                topology.setThreadPool(makeThreadPool(mode, false, numThreads));
+                for (size_t i = 0; i < numBlocks; i++)
+                {
+                    sinks.push_back(std::make_shared<BenchSink>("float32"));
+                    topology.connect(source, 0, sinks.back(), 0);
+                }
+                modeResults["fan_out_per_sink_MBps"] = runAndMeasure(
+                    topology, [&]{return sinks.back()->bytes.load();}, seconds)/MB;
+            }
+        }
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Label-heavy streams through a chain that propagates the labels
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_label_stream)
+{
+    json results;
+    for (const size_t interval : {0, 4096, 256, 16, 1})
+    {
+        auto source = std::make_shared<BenchSource>("int32", interval);
+        auto copy0 = std::make_shared<BenchCopy>("int32");
+        auto copy1 = std::make_shared<BenchCopy>("int32");
+        auto sink = std::make_shared<BenchSink>("int32");
+        Pothos::Topology topology;
+        topology.connect(source, 0, copy0, 0);
+        topology.connect(copy0, 0, copy1, 0);
+        topology.connect(copy1, 0, sink, 0);
+        topology.commit();
+        const auto labelsPerSec = measureCounterRate([&]{return sink->labels.load();}, seconds);
+        const auto bytesPerSec = measureCounterRate([&]{return sink->bytes.load();}, seconds);
+        topology.disconnectAll();
+        const auto key = (interval == 0)?std::string("no_labels"):("every_"+std::to_string(interval)+"_elements");
+        results[key]["MBps"] = bytesPerSec/MB;
+        results[key]["labels_per_sec"] = labelsPerSec;
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Consumers with large and odd-sized input reserves
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_reserve_consumer)
+{
+    json results;
+    for (const size_t reserve : {0, 1000, 3001, 10000})
+    {
+        auto source = std::make_shared<BenchSource>("int32");
+        auto sink = std::make_shared<BenchSink>("int32", reserve);
+        Pothos::Topology topology;
+        topology.connect(source, 0, sink, 0);
+        topology.commit();
+        const auto bytesPerSec = measureCounterRate([&]{return sink->bytes.load();}, seconds);
+        const auto workPerSec = measureCounterRate([&]{return sink->workCalls.load();}, seconds);
+        topology.disconnectAll();
+        const auto key = "reserve_"+std::to_string(reserve);
+        results[key]["MBps"] = bytesPerSec/MB;
+        results[key]["work_calls_per_sec"] = workPerSec;
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Output buffer managers and adaptive buffer sizes
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_buffer_managers)
+{
+    json results;
+    const std::vector<std::pair<std::string, bool>> managers{
+        {"generic", false}, {"circular", false}, {"circular", true}};
+    for (const auto &manager : managers)
+    {
+        auto source = std::make_shared<BenchSource>("int32", 0, manager.first, manager.second);
+        auto sink = std::make_shared<BenchSink>("int32", 3001);
+        Pothos::Topology topology;
+        topology.connect(source, 0, sink, 0);
+        const auto key = manager.first + (manager.second?"_huge_pages":"");
+        results[key]["MBps"] = runAndMeasure(topology, [&]{return sink->bytes.load();}, seconds)/MB;
+    }
+    for (const bool adaptive : {false, true})
+    {
+        auto source = std::make_shared<BenchSource>("int32");
+        auto sink = std::make_shared<BenchSink>("int32");
+        Pothos::Topology topology;
+        topology.setThreadPool(makeThreadPool("condition", adaptive));
+        topology.connect(source, 0, sink, 0);
+        topology.commit();
+        const auto bytesPerSec = measureCounterRate([&]{return sink->bytes.load();}, seconds);
+        const auto workPerSec = measureCounterRate([&]{return sink->workCalls.load();}, seconds);
+        topology.disconnectAll();
+        const auto key = adaptive?"adaptive":"fixed";
+        results[key]["MBps"] = bytesPerSec/MB;
+        results[key]["work_calls_per_sec"] = workPerSec;
+    }
+    return results;
+}
+
+/***********************************************************************
+ * Shared memory ring between a sink and source block
+ **********************************************************************/
+POTHOS_BENCHMARK("/framework/topology", bench_shared_memory_flow)
+{
+    json results;
+    for (const size_t capacity : {size_t(64*1024), size_t(8*1024*1024)})
+    {
+        auto source = std::make_shared<BenchSource>("int32", 4096);
+        auto sink = std::make_shared<BenchSink>("int32");
+        auto shmSink = Pothos::BlockRegistry::make("/shared_memory_sink", capacity);
+        auto shmSource = Pothos::BlockRegistry::make("/shared_memory_source", shmSink.call<std::string>("getPath"));
+        Pothos::Topology topology;
+        topology.connect(source, 0, shmSink, 0);
+        topology.connect(shmSource, 0, sink, 0);
+        results[std::to_string(capacity/1024)+"_KiB_ring_MBps"] = runAndMeasure(
+            topology, [&]{return sink->bytes.load();}, seconds)/MB;
+    }
+    return results;
+}
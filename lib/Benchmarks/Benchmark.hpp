@@ -0,0 +1,86 @@
+// Copyright (c) 2013-2020 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Plugin.hpp>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <json.hpp>
+
+/*!
+ * Declare a benchmark inside a plugin.
+ *
+ * The benchmark is installed into /benchmarks/path/name in the PluginRegistry
+ * as a call that takes the measurement time in seconds for each result
+ * and returns the results as a string dump of a JSON object.
+ * Run the benchmarks and collect the results with PothosUtil --benchmarks.
+ *
+ * \param path a string literal for a valid PluginPath
+ * \param name a valid function name
+ *
+ * Example usage:
+ * \code
+ * POTHOS_BENCHMARK("/sys/foo", bench_bar)
+ * {
+ *     nlohmann::json results;
+ *     results["ops_per_sec"] = measureRate(etc..., seconds);
+ *     return results;
+ * }
+ * \endcode
+ */
+#define POTHOS_BENCHMARK(path, name) \
+    static nlohmann::json name(const double seconds); \
+    static std::string name ## Dump(const double seconds) \
+    { \
+        return name(seconds).dump(); \
+    } \
+    pothos_static_block(name) \
+    { \
+        Pothos::PluginRegistry::addCall( \
+            Pothos::PluginPath("/benchmarks" path).join(#name), &name ## Dump); \
+    } \
+    static nlohmann::json name(const double seconds)
+
+/*!
+ * Measure the rate of a function that performs some units of work.
+ * The function is called repeatedly for the specified duration
+ * after a short warm-up and returns the number of units done per call.
+ * \return the units of work per second
+ */
+template <typename Fcn>
+double measureRate(Fcn &&fcn, const double seconds)
+{
+    const auto warmUp = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds/10);
+    while (std::chrono::steady_clock::now() < warmUp) fcn();
+
+    double units = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto exit = start + std::chrono::duration<double>(seconds);
+    auto now = start;
+    while (now < exit)
+    {
+        units += fcn();
+        now = std::chrono::steady_clock::now();
+    }
+    return units/std::chrono::duration<double>(now-start).count();
+}
+
+/*!
+ * Measure the rate of a counter that advances in the background,
+ * such as the total elements consumed by a block in a running topology.
+ * The counter is sampled after a short warm-up and after the duration.
+ * \return the counter increments per second
+ */
+template <typename Fcn>
+double measureCounterRate(Fcn &&counter, const double seconds)
+{
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds/10));
+    const double start = double(counter());
+    const auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    const double stop = double(counter());
+    const auto t1 = std::chrono::steady_clock::now();
+    return (stop-start)/std::chrono::duration<double>(t1-t0).count();
+}
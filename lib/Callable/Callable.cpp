@@ -1,12 +1,15 @@
 // Copyright (c) 2013-2018 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Object/ConvertChain.hpp"
+#include "Util/RegistrySnapshot.hpp"
 #include <Pothos/Callable/CallableImpl.hpp>
 #include <Pothos/Callable/Exception.hpp>
 #include <Pothos/Object/Exception.hpp>
 #include <Pothos/Util/TypeInfo.hpp>
 #include <Poco/Format.h>
 #include <cassert>
+#include <memory>
 #include <algorithm> //min/max
 
 Pothos::Callable::Callable(void)
@@ -14,6 +17,173 @@ Pothos::Callable::Callable(void)
     assert(not *this);
 }
 
+/***********************************************************************
+ * Argument conversion plans cached per argument type signature
+ **********************************************************************/
+struct ArgConvert
+{
+    const std::type_info *inputType;
+    bool toObject; //!< wrap the argument in an Object of type Object
+    std::vector<Pothos::Callable> chain; //!< empty when the type is exact
+};
+
+struct Pothos::Detail::CallPlan
+{
+    size_t generation; //!< the conversions generation when planned
+    bool exact; //!< all arguments have the exact call types
+    std::vector<ArgConvert> args;
+    CallPlan *next;
+};
+
+//! Calls with up to this many arguments gather them on the stack
+static const size_t MAX_STACK_ARGS = 8;
+
+static bool planMatches(const Pothos::Detail::CallPlan &plan, const Pothos::Object **argPtrs)
+{
+    for (size_t i = 0; i < plan.args.size(); i++)
+    {
+        if (*plan.args[i].inputType != argPtrs[i]->type()) return false;
+    }
+    return true;
+}
+
+/*!
+ * Protects a plan list from deletion while a call uses one of its plans.
+ * Published plans are immutable, so the lookup does not lock.
+ */
+class PlanGuard
+{
+public:
+    PlanGuard(void):
+        _slot(~size_t(0))
+    {
+        return;
+    }
+
+    ~PlanGuard(void)
+    {
+        this->release();
+    }
+
+    //! Protect and return the current head of the list
+    Pothos::Detail::CallPlan *protect(const std::atomic<Pothos::Detail::CallPlan *> &plans)
+    {
+        this->release();
+        auto head = plans.load(std::memory_order_acquire);
+        while (head != nullptr)
+        {
+            _slot = RegistryHazards::acquire(head);
+            const auto current = plans.load(std::memory_order_seq_cst);
+            if (current == head) break;
+            this->release();
+            head = current;
+        }
+        return head;
+    }
+
+    void release(void)
+    {
+        if (_slot == ~size_t(0)) return;
+        RegistryHazards::release(_slot);
+        _slot = ~size_t(0);
+    }
+
+private:
+    size_t _slot;
+};
+
+static void deletePlans(Pothos::Detail::CallPlan *plan)
+{
+    while (plan != nullptr)
+    {
+        auto next = plan->next;
+        delete plan;
+        plan = next;
+    }
+}
+
+static bool isPlanListProtected(const Pothos::Detail::CallPlan *plan)
+{
+    for (; plan != nullptr; plan = plan->next)
+    {
+        if (RegistryHazards::isProtected(plan)) return true;
+    }
+    return false;
+}
+
+static const Pothos::Detail::CallPlan &getCallPlan(Pothos::Detail::CallableContainer &impl, const Pothos::Object **argPtrs, PlanGuard &guard)
+{
+    const size_t generation = Pothos::Detail::getConvertGeneration();
+    for (auto plan = guard.protect(impl.plans); plan != nullptr; plan = plan->next)
+    {
+        if (plan->generation == generation and planMatches(*plan, argPtrs)) return *plan;
+    }
+
+    //make a new plan for this argument type signature
+    std::unique_ptr<Pothos::Detail::CallPlan> plan(new Pothos::Detail::CallPlan());
+    plan->generation = generation;
+    plan->exact = true;
+    plan->args.resize(impl.getNumArgs());
+    for (size_t i = 0; i < plan->args.size(); i++)
+    {
+        auto &arg = plan->args[i];
+        const auto &callType = impl.type(int(i));
+        arg.inputType = &argPtrs[i]->type();
+        arg.toObject = (callType == typeid(Pothos::Object) and *arg.inputType != callType);
+        plan->exact = plan->exact and *arg.inputType == callType;
+        if (arg.toObject) continue;
+        try
+        {
+            arg.chain = Pothos::Detail::getConvertChain(*arg.inputType, callType);
+        }
+        catch(const Pothos::ObjectConvertError &ex)
+        {
+            throw Pothos::CallableArgumentError("Pothos::Callable::call()", Poco::format(
+                "failed to convert arg%z\n%s", i, std::string(ex.displayText())));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(impl.plansMutex);
+
+    //a list planned with another generation is replaced as a whole,
+    //its conversion chains may reference callables from unloaded modules
+    auto head = impl.plans.load(std::memory_order_relaxed);
+    if (head != nullptr and head->generation != generation)
+    {
+        impl.retiredPlans.push_back(head);
+        head = nullptr;
+    }
+
+    //publish the plan, it is owned by the container until replaced
+    plan->next = head;
+    impl.plans.store(plan.get(), std::memory_order_seq_cst);
+    guard.protect(impl.plans);
+
+    //delete the replaced lists which are no longer used by a call
+    for (auto it = impl.retiredPlans.begin(); it != impl.retiredPlans.end();)
+    {
+        if (isPlanListProtected(*it)) ++it;
+        else
+        {
+            deletePlans(*it);
+            it = impl.retiredPlans.erase(it);
+        }
+    }
+    return *plan.release();
+}
+
+static Pothos::Object convertArg(const ArgConvert &arg, const Pothos::Object &obj)
+{
+    if (arg.toObject) return Pothos::Object::make(obj);
+    if (arg.chain.empty()) return obj;
+    auto result = arg.chain.front().opaqueCall(&obj, 1);
+    for (size_t i = 1; i < arg.chain.size(); i++) result = arg.chain[i].opaqueCall(&result, 1);
+    return result;
+}
+
+/***********************************************************************
+ * Callable implementation
+ **********************************************************************/
 Pothos::Object Pothos::Callable::opaqueCall(const Object *inputArgs, const size_t numArgs) const
 {
     if (_impl == nullptr)
@@ -21,15 +191,25 @@ Pothos::Object Pothos::Callable::opaqueCall(const Object *inputArgs, const size_
         throw Pothos::CallableNullError("Pothos::Callable::call()", "null Callable");
     }
 
-    //Create callArgs which is a combination of inputArgs and boundArgs
-    std::vector<Object> callArgs(_impl->getNumArgs());
+    //Gather the call args which are a combination of inputArgs and boundArgs
+    const size_t numCallArgs = _impl->getNumArgs();
+    const Object *stackArgPtrs[MAX_STACK_ARGS];
+    std::vector<const Object *> heapArgPtrs;
+    const Object **argPtrs = stackArgPtrs;
+    if (numCallArgs > MAX_STACK_ARGS)
+    {
+        heapArgPtrs.resize(numCallArgs);
+        argPtrs = heapArgPtrs.data();
+    }
+    bool hasBoundArgs = false;
     size_t inputArgsIndex = 0;
-    for (size_t i = 0; i < callArgs.size(); i++)
+    for (size_t i = 0; i < numCallArgs; i++)
     {
         //is there a binding? if so use it
         if (_boundArgs.size() > i and _boundArgs[i])
         {
-            callArgs[i] = _boundArgs[i];
+            argPtrs[i] = &_boundArgs[i];
+            hasBoundArgs = true;
         }
 
         //otherwise, use the next available input argument
@@ -40,13 +220,33 @@ Pothos::Object Pothos::Callable::opaqueCall(const Object *inputArgs, const size_
                 throw Pothos::CallableArgumentError("Pothos::Callable::call()", Poco::format(
                     "expected input argument at %z", inputArgsIndex));
             }
-            callArgs[i] = inputArgs[inputArgsIndex++];
+            argPtrs[i] = inputArgs + inputArgsIndex++;
         }
+    }
+
+    //the input args already have the exact types, call without copies
+    PlanGuard guard;
+    const auto &plan = getCallPlan(*_impl, argPtrs, guard);
+    if (plan.exact and not hasBoundArgs)
+    {
+        guard.release();
+        return _impl->call(inputArgs);
+    }
 
-        //perform conversion on arg to get an Object of the exact type
+    //perform conversion on args to get Objects of the exact types
+    Object stackArgs[MAX_STACK_ARGS];
+    std::vector<Object> heapArgs;
+    Object *callArgs = stackArgs;
+    if (numCallArgs > MAX_STACK_ARGS)
+    {
+        heapArgs.resize(numCallArgs);
+        callArgs = heapArgs.data();
+    }
+    for (size_t i = 0; i < numCallArgs; i++)
+    {
         try
         {
-            callArgs[i] = callArgs[i].convert(_impl->type(int(i)));
+            callArgs[i] = convertArg(plan.args[i], *argPtrs[i]);
         }
         catch(const Pothos::ObjectConvertError &ex)
         {
@@ -55,7 +255,8 @@ Pothos::Object Pothos::Callable::opaqueCall(const Object *inputArgs, const size_
         }
     }
 
-    return _impl->call(callArgs.data());
+    guard.release();
+    return _impl->call(callArgs);
 }
 
 size_t Pothos::Callable::getNumArgs(void) const
@@ -135,14 +336,16 @@ std::string Pothos::Callable::toString(void) const
     return output;
 }
 
-Pothos::Detail::CallableContainer::CallableContainer(void)
+Pothos::Detail::CallableContainer::CallableContainer(void):
+    plans(nullptr)
 {
     return;
 }
 
 Pothos::Detail::CallableContainer::~CallableContainer(void)
 {
-    return;
+    deletePlans(plans.load(std::memory_order_acquire));
+    for (auto plan : retiredPlans) deletePlans(plan);
 }
 
 Pothos::Callable::operator bool(void) const
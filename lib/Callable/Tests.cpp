@@ -3,6 +3,7 @@
 
 #include <Pothos/Callable.hpp>
 #include <Pothos/Testing.hpp>
+#include <Pothos/Plugin.hpp>
 #include <string>
 #include <iostream>
 #include <functional>
@@ -50,6 +51,11 @@ struct TestClass
         return (long long)(a + b + c + d + e);
     }
 
+    static long sumNine(int a, int b, int c, int d, int e, int f, int g, int h, long i)
+    {
+        return long(a + b + c + d + e + f + g + h) + i;
+    }
+
     static int itsGonnaThrow(const int &)
     {
         throw std::runtime_error("told you so");
@@ -300,3 +306,68 @@ POTHOS_TEST_BLOCK("/callable/tests", test_callable_throwing)
     Pothos::Callable itsGonnaThrow(&TestClass::itsGonnaThrow);
     POTHOS_TEST_THROWS(itsGonnaThrow.call(int(42)), std::runtime_error);
 }
+
+/***********************************************************************
+ * Test repeated calls with cached argument conversions
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/callable/tests", test_callable_cached_conversions)
+{
+    //alternate between exact and converted argument types
+    Pothos::Callable add(&TestClass::add);
+    for (int i = 0; i < 3; i++)
+    {
+        POTHOS_TEST_EQUAL(3, add.call<long>(int(1), unsigned(2)));
+        POTHOS_TEST_EQUAL(7, add.call(long(3), short(4)).extract<long>());
+        POTHOS_TEST_EQUAL(11, add.call<long>(double(5), int(6)));
+        POTHOS_TEST_THROWS(add.call(std::string("x"), int(6)), Pothos::CallableArgumentError);
+    }
+
+    //copies share the plans, bindings are separate
+    Pothos::Callable addCopy(add);
+    addCopy.bind(long(10), 0);
+    POTHOS_TEST_EQUAL(3, add.call<long>(int(1), unsigned(2)));
+    POTHOS_TEST_EQUAL(12, addCopy.call<long>(unsigned(2)));
+    POTHOS_TEST_EQUAL(12, addCopy.call<long>(int(2)));
+
+    //more arguments than fit on the stack
+    Pothos::Callable sumNine(&TestClass::sumNine);
+    const Pothos::Object args[9] = {
+        Pothos::Object(1), Pothos::Object(1), Pothos::Object(1),
+        Pothos::Object(1), Pothos::Object(1), Pothos::Object(1),
+        Pothos::Object(1), Pothos::Object(1), Pothos::Object(1)};
+    for (int i = 0; i < 2; i++)
+    {
+        POTHOS_TEST_EQUAL(9, sumNine.opaqueCall(args, 9).extract<long>());
+        POTHOS_TEST_THROWS(sumNine.opaqueCall(args, 8), Pothos::CallableArgumentError);
+    }
+}
+
+/***********************************************************************
+ * Test cached plans across conversion registry changes
+ **********************************************************************/
+struct PlanTestArg
+{
+    int value;
+};
+
+static int planTestArgToInt(const PlanTestArg &arg)
+{
+    return arg.value;
+}
+
+POTHOS_TEST_BLOCK("/callable/tests", test_callable_plans_generation)
+{
+    const Pothos::PluginPath path("/object/convert/tests/plan_test_arg_to_int");
+    Pothos::Callable add(&TestClass::add);
+    POTHOS_TEST_THROWS(add.call(PlanTestArg{1}, unsigned(2)), Pothos::CallableArgumentError);
+
+    //new conversions replace the plans made before they were registered
+    Pothos::PluginRegistry::add(path, Pothos::Callable(&planTestArgToInt));
+    POTHOS_TEST_EQUAL(3, add.call<long>(PlanTestArg{1}, unsigned(2)));
+    POTHOS_TEST_EQUAL(5, add.call<long>(int(3), unsigned(2)));
+
+    //and removed conversions are no longer called through stale plans
+    Pothos::PluginRegistry::remove(path);
+    POTHOS_TEST_THROWS(add.call(PlanTestArg{1}, unsigned(2)), Pothos::CallableArgumentError);
+    POTHOS_TEST_EQUAL(5, add.call<long>(int(3), unsigned(2)));
+}
@@ -7,7 +7,9 @@
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <functional>
 #include <condition_variable>
+#include <chrono>
 
 /*!
  * The implementation of the exclusive access to the actor.
@@ -19,7 +21,13 @@ public:
     ActorInterface(void):
         _waitModeEnabled(true),
         _externalAcquired(0),
-        _aquireWaiting(false)
+        _aquireWaiting(false),
+        _wakeRequested(false),
+        _changeNotifierSet(false)
+        #ifdef POTHOS_WORK_PROFILER
+        ,_flagTimeEnabled(false),
+        _flagTime(0)
+        #endif
     {
         _changeFlagged.test_and_set();
     }
@@ -45,6 +53,14 @@ public:
      */
     bool workerThreadAcquire(const bool waitEnabled);
 
+    /*!
+     * Continue holding the actor context for another task.
+     * Consumes the change flag without waiting,
+     * and yields to pending external callers.
+     * \return true when a change was flagged, false otherwise
+     */
+    bool workerThreadContinue(void);
+
     //! Release exclusive access to the actor context.
     void workerThreadRelease(void);
 
@@ -74,7 +90,37 @@ public:
         _waitModeEnabled = enb;
     }
 
+    /*!
+     * Install a notifier that is called every time a change is flagged.
+     * This is used by schedulers that track runnable actors directly.
+     * The notifier is called once after installation to pick up
+     * any change that may have been flagged before installation.
+     * \param notifier the notification callback or empty to clear
+     */
+    void setChangeNotifier(const std::function<void(void)> &notifier);
+
+    #ifdef POTHOS_WORK_PROFILER
+    /*!
+     * Enable recording the time of the first flagged change.
+     * Used by the work profiler to measure the scheduling delay.
+     */
+    void enableFlagTimestamps(const bool enb)
+    {
+        _flagTimeEnabled = enb;
+    }
+
+    /*!
+     * Take the time of the first change flagged since the last take.
+     * \return the time since epoch in clock ticks or 0 if none
+     */
+    long long takeFlagTimestamp(void)
+    {
+        return _flagTime.exchange(0, std::memory_order_relaxed);
+    }
+    #endif
+
 private:
+    void _notifyChange(void);
     bool _workerThreadAcquireWait(const bool waitEnabled);
     bool _inExternalCall(void);
 
@@ -110,11 +156,32 @@ private:
 
     /*!
      * Mutex and CV used for waiting and notifying
-     * both in external calls and for worker thread
+     * both in external calls and for worker thread.
+     * Notifications are always made under the mutex,
+     * so that a waiter which has checked its condition
+     * cannot miss the notification before it waits.
      */
     std::mutex _acquireMutex;
     std::condition_variable _acquireCond;
     std::atomic_bool _aquireWaiting;
+
+    //! Set by wakeNoChange() to release a waiting worker (protected by mutex)
+    bool _wakeRequested;
+
+    /*!
+     * Optional scheduler notification on flagged changes.
+     * The atomic bool allows a lock-free check in the common case,
+     * the spin lock protects the callback against replacement.
+     */
+    std::atomic_bool _changeNotifierSet;
+    Pothos::Util::SpinLock _changeNotifierLock;
+    std::function<void(void)> _changeNotifier;
+
+    #ifdef POTHOS_WORK_PROFILER
+    //! The time of the first flagged change, only marked when enabled
+    bool _flagTimeEnabled;
+    std::atomic<long long> _flagTime;
+    #endif
 };
 
 /*!
@@ -144,15 +211,12 @@ inline bool ActorInterface::_inExternalCall(void)
 
 inline void ActorInterface::externalCallAcquire(void)
 {
-    //wait in a loop to acquire the call lock
-    //rather than assume notify will be reliable,
-    //we wait with a timeout and recheck the condition
+    //wait to acquire the call lock:
+    //the count is incremented before trying the lock,
+    //so every release of the call lock will notify us
     std::unique_lock<std::mutex> lock(_acquireMutex);
     _externalAcquired++;
-    while (not _extCallLock.try_lock())
-    {
-        _acquireCond.wait_for(lock, std::chrono::milliseconds(1));
-    }
+    _acquireCond.wait(lock, [this]{return _extCallLock.try_lock();});
 }
 
 inline void ActorInterface::externalCallRelease(void)
@@ -162,6 +226,7 @@ inline void ActorInterface::externalCallRelease(void)
     _externalAcquired--;
     _extCallLock.unlock();
     this->flagInternalChange();
+    std::lock_guard<std::mutex> lock(_acquireMutex);
     _acquireCond.notify_all();
 }
 
@@ -179,6 +244,12 @@ inline bool ActorInterface::workerThreadAcquire(const bool waitEnabled)
     return false;
 }
 
+inline bool ActorInterface::workerThreadContinue(void)
+{
+    if (_inExternalCall()) return false;
+    return not _changeFlagged.test_and_set(std::memory_order_acquire);
+}
+
 inline bool ActorInterface::_workerThreadAcquireWait(const bool waitEnabled)
 {
     //Ready to perform work when there are no external calls and change flagged:
@@ -193,12 +264,22 @@ inline bool ActorInterface::_workerThreadAcquireWait(const bool waitEnabled)
     };
 
     //Lock and wait on external calls to complete or activity to be flagged.
+    //The waiting flag is set before the condition is checked under the lock:
+    //either the flagging thread observes the waiting flag and notifies,
+    //or this thread observes the flagged change before it waits.
     if (waitEnabled)
     {
         if (isReady()) return true; //first check without locking
-        _aquireWaiting.store(true, std::memory_order_relaxed);
         std::unique_lock<std::mutex> lock(_acquireMutex);
-        bool rdy = _acquireCond.wait_for(lock, std::chrono::milliseconds(1), isReady);
+        _aquireWaiting.store(true);
+        bool rdy = false;
+        auto isWoken = [&]
+        {
+            rdy = isReady();
+            return rdy or _wakeRequested;
+        };
+        _acquireCond.wait(lock, isWoken);
+        _wakeRequested = false;
         _aquireWaiting.store(false, std::memory_order_relaxed);
         return rdy;
     }
@@ -210,19 +291,26 @@ inline bool ActorInterface::_workerThreadAcquireWait(const bool waitEnabled)
 inline void ActorInterface::workerThreadRelease(void)
 {
     //release call lock and notify any enqueued callers
+    //the fence orders the unlock before checking for callers
     _extCallLock.unlock();
-    if (_inExternalCall()) _acquireCond.notify_all();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (not _inExternalCall()) return;
+    std::lock_guard<std::mutex> lock(_acquireMutex);
+    _acquireCond.notify_all();
 }
 
 inline void ActorInterface::flagExternalChange(void)
 {
     //asynchronous indication
-    _changeFlagged.clear(std::memory_order_release);
+    _changeFlagged.clear(std::memory_order_seq_cst);
+    this->_notifyChange();
 
-    //wake a blocked thread to process the change
-    if (_aquireWaiting.load(std::memory_order_acquire))
+    //wake a blocked thread to process the change,
+    //external callers share the CV, so notify all
+    if (_aquireWaiting.load(std::memory_order_seq_cst))
     {
-        _acquireCond.notify_one();
+        std::lock_guard<std::mutex> lock(_acquireMutex);
+        _acquireCond.notify_all();
     }
 }
 
@@ -230,10 +318,41 @@ inline void ActorInterface::wakeNoChange(void)
 {
     //called by the thread environment at cleanup time
     //to cause workerThreadAcquire() to wakeup and exit
+    std::lock_guard<std::mutex> lock(_acquireMutex);
+    _wakeRequested = true;
     _acquireCond.notify_all();
 }
 
 inline void ActorInterface::flagInternalChange(void)
 {
     _changeFlagged.clear(std::memory_order_release);
+    this->_notifyChange();
+}
+
+inline void ActorInterface::_notifyChange(void)
+{
+    #ifdef POTHOS_WORK_PROFILER
+    //only the first flag after a take pays for the timestamp
+    if (_flagTimeEnabled and _flagTime.load(std::memory_order_relaxed) == 0)
+    {
+        long long expected = 0;
+        _flagTime.compare_exchange_strong(expected,
+            std::chrono::high_resolution_clock::now().time_since_epoch().count(),
+            std::memory_order_relaxed);
+    }
+    #endif
+
+    if (not _changeNotifierSet.load(std::memory_order_acquire)) return;
+    std::lock_guard<Pothos::Util::SpinLock> lock(_changeNotifierLock);
+    if (_changeNotifier) _changeNotifier();
+}
+
+inline void ActorInterface::setChangeNotifier(const std::function<void(void)> &notifier)
+{
+    {
+        std::lock_guard<Pothos::Util::SpinLock> lock(_changeNotifierLock);
+        _changeNotifier = notifier;
+        _changeNotifierSet.store(bool(notifier), std::memory_order_release);
+    }
+    this->_notifyChange();
 }
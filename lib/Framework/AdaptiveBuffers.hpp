@@ -0,0 +1,119 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+
+/*!
+ * Runtime sizing for the default buffer manager of an output port.
+ * The worker records the bytes produced by each work() call,
+ * and the bytes that were available in the output buffer.
+ * After each measurement window, the buffer size is adjusted:
+ *
+ *  - Grow: most calls filled the available buffer, and the call rate is high.
+ *    The block is bound by the buffer size and pays the scheduling overhead
+ *    of many small work() calls. Larger buffers amortize the overhead.
+ *  - Shrink: calls produce a small fraction of the buffer.
+ *    The producer is packetized or latency-sensitive,
+ *    so a smaller footprint keeps the buffers cache resident.
+ *    The size never shrinks below MinBufferSize or the port's reserve.
+ *
+ * Only the buffer size adapts, the number of buffers is fixed.
+ * A block that is starved for output buffers is waiting on downstream,
+ * and more buffers in flight would not raise the sustained throughput.
+ *
+ * The state is only accessed from the worker context.
+ */
+class AdaptiveBufferState
+{
+public:
+    //! Minimum number of producing calls in a measurement window
+    static const unsigned long long WindowCalls = 64;
+
+    //! Minimum duration of a measurement window
+    static std::chrono::high_resolution_clock::duration windowTime(void)
+    {
+        return std::chrono::milliseconds(10);
+    }
+
+    //! Producing calls per second above which a saturated link grows
+    static const unsigned long long GrowCallRate = 10000;
+
+    //! The largest buffer size that the adaptation will select
+    static const size_t MaxBufferSize = 1 << 20;
+
+    //! The smallest buffer size that the adaptation will select
+    static const size_t MinBufferSize = 1 << 12;
+
+    AdaptiveBufferState(const std::string &factory, const Pothos::BufferManagerArgs &args, const Pothos::BufferManager::Sptr &manager):
+        factory(factory),
+        args(args),
+        manager(manager),
+        numResizes(0)
+    {
+        this->resetWindow(std::chrono::high_resolution_clock::now());
+    }
+
+    //! Is the port still using the manager made for this state?
+    bool isInstalled(const Pothos::BufferManager::Sptr &installed) const
+    {
+        return not manager.owner_before(installed) and not installed.owner_before(manager);
+    }
+
+    /*!
+     * Record the result of a producing work() call.
+     * \param bytesProduced the number of bytes produced by the call
+     * \param bytesAvailable the bytes available in the output buffer
+     * \param bytesReserved the reserve requirement of the output port
+     * \return true when args changed and a new manager should be installed
+     */
+    bool update(const size_t bytesProduced, const size_t bytesAvailable, const size_t bytesReserved = 0)
+    {
+        windowCalls++;
+        windowBytes += bytesProduced;
+        if (bytesProduced*4 >= bytesAvailable*3) windowSaturated++;
+        if (windowCalls < WindowCalls) return false;
+
+        const auto now = std::chrono::high_resolution_clock::now();
+        const auto elapsed = now - windowStart;
+        if (elapsed < windowTime()) return false;
+
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        const bool saturated = windowSaturated*4 >= windowCalls*3;
+        const bool fastCalls = windowCalls >= GrowCallRate*seconds;
+        const bool sparse = windowBytes*8 < windowCalls*args.bufferSize;
+        const size_t oldSize = args.bufferSize;
+        const size_t minSize = std::max(size_t(MinBufferSize), bytesReserved);
+        if (saturated and fastCalls and args.bufferSize < MaxBufferSize) args.bufferSize *= 2;
+        else if (sparse and args.bufferSize/2 >= minSize) args.bufferSize /= 2;
+        this->resetWindow(now);
+
+        if (args.bufferSize == oldSize) return false;
+        numResizes++;
+        return true;
+    }
+
+    const std::string factory; //!< the factory name used to make the manager
+    Pothos::BufferManagerArgs args; //!< the currently selected manager args
+    std::weak_ptr<Pothos::BufferManager> manager; //!< the manager made with args
+    unsigned long long numResizes; //!< the number of times the args changed
+
+private:
+    void resetWindow(const std::chrono::high_resolution_clock::time_point &now)
+    {
+        windowStart = now;
+        windowCalls = 0;
+        windowSaturated = 0;
+        windowBytes = 0;
+    }
+
+    std::chrono::high_resolution_clock::time_point windowStart;
+    unsigned long long windowCalls;
+    unsigned long long windowSaturated;
+    unsigned long long windowBytes;
+};
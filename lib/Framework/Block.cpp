@@ -4,6 +4,7 @@
 
 #include "Framework/WorkerActor.hpp"
 #include "Framework/ThreadEnvironment.hpp"
+#include "Object/ConvertChain.hpp"
 #include <Pothos/Object/Containers.hpp>
 #include <Pothos/Framework/InputPortImpl.hpp>
 #include <Pothos/Framework/OutputPortImpl.hpp>
@@ -18,9 +19,11 @@ void Pothos::Block::setThreadPool(const ThreadPool &newThreadPool)
     if (_threadPool == newThreadPool) return; //no change
 
     //unregister if the old thread pool is valid
+    //the change notifier references the task, clear it first
     if (_threadPool)
     {
         auto threads = std::static_pointer_cast<ThreadEnvironment>(_threadPool.getContainer());
+        _actor->setChangeNotifier(TaskData::Notify());
         threads->unregisterTask(this);
     }
 
@@ -28,6 +31,14 @@ void Pothos::Block::setThreadPool(const ThreadPool &newThreadPool)
     if (newThreadPool)
     {
         auto threads = std::static_pointer_cast<ThreadEnvironment>(newThreadPool.getContainer());
+        _actor->setBurstPolicy(threads->getArgs().burstIterations, threads->getArgs().burstTime);
+        _actor->setAdaptiveBuffers(threads->getArgs().adaptiveBuffers);
+        _actor->setCircularFanout(threads->getArgs().circularFanout);
+
+        //allocate default buffers on the node of a single NUMA node pool
+        const auto &args = threads->getArgs();
+        const bool oneNode = args.affinityMode == "NUMA" and args.affinity.size() == 1;
+        _actor->setBufferNodeAffinity(oneNode?long(args.affinity.front()):-1);
         threads->registerTask(this,
             std::bind(&Pothos::WorkerActor::processTask, _actor.get(), std::placeholders::_1),
             std::bind(&Pothos::WorkerActor::wakeNoChange, _actor.get()));
@@ -35,6 +46,9 @@ void Pothos::Block::setThreadPool(const ThreadPool &newThreadPool)
         //configure the actor interface based on thread pool args
         //all we support for now is the default (wait) or spin mode
         _actor->enableWaitMode(threads->isWaitingEnabled());
+
+        //the actor notifies the pool when it flags a change
+        _actor->setChangeNotifier(threads->getReadyNotifier(this));
     }
 
     //and save the reference to the new pool
@@ -131,6 +145,7 @@ Pothos::OutputPort *Pothos::Block::setupOutput(const size_t index, const DType &
 void Pothos::Block::registerCallable(const std::string &name, const Callable &call)
 {
     _calls.insert(std::make_pair(name, call));
+    _actor->addSlotCall(name, call);
 
     //automatic registration of slots for calls that return void and are not "private"
     const bool isPrivate = name.front() == '_';
@@ -175,10 +190,16 @@ void Pothos::Block::registerProbe(
     this->registerSlot(slotName);
     this->registerSignal(signalName);
     _probes[slotName] = std::make_pair(name, signalName);
+    _actor->setupProbeSlot(slotName, name, signalName);
 }
 
 Pothos::Object Pothos::Block::opaqueCallHandler(const std::string &name, const Pothos::Object *inputArgs, const size_t numArgs)
 {
+    //the worker passes the name string of the slot table entry for slot calls,
+    //dispatch through the entry's precompiled overloads without the name lookup
+    const auto slot = _actor->currentSlot.load(std::memory_order_relaxed);
+    if (slot != nullptr and &name == &slot->callName) return slot->call(inputArgs, numArgs);
+
     //check if the name is a registered call
     const size_t numMatches = _calls.count(name);
 
@@ -206,6 +227,57 @@ Pothos::Object Pothos::Block::opaqueCallHandler(const std::string &name, const P
     throw Pothos::BlockCallNotFound("Pothos::Block::call("+name+")", "method match failed");
 }
 
+Pothos::Object Pothos::SlotDispatch::call(const Pothos::Object *inputArgs, const size_t numArgs)
+{
+    //no matches throw error
+    if (calls.empty()) throw Pothos::BlockCallNotFound("Pothos::Block::call("+callName+")", "method does not exist in registry");
+
+    //only one match, try the call and let it error out
+    if (calls.size() == 1) return calls.front().opaqueCall(inputArgs, numArgs);
+
+    //the cached overloads are invalid when the conversions change
+    const auto currentGeneration = Pothos::Detail::getConvertGeneration();
+    if (generation != currentGeneration)
+    {
+        overloads.clear();
+        generation = currentGeneration;
+    }
+
+    //lookup the overload selected for these argument types
+    for (const auto &overload : overloads)
+    {
+        const auto &types = overload.first;
+        if (types.size() != numArgs) continue;
+        for (size_t i = 0; i < numArgs; i++)
+        {
+            if (*types[i] != inputArgs[i].type()) goto nextCached;
+        }
+        return calls[overload.second].opaqueCall(inputArgs, numArgs);
+        nextCached: continue;
+    }
+
+    //otherwise try a match and cache the selection
+    for (size_t index = 0; index < calls.size(); index++)
+    {
+        const auto &call = calls[index];
+        if (call.getNumArgs() != numArgs) continue;
+        for (size_t i = 0; i < numArgs; i++)
+        {
+            if (not inputArgs[i].canConvert(call.type(i))) goto next;
+        }
+        {
+            std::vector<const std::type_info *> types(numArgs);
+            for (size_t i = 0; i < numArgs; i++) types[i] = &inputArgs[i].type();
+            overloads.emplace_back(std::move(types), index);
+        }
+        return call.opaqueCall(inputArgs, numArgs);
+        next: continue;
+    }
+
+    //could not find a match, error out
+    throw Pothos::BlockCallNotFound("Pothos::Block::call("+callName+")", "method match failed");
+}
+
 Pothos::Object Pothos::Block::opaqueCallMethod(const std::string &name, const Pothos::Object *inputArgs, const size_t numArgs) const
 {
     //call into a signal
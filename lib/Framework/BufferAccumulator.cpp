@@ -10,6 +10,57 @@
 #include <algorithm> //min/max
 #include <utility> //move
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POTHOS_STREAMING_COPY
+#endif
+
+/***********************************************************************
+ * Copy helper for require() amalgamation:
+ * Requirements of at least this many bytes are larger than the cache
+ * that the copy could occupy usefully, so the copy uses non-temporal
+ * stores which do not evict the working set of the consumer.
+ **********************************************************************/
+static const size_t streamingCopyThreshold = 1024*1024;
+
+static void accumulatorCopy(void *dst, const void *src, const size_t numBytes, const bool streaming)
+{
+    #ifdef POTHOS_STREAMING_COPY
+    if (streaming)
+    {
+        auto out = reinterpret_cast<char *>(dst);
+        auto in = reinterpret_cast<const char *>(src);
+
+        //copy the head until the destination is 16 byte aligned
+        const size_t head = std::min(numBytes, (16 - (size_t(out) & 15)) & 15);
+        std::memcpy(out, in, head);
+        out += head; in += head;
+        size_t remaining = numBytes - head;
+
+        //stream 64 bytes per iteration
+        for (; remaining >= 64; remaining -= 64, out += 64, in += 64)
+        {
+            const auto r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)+0);
+            const auto r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)+1);
+            const auto r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)+2);
+            const auto r3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)+3);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(out)+0, r0);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(out)+1, r1);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(out)+2, r2);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(out)+3, r3);
+        }
+
+        //copy the tail and order the streaming stores
+        std::memcpy(out, in, remaining);
+        _mm_sfence();
+        return;
+    }
+    #else
+    (void)streaming;
+    #endif
+    std::memcpy(dst, src, numBytes);
+}
+
 /***********************************************************************
  * BufferAccumulator implementation
  **********************************************************************/
@@ -187,6 +238,13 @@ void Pothos::BufferAccumulator::require(const size_t numBytes)
     if (_bytesAvailable < numBytes and queue.size() == 1 and
         numBytes <= queue.front().getBuffer().getLength()) return;
 
+    //Circular buffers accumulate into a contiguous front buffer as upstream buffers arrive.
+    //When the front holds every available byte, wait for more bytes rather than copying,
+    //even when empty buffers from an upstream amalgamation follow the front in the queue.
+    //Half the circular size can always be produced while the consumer holds the front.
+    if (_bytesAvailable < numBytes and queue.front().length == _bytesAvailable and
+        numBytes*2 <= queue.front().getBuffer().getAliasOffset()) return;
+
     //Actually this is ok: assert(not _inPoolBuffer);
     //The smaller pool buffer in front will be absorbed and popped.
 
@@ -195,6 +253,7 @@ void Pothos::BufferAccumulator::require(const size_t numBytes)
     newBuffer.dtype = queue.front().dtype;
     size_t newBuffBytes = newBuffer.length;
     newBuffer.length = 0;
+    const bool streaming = std::min(newBuffBytes, _bytesAvailable) >= streamingCopyThreshold;
 
     //copy from the queue into the new buffer
     while (not queue.empty())
@@ -202,9 +261,9 @@ void Pothos::BufferAccumulator::require(const size_t numBytes)
         //copy the front buffer into the new buffer
         auto &f = queue.front();
         const size_t copyBytes = std::min(newBuffBytes, f.length);
-        std::memcpy(
+        accumulatorCopy(
             (void *)(newBuffer.address + newBuffer.length),
-            (void *)(f.address), copyBytes);
+            (void *)(f.address), copyBytes, streaming);
         newBuffBytes -= copyBytes;
         newBuffer.length += copyBytes;
 
@@ -3,116 +3,187 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SIMD/SIMDConvert.hpp"
+#include "Framework/DTypeElementTypes.hpp"
 
 #include <Pothos/Framework/BufferChunk.hpp>
 #include <Pothos/Framework/Exception.hpp>
-#include <functional>
+#include <Pothos/Util/Templates.hpp>
 #include <complex>
 #include <cstdint>
-#include <map>
-#include <iostream>
+#include <type_traits>
 
 /***********************************************************************
- * templated conversions
+ * element type codes to primitive types
  **********************************************************************/
+template <size_t Index>
+struct ElemTypeOf
+{
+    typedef void Type;
+};
+
+#define ELEM_TYPE_OF(code, type) \
+    template <> struct ElemTypeOf<elementTypeIndex(code)> {typedef type Type;}; \
+    template <> struct ElemTypeOf<elementTypeIndex(Complex ## code)> {typedef std::complex<type> Type;};
+
+ELEM_TYPE_OF(Int8, int8_t)
+ELEM_TYPE_OF(UInt8, uint8_t)
+ELEM_TYPE_OF(Int16, int16_t)
+ELEM_TYPE_OF(UInt16, uint16_t)
+ELEM_TYPE_OF(Int32, int32_t)
+ELEM_TYPE_OF(UInt32, uint32_t)
+ELEM_TYPE_OF(Int64, int64_t)
+ELEM_TYPE_OF(UInt64, uint64_t)
+ELEM_TYPE_OF(Float32, float)
+ELEM_TYPE_OF(Float64, double)
+
+/***********************************************************************
+ * conversion entries for each pair of element types
+ **********************************************************************/
+typedef void (*ConvertComplexFcn)(const void *, void *, void *, size_t);
+typedef void (*MergeComplexFcn)(const void *, const void *, void *, size_t);
+typedef void (*ScaleConvertFcn)(const void *, void *, size_t, double, double, int);
+
+template <typename T>
+using IsReal = std::is_arithmetic<T>;
+
+template <typename T>
+using IsComplex = Pothos::Util::is_complex<T>;
+
+template <typename T>
+struct IsScaled: std::integral_constant<bool,
+    std::is_same<T, int8_t>::value || std::is_same<T, int16_t>::value ||
+    std::is_same<T, int32_t>::value || std::is_floating_point<T>::value> {};
+
+template <bool Cond>
+using EnableIf = typename std::enable_if<Cond>::type;
+
+template <typename InType, typename OutType, typename = void>
+struct ConvertEntry
+{
+    static constexpr Pothos::BufferChunk::ConvertFcn get(void) {return nullptr;}
+};
+
 template <typename InType, typename OutType>
-void rawConvertRealToComplex(const void *in, void *out, const size_t num)
+struct ConvertEntry<InType, OutType, EnableIf<IsReal<InType>::value && IsReal<OutType>::value>>
 {
-    auto inElems = reinterpret_cast<const InType *>(in);
-    auto outElems = reinterpret_cast<std::complex<OutType> *>(out);
-    for (size_t i = 0; i < num; i++) outElems[i] = std::complex<OutType>(OutType(inElems[i]));
-}
+    static constexpr Pothos::BufferChunk::ConvertFcn get(void) {return &simdConvertBuffer<InType, OutType>;}
+};
 
 template <typename InType, typename OutType>
-void rawConvertComponents(const void *in, void *outRe, void *outIm, size_t num)
+struct ConvertEntry<InType, OutType, EnableIf<IsReal<InType>::value && IsComplex<OutType>::value>>
 {
-    auto inElems = reinterpret_cast<const std::complex<InType> *>(in);
-    auto outElemsRe = reinterpret_cast<OutType *>(outRe);
-    auto outElemsIm = reinterpret_cast<OutType *>(outIm);
-    for (size_t i = 0; i < num; i++)
-    {
-        outElemsRe[i] = OutType(inElems[i].real());
-        outElemsIm[i] = OutType(inElems[i].imag());
-    }
-}
+    static constexpr Pothos::BufferChunk::ConvertFcn get(void) {return &simdConvertRealToComplex<InType, typename OutType::value_type>;}
+};
 
-/***********************************************************************
- * bound conversions
- **********************************************************************/
-static int dtypeIOToHash(const Pothos::DType &in, const Pothos::DType &out)
+template <typename InType, typename OutType>
+struct ConvertEntry<InType, OutType, EnableIf<IsComplex<InType>::value && IsComplex<OutType>::value>>
 {
-    return in.elemType() | (out.elemType() << 16); //safe assumption, elem type uses only first few bits
-}
+    static constexpr Pothos::BufferChunk::ConvertFcn get(void) {return &simdConvertBuffer<InType, OutType>;}
+};
 
-class BufferConvertImpl
+template <typename InType, typename OutType, typename = void>
+struct ConvertComplexEntry
 {
-public:
-    BufferConvertImpl(void)
-    {
-        this->registerConverters();
-    }
+    static constexpr ConvertComplexFcn get(void) {return nullptr;}
+};
 
-    std::map<int, std::function<void(const void *, void *, const size_t)>> convertMap;
-    std::map<int, std::function<void(const void *, void *, void *, const size_t)>> convertComplexMap;
+template <typename InType, typename OutType>
+struct ConvertComplexEntry<InType, OutType, EnableIf<IsComplex<InType>::value && IsReal<OutType>::value>>
+{
+    static constexpr ConvertComplexFcn get(void) {return &simdConvertComponents<typename InType::value_type, OutType>;}
+};
 
-private:
-    void registerConverters(void)
-    {
-        this->registerConverter<int8_t>();
-        this->registerConverter<uint8_t>();
-        this->registerConverter<int16_t>();
-        this->registerConverter<uint16_t>();
-        this->registerConverter<int32_t>();
-        this->registerConverter<uint32_t>();
-        this->registerConverter<int64_t>();
-        this->registerConverter<uint64_t>();
-        this->registerConverter<float>();
-        this->registerConverter<double>();
-    }
+template <typename InType, typename OutType, typename = void>
+struct MergeComplexEntry
+{
+    static constexpr MergeComplexFcn get(void) {return nullptr;}
+};
 
-    template <typename InType>
-    void registerConverter(void)
-    {
-        this->registerConverter<InType, int8_t>();
-        this->registerConverter<InType, uint8_t>();
-        this->registerConverter<InType, int16_t>();
-        this->registerConverter<InType, uint16_t>();
-        this->registerConverter<InType, int32_t>();
-        this->registerConverter<InType, uint32_t>();
-        this->registerConverter<InType, int64_t>();
-        this->registerConverter<InType, uint64_t>();
-        this->registerConverter<InType, float>();
-        this->registerConverter<InType, double>();
-    }
+template <typename InType, typename OutType>
+struct MergeComplexEntry<InType, OutType, EnableIf<IsReal<InType>::value && IsComplex<OutType>::value>>
+{
+    static constexpr MergeComplexFcn get(void) {return &simdConvertComponentsToComplex<InType, typename OutType::value_type>;}
+};
 
-    template <typename InType, typename OutType>
-    void registerConverter(void)
-    {
-        int h = 0;
+//complex buffers are scaled as interleaved components
+template <typename InType, typename OutType>
+static void scaleConvertComplex(const void *in, void *out, const size_t num, const double scale, const double offset, const int flags)
+{
+    simdScaleConvertBuffer<InType, OutType>(in, out, num*2, scale, offset, flags);
+}
 
-        h = dtypeIOToHash(Pothos::DType(typeid(InType)), Pothos::DType(typeid(OutType)));
-        convertMap[h] = std::bind(&simdConvertBuffer<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+template <typename InType, typename OutType, typename = void>
+struct ScaleConvertEntry
+{
+    static constexpr ScaleConvertFcn get(void) {return nullptr;}
+};
 
-        h = dtypeIOToHash(Pothos::DType(typeid(InType)), Pothos::DType(typeid(std::complex<OutType>)));
-        convertMap[h] = std::bind(&rawConvertRealToComplex<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+template <typename InType, typename OutType>
+struct ScaleConvertEntry<InType, OutType, EnableIf<IsScaled<InType>::value && IsScaled<OutType>::value>>
+{
+    static constexpr ScaleConvertFcn get(void) {return &simdScaleConvertBuffer<InType, OutType>;}
+};
+
+template <typename InType, typename OutType>
+struct ScaleConvertEntry<InType, OutType, EnableIf<IsComplex<InType>::value && IsComplex<OutType>::value &&
+    IsScaled<typename InType::value_type>::value && IsScaled<typename OutType::value_type>::value>>
+{
+    static constexpr ScaleConvertFcn get(void) {return &scaleConvertComplex<typename InType::value_type, typename OutType::value_type>;}
+};
 
-        h = dtypeIOToHash(Pothos::DType(typeid(std::complex<InType>)), Pothos::DType(typeid(std::complex<OutType>)));
-        convertMap[h] = std::bind(&simdConvertBuffer<std::complex<InType>, std::complex<OutType>>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+/***********************************************************************
+ * dense conversion tables generated at compile time
+ **********************************************************************/
+template <typename Fcn>
+struct ConverterTable
+{
+    struct Row
+    {
+        Fcn fcns[NumElementTypeIndexes];
+    };
+    Row rows[NumElementTypeIndexes];
 
-        h = dtypeIOToHash(Pothos::DType(typeid(std::complex<InType>)), Pothos::DType(typeid(OutType)));
-        convertComplexMap[h] = std::bind(&rawConvertComponents<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+    //! Get the conversion function or null when not supported
+    Fcn lookup(const Pothos::DType &in, const Pothos::DType &out) const
+    {
+        return rows[elementTypeIndex(in.elemType())].fcns[elementTypeIndex(out.elemType())];
     }
 };
 
-static BufferConvertImpl &getBufferConvertImpl(void)
+template <typename Fcn, template <typename, typename, typename> class Entry, size_t In, size_t... Outs>
+constexpr typename ConverterTable<Fcn>::Row makeConverterRow(Pothos::Util::index_sequence<Outs...>)
+{
+    return {{Entry<typename ElemTypeOf<In>::Type, typename ElemTypeOf<Outs>::Type, void>::get()...}};
+}
+
+template <typename Fcn, template <typename, typename, typename> class Entry, size_t... Ins>
+constexpr ConverterTable<Fcn> makeConverterTable(Pothos::Util::index_sequence<Ins...>)
 {
-    static BufferConvertImpl impl;
-    return impl;
+    return {{makeConverterRow<Fcn, Entry, Ins>(Pothos::Util::make_index_sequence<NumElementTypeIndexes>())...}};
 }
 
+template <typename Fcn, template <typename, typename, typename> class Entry>
+constexpr ConverterTable<Fcn> makeConverterTable(void)
+{
+    return makeConverterTable<Fcn, Entry>(Pothos::Util::make_index_sequence<NumElementTypeIndexes>());
+}
+
+static constexpr auto convertTable = makeConverterTable<Pothos::BufferChunk::ConvertFcn, ConvertEntry>();
+static constexpr auto convertComplexTable = makeConverterTable<ConvertComplexFcn, ConvertComplexEntry>();
+static constexpr auto mergeComplexTable = makeConverterTable<MergeComplexFcn, MergeComplexEntry>();
+static constexpr auto scaleConvertTable = makeConverterTable<ScaleConvertFcn, ScaleConvertEntry>();
+
 /***********************************************************************
  * conversion implementation
  **********************************************************************/
+Pothos::BufferChunk::ConvertFcn Pothos::BufferChunk::getConverter(const DType &inDType, const DType &outDType)
+{
+    const auto fcn = convertTable.lookup(inDType, outDType);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::getConverter("+inDType.toString()+", "+outDType.toString()+")", "conversion not supported");
+    return fcn;
+}
+
 Pothos::BufferChunk Pothos::BufferChunk::convert(const DType &outDType, const size_t numElems_) const
 {
     const size_t numElems = (numElems_ == 0)? this->elements() : numElems_;
@@ -132,12 +203,12 @@ Pothos::BufferChunk Pothos::BufferChunk::convert(const DType &outDType, const si
         return out;
     }
 
-    auto it = getBufferConvertImpl().convertMap.find(dtypeIOToHash(this->dtype, outDType));
-    if (it == getBufferConvertImpl().convertMap.end()) throw Pothos::BufferConvertError(
+    const auto fcn = convertTable.lookup(this->dtype, outDType);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convert("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
     Pothos::BufferChunk out(outDType, outElems);
 
-    it->second(this->as<const void *>(), out.as<void *>(), primElems);
+    fcn(this->as<const void *>(), out.as<void *>(), primElems);
     return out;
 }
 
@@ -147,13 +218,13 @@ std::pair<Pothos::BufferChunk, Pothos::BufferChunk> Pothos::BufferChunk::convert
     const auto primElems = (numElems*this->dtype.size())/this->dtype.elemSize();
     const auto outElems = primElems*outDType.size()/outDType.elemSize();
 
-    auto it = getBufferConvertImpl().convertComplexMap.find(dtypeIOToHash(this->dtype, outDType));
-    if (it == getBufferConvertImpl().convertComplexMap.end()) throw Pothos::BufferConvertError(
+    const auto fcn = convertComplexTable.lookup(this->dtype, outDType);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convertComplex("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
     Pothos::BufferChunk outRe(outDType, outElems);
     Pothos::BufferChunk outIm(outDType, outElems);
 
-    it->second(this->as<const void *>(), outRe.as<void *>(), outIm.as<void *>(), primElems);
+    fcn(this->as<const void *>(), outRe.as<void *>(), outIm.as<void *>(), primElems);
     return std::make_pair(outRe, outIm);
 }
 
@@ -166,11 +237,11 @@ size_t Pothos::BufferChunk::convert(const BufferChunk &out, const size_t numElem
     if (out.elements() < outElems) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convert(buffer)", "insufficient input buffer");
 
-    auto it = getBufferConvertImpl().convertMap.find(dtypeIOToHash(this->dtype, out.dtype));
-    if (it == getBufferConvertImpl().convertMap.end()) throw Pothos::BufferConvertError(
+    const auto fcn = convertTable.lookup(this->dtype, out.dtype);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convert("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
 
-    it->second(this->as<const void *>(), out.as<void *>(), primElems);
+    fcn(this->as<const void *>(), out.as<void *>(), primElems);
     return outElems;
 }
 
@@ -187,10 +258,83 @@ size_t Pothos::BufferChunk::convertComplex(const BufferChunk &outRe, const Buffe
     if (outIm.elements() < outElems) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convertComplex(bufferRe, bufferIm)", "insufficient input bufferIm");
 
-    auto it = getBufferConvertImpl().convertComplexMap.find(dtypeIOToHash(this->dtype, outRe.dtype));
-    if (it == getBufferConvertImpl().convertComplexMap.end()) throw Pothos::BufferConvertError(
+    const auto fcn = convertComplexTable.lookup(this->dtype, outRe.dtype);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
         "Pothos::BufferChunk::convertComplex("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
 
-    it->second(this->as<const void *>(), outRe.as<void *>(), outIm.as<void *>(), primElems);
+    fcn(this->as<const void *>(), outRe.as<void *>(), outIm.as<void *>(), primElems);
+    return outElems;
+}
+
+Pothos::BufferChunk Pothos::BufferChunk::convert(const DType &outDType, const double scale, const double offset, const int flags, const size_t numElems_) const
+{
+    const size_t numElems = (numElems_ == 0)? this->elements() : numElems_;
+    const auto primElems = (numElems*this->dtype.size())/this->dtype.elemSize();
+    const auto outElems = primElems*outDType.size()/outDType.elemSize();
+
+    const auto fcn = scaleConvertTable.lookup(this->dtype, outDType);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::convert("+dtype.toString()+", scale)", "can't convert from " + this->dtype.toString());
+    Pothos::BufferChunk out(outDType, outElems);
+
+    fcn(this->as<const void *>(), out.as<void *>(), primElems, scale, offset, flags);
+    return out;
+}
+
+size_t Pothos::BufferChunk::convert(const BufferChunk &out, const double scale, const double offset, const int flags, const size_t numElems_) const
+{
+    const size_t numElems = (numElems_ == 0)? this->elements() : numElems_;
+    const auto primElems = (numElems*this->dtype.size())/this->dtype.elemSize();
+    const auto outElems = primElems*out.dtype.size()/out.dtype.elemSize();
+
+    if (out.elements() < outElems) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::convert(buffer, scale)", "insufficient output buffer");
+
+    const auto fcn = scaleConvertTable.lookup(this->dtype, out.dtype);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::convert("+dtype.toString()+", scale)", "can't convert from " + this->dtype.toString());
+
+    fcn(this->as<const void *>(), out.as<void *>(), primElems, scale, offset, flags);
+    return outElems;
+}
+
+Pothos::BufferChunk Pothos::BufferChunk::mergeComplex(const BufferChunk &imBuff, const DType &outDType, const size_t numElems_) const
+{
+    const size_t numElems = (numElems_ == 0)? this->elements() : numElems_;
+    const auto primElems = (numElems*this->dtype.size())/this->dtype.elemSize();
+    const auto outElems = primElems/outDType.dimension();
+
+    if (not (this->dtype == imBuff.dtype)) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex(imBuff)", "buffer DType mismatch");
+    if (imBuff.elements() < numElems) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex(imBuff)", "insufficient input imBuff");
+
+    const auto fcn = mergeComplexTable.lookup(this->dtype, outDType);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
+    Pothos::BufferChunk out(outDType, outElems);
+
+    fcn(this->as<const void *>(), imBuff.as<const void *>(), out.as<void *>(), primElems);
+    return out;
+}
+
+size_t Pothos::BufferChunk::mergeComplex(const BufferChunk &imBuff, const BufferChunk &out, const size_t numElems_) const
+{
+    const size_t numElems = (numElems_ == 0)? this->elements() : numElems_;
+    const auto primElems = (numElems*this->dtype.size())/this->dtype.elemSize();
+    const auto outElems = primElems/out.dtype.dimension();
+
+    if (not (this->dtype == imBuff.dtype)) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex(imBuff, buffer)", "buffer DType mismatch");
+    if (imBuff.elements() < numElems) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex(imBuff, buffer)", "insufficient input imBuff");
+    if (out.elements() < outElems) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex(imBuff, buffer)", "insufficient output buffer");
+
+    const auto fcn = mergeComplexTable.lookup(this->dtype, out.dtype);
+    if (fcn == nullptr) throw Pothos::BufferConvertError(
+        "Pothos::BufferChunk::mergeComplex("+dtype.toString()+")", "can't convert from " + this->dtype.toString());
+
+    fcn(this->as<const void *>(), imBuff.as<const void *>(), out.as<void *>(), primElems);
     return outElems;
 }
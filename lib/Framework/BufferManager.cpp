@@ -11,7 +11,9 @@
 Pothos::BufferManagerArgs::BufferManagerArgs(void):
     numBuffers(4),
     bufferSize(8*1024),
-    nodeAffinity(-1)
+    nodeAffinity(-1),
+    hugePages(false),
+    filePath()
 {
     return;
 }
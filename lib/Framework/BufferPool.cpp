@@ -2,38 +2,66 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework/BufferPool.hpp>
+#include <algorithm> //remove_if
 
-//! The default size of allocations until the client requests larger buffers
+//! The size of the smallest size class of allocations
 static const size_t defaultSize = 8*1024;
 
+//! Unused buffers of a size class are freed after this many requests for other classes
+static const unsigned long long idleRequests = 64;
+
 Pothos::BufferPool::BufferPool(void):
-    _minBuffSize(defaultSize)
+    _numRequests(0)
 {
     return;
 }
 
 void Pothos::BufferPool::clear(void)
 {
-    _minBuffSize = defaultSize;
-    _buffs.clear();
+    _classes.clear();
+    _lastUsed.clear();
 }
 
 const Pothos::BufferChunk &Pothos::BufferPool::get(const size_t numBytes)
 {
-    //user asked for a larger buffer size -- drop all entries
-    if (numBytes > _minBuffSize)
+    _numRequests++;
+
+    //the smallest size class that holds the requested bytes
+    size_t index = 0;
+    while ((defaultSize << index) < numBytes) index++;
+    if (_classes.size() <= index)
+    {
+        _classes.resize(index+1);
+        _lastUsed.resize(index+1, _numRequests);
+    }
+
+    //free the unused buffers of size classes that went idle
+    for (size_t i = 0; i < _classes.size(); i++)
     {
-        _buffs.clear();
-        _minBuffSize = numBytes;
+        if (_lastUsed[i] + idleRequests >= _numRequests) continue;
+        auto &buffs = _classes[i];
+        buffs.erase(std::remove_if(buffs.begin(), buffs.end(),
+            [](const BufferChunk &buff){return buff.unique();}), buffs.end());
     }
 
-    //find the first buffer where we hold the only copy
-    for (size_t i = 0; i < _buffs.size(); i++)
+    //find the first buffer where we hold the only copy,
+    //larger classes are re-used rather than allocating,
+    //the length is trimmed to the request so that copies into
+    //the buffer do not cover the rest of a larger class
+    for (size_t i = index; i < _classes.size(); i++)
     {
-        if (_buffs[i].unique()) return _buffs[i];
+        for (auto &buff : _classes[i])
+        {
+            if (not buff.unique()) continue;
+            _lastUsed[i] = _numRequests;
+            buff.length = numBytes;
+            return buff;
+        }
     }
 
     //otherwise make a new buffer
-    _buffs.emplace_back(_minBuffSize);
-    return _buffs.back();
+    _lastUsed[index] = _numRequests;
+    _classes[index].emplace_back(defaultSize << index);
+    _classes[index].back().length = numBytes;
+    return _classes[index].back();
 }
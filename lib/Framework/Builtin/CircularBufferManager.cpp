@@ -12,7 +12,8 @@ static Pothos::SharedBuffer defaultCircularBufferAllocator(const Pothos::BufferM
 {
     return Pothos::SharedBuffer::makeCirc(
                args.bufferSize*args.numBuffers,
-               args.nodeAffinity);
+               args.nodeAffinity,
+               args.hugePages);
 }
 
 /***********************************************************************
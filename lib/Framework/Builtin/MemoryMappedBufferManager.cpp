@@ -0,0 +1,292 @@
+// Copyright (c) 2013-2016 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Framework/MemoryMappedBufferContainer.hpp"
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Util/RingDeque.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
+#include <Poco/File.h>
+#include <Poco/Logger.h>
+#include <algorithm>
+#include <cassert>
+
+static size_t alignUp(const size_t value, const size_t alignment)
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+/***********************************************************************
+ * memory mapped file reader implementation
+ *  - serves the contents of a file in order without copies
+ *  - writes into the buffers are private and never reach the file
+ *  - each managed buffer is assigned the next region when it's the front
+ *  - partially consumed regions remain in front until used up
+ **********************************************************************/
+class MemoryMappedReaderBufferManager :
+    public Pothos::BufferManager,
+    public std::enable_shared_from_this<MemoryMappedReaderBufferManager>
+{
+public:
+    MemoryMappedReaderBufferManager(void):
+        _bufferSize(0),
+        _window(0),
+        _readOffset(0),
+        _adviseOffset(0)
+    {
+        return;
+    }
+
+    void init(const Pothos::BufferManagerArgs &args)
+    {
+        Pothos::BufferManager::init(args);
+        if (args.filePath.empty()) throw Pothos::InvalidArgumentException("MemoryMappedReaderBufferManager::init()", "file path not specified");
+        _bufferSize = args.bufferSize;
+        _window = args.bufferSize*args.numBuffers;
+        _readyBuffs = Pothos::Util::RingDeque<Pothos::ManagedBuffer>(args.numBuffers);
+
+        //map the entire file, pages are faulted in by the read-ahead
+        //downstream blocks may write into the buffers with read-before-write,
+        //so the pages are copied on write rather than mapped read-only
+        _container = MemoryMappedBufferContainer::makeCopyOnWrite(args.filePath);
+        _file = Pothos::SharedBuffer(reinterpret_cast<size_t>(_container->buffer()), _container->length(), _container);
+        _container->advise(0, _container->length(), MemoryMappedBufferContainer::ADVISE_SEQUENTIAL);
+
+        //file regions are assigned to the tokens as they are used
+        std::vector<Pothos::ManagedBuffer> managedBuffers(args.numBuffers);
+        for (size_t i = 0; i < args.numBuffers; i++)
+        {
+            managedBuffers[i].reset(this->shared_from_this(), Pothos::SharedBuffer(), i/*slabIndex*/);
+            this->push(managedBuffers[i]);
+        }
+    }
+
+    bool empty(void) const
+    {
+        return _readyBuffs.empty() or _readOffset >= _file.getLength();
+    }
+
+    void pop(const size_t numBytes)
+    {
+        assert(not _readyBuffs.empty());
+        _readOffset += numBytes;
+
+        //continue with the rest of this region
+        auto buff = this->front();
+        buff.address += numBytes;
+        buff.length -= numBytes;
+        if (buff.length != 0)
+        {
+            this->setFrontBuffer(buff);
+            return;
+        }
+
+        _readyBuffs.pop_front();
+        this->assignFront();
+    }
+
+    void push(const Pothos::ManagedBuffer &buff)
+    {
+        //drop the pages of the consumed region from this mapping
+        const auto &region = buff.getBuffer();
+        if (region.getLength() != 0) _container->advise(
+            region.getAddress()-_file.getAddress(), region.getLength(),
+            MemoryMappedBufferContainer::ADVISE_DONTNEED);
+
+        _readyBuffs.push_back(buff);
+        if (_readyBuffs.size() == 1) this->assignFront();
+    }
+
+private:
+    void assignFront(void)
+    {
+        if (_readyBuffs.empty() or _readOffset >= _file.getLength())
+        {
+            this->setFrontBuffer(Pothos::BufferChunk::null());
+            return;
+        }
+
+        auto &token = _readyBuffs.front();
+        const size_t length = std::min(_bufferSize, _file.getLength()-_readOffset);
+        token.reset(this->shared_from_this(), Pothos::SharedBuffer(
+            _file.getAddress()+_readOffset, length, _file), token.getSlabIndex());
+        this->setFrontBuffer(token);
+
+        //keep a window of read-ahead in flight, re-advise every half window
+        if (_readOffset >= _adviseOffset)
+        {
+            _container->advise(_readOffset, _window, MemoryMappedBufferContainer::ADVISE_WILLNEED);
+            _adviseOffset = _readOffset + _window/2;
+        }
+    }
+
+    size_t _bufferSize;
+    size_t _window;
+    size_t _readOffset;
+    size_t _adviseOffset;
+    MemoryMappedBufferContainer::SPtr _container;
+    Pothos::SharedBuffer _file;
+    Pothos::Util::RingDeque<Pothos::ManagedBuffer> _readyBuffs;
+};
+
+/***********************************************************************
+ * memory mapped file writer implementation
+ *  - output buffers are allocated in a growing file
+ *  - the file is mapped in segments of at least the window size
+ *  - the file is truncated to the bytes popped upon destruction
+ **********************************************************************/
+class MemoryMappedWriterBufferManager :
+    public Pothos::BufferManager,
+    public std::enable_shared_from_this<MemoryMappedWriterBufferManager>
+{
+public:
+    MemoryMappedWriterBufferManager(void):
+        _bufferSize(0),
+        _segmentSize(0),
+        _writeOffset(0),
+        _bytesPopped(0),
+        _fileLength(0),
+        _segmentOffset(0)
+    {
+        return;
+    }
+
+    ~MemoryMappedWriterBufferManager(void)
+    {
+        if (_filePath.empty()) return;
+        try
+        {
+            Poco::File(_filePath).setSize(_writeOffset);
+        }
+        catch (const Poco::Exception &ex)
+        {
+            poco_error(Poco::Logger::get("MemoryMappedWriterBufferManager"), "truncate "+ex.displayText());
+        }
+    }
+
+    void init(const Pothos::BufferManagerArgs &args)
+    {
+        Pothos::BufferManager::init(args);
+        if (args.filePath.empty()) throw Pothos::InvalidArgumentException("MemoryMappedWriterBufferManager::init()", "file path not specified");
+        _bufferSize = args.bufferSize;
+        _readyBuffs = Pothos::Util::RingDeque<Pothos::ManagedBuffer>(args.numBuffers);
+
+        //growing the file in large segments keeps the number of mappings small
+        const size_t minSegmentSize = 16*1024*1024;
+        _segmentSize = alignUp(std::max(minSegmentSize, args.bufferSize*args.numBuffers), MemoryMappedBufferContainer::mapAlignment());
+
+        //start a new recording
+        Poco::File file(args.filePath);
+        file.createFile();
+        file.setSize(0);
+        _filePath = args.filePath;
+
+        std::vector<Pothos::ManagedBuffer> managedBuffers(args.numBuffers);
+        for (size_t i = 0; i < args.numBuffers; i++)
+        {
+            managedBuffers[i].reset(this->shared_from_this(), Pothos::SharedBuffer(), i/*slabIndex*/);
+            this->push(managedBuffers[i]);
+        }
+    }
+
+    bool empty(void) const
+    {
+        return _readyBuffs.empty();
+    }
+
+    void pop(const size_t numBytes)
+    {
+        assert(not _readyBuffs.empty());
+        _writeOffset += numBytes;
+        _bytesPopped += numBytes;
+
+        //re-use the buffer for small consumes
+        if (_bytesPopped*2 < _bufferSize)
+        {
+            auto buff = this->front();
+            buff.address += numBytes;
+            buff.length -= numBytes;
+            this->setFrontBuffer(buff);
+            return;
+        }
+
+        //the next buffer continues at the write offset,
+        //the unused end of this buffer is written over
+        _bytesPopped = 0;
+        _readyBuffs.pop_front();
+        this->assignFront();
+    }
+
+    void push(const Pothos::ManagedBuffer &buff)
+    {
+        _readyBuffs.push_back(buff);
+        if (_readyBuffs.size() == 1) this->assignFront();
+    }
+
+private:
+    void assignFront(void)
+    {
+        if (_readyBuffs.empty())
+        {
+            this->setFrontBuffer(Pothos::BufferChunk::null());
+            return;
+        }
+        if (_writeOffset + _bufferSize > _segmentOffset + _segment.getLength()) this->mapSegment();
+
+        auto &token = _readyBuffs.front();
+        token.reset(this->shared_from_this(), Pothos::SharedBuffer(
+            _segment.getAddress()+(_writeOffset-_segmentOffset), _bufferSize, _segment), token.getSlabIndex());
+        this->setFrontBuffer(token);
+    }
+
+    //! Grow the file and map the next segment at the write offset
+    void mapSegment(void)
+    {
+        const auto alignment = MemoryMappedBufferContainer::mapAlignment();
+        const size_t offset = _writeOffset - (_writeOffset % alignment);
+        const size_t length = alignUp(std::max(_segmentSize, _writeOffset + _bufferSize - offset), alignment);
+        if (offset + length > _fileLength)
+        {
+            _fileLength = offset + length;
+            Poco::File(_filePath).setSize(_fileLength);
+        }
+
+        auto container = MemoryMappedBufferContainer::make(_filePath, true, true, offset, length);
+        container->advise(0, length, MemoryMappedBufferContainer::ADVISE_SEQUENTIAL);
+        _segment = Pothos::SharedBuffer(reinterpret_cast<size_t>(container->buffer()), length, container);
+        _segmentOffset = offset;
+    }
+
+    std::string _filePath;
+    size_t _bufferSize;
+    size_t _segmentSize;
+    size_t _writeOffset;
+    size_t _bytesPopped;
+    size_t _fileLength;
+    size_t _segmentOffset;
+    Pothos::SharedBuffer _segment;
+    Pothos::Util::RingDeque<Pothos::ManagedBuffer> _readyBuffs;
+};
+
+/***********************************************************************
+ * factory and registration
+ **********************************************************************/
+Pothos::BufferManager::Sptr makeMemoryMappedReaderBufferManager(void)
+{
+    return std::make_shared<MemoryMappedReaderBufferManager>();
+}
+
+Pothos::BufferManager::Sptr makeMemoryMappedWriterBufferManager(void)
+{
+    return std::make_shared<MemoryMappedWriterBufferManager>();
+}
+
+pothos_static_block(pothosFrameworkRegisterMemoryMappedBufferManagers)
+{
+    Pothos::PluginRegistry::addCall(
+        "/framework/buffer_manager/mmap_reader",
+        &makeMemoryMappedReaderBufferManager);
+    Pothos::PluginRegistry::addCall(
+        "/framework/buffer_manager/mmap_writer",
+        &makeMemoryMappedWriterBufferManager);
+}
@@ -0,0 +1,442 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework.hpp>
+#include <Pothos/Framework/SharedBuffer.hpp>
+#include <Pothos/Object/Serialize.hpp>
+#include <Poco/TemporaryFile.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+/***********************************************************************
+ * Single producer, single consumer ring of records in shared memory.
+ * The sink block in one process writes records and
+ * the source block in another process on the same host reads them.
+ * Records are 8-byte aligned and never straddle the end of the ring,
+ * a wrap record marks the unused space at the end of the ring.
+ * Labels and messages larger than the record limit are split
+ * into fragment records that precede the final record.
+ **********************************************************************/
+enum SharedMemoryRecordType : uint32_t
+{
+    SHM_RECORD_WRAP = 0,
+    SHM_RECORD_BUFFER = 1,
+    SHM_RECORD_LABEL = 2,
+    SHM_RECORD_MESSAGE = 3,
+    SHM_RECORD_FRAGMENT = 4,
+};
+
+struct SharedMemoryRecord
+{
+    uint32_t type;
+    uint32_t length; //payload bytes following the record header
+};
+
+struct SharedMemoryRingHeader
+{
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> writeIndex;
+    alignas(64) std::atomic<uint64_t> readIndex;
+};
+
+static size_t alignRecord(const size_t length)
+{
+    return (length + 7) & ~size_t(7);
+}
+
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing(void):
+        _header(nullptr),
+        _data(nullptr),
+        _capacity(0)
+    {
+        return;
+    }
+
+    //! Map the ring file, the creator sizes the file before mapping
+    void open(const std::string &path, const bool create, const size_t capacity)
+    {
+        if (create)
+        {
+            Poco::File(path).setSize(_dataOffset + alignRecord(capacity));
+        }
+        _buffer = Pothos::SharedBuffer::makeFromFileMMap(path, true, true);
+        if (_buffer.getLength() <= _dataOffset)
+        {
+            throw Pothos::RuntimeException("SharedMemoryRing::open("+path+")", "file too small");
+        }
+        _header = reinterpret_cast<SharedMemoryRingHeader *>(_buffer.getAddress());
+        _data = reinterpret_cast<char *>(_buffer.getAddress() + _dataOffset);
+        if (create)
+        {
+            _header->capacity = _buffer.getLength() - _dataOffset;
+            _header->readIndex.store(0);
+            _header->writeIndex.store(0, std::memory_order_release);
+        }
+        _capacity = size_t(_header->capacity);
+    }
+
+    //! The largest record payload that this ring will accept
+    size_t maxPayload(void) const
+    {
+        return _capacity/4;
+    }
+
+    /*!
+     * Get space for a record of the given payload length.
+     * \return a pointer to the payload or null when the ring is full
+     */
+    char *writeFront(const uint32_t type, const size_t length)
+    {
+        const size_t total = alignRecord(sizeof(SharedMemoryRecord) + length);
+        uint64_t w = _header->writeIndex.load(std::memory_order_relaxed);
+        const uint64_t r = _header->readIndex.load(std::memory_order_acquire);
+        const size_t used = size_t(w - r);
+        const size_t offset = size_t(w % _capacity);
+        const size_t tail = _capacity - offset;
+
+        //mark the tail as unused when the record does not fit there
+        if (tail < total)
+        {
+            if (_capacity - used < tail + total) return nullptr;
+            auto wrap = reinterpret_cast<SharedMemoryRecord *>(_data + offset);
+            wrap->type = SHM_RECORD_WRAP;
+            wrap->length = 0;
+            w += tail;
+            _header->writeIndex.store(w, std::memory_order_release);
+        }
+        else if (_capacity - used < total) return nullptr;
+
+        auto record = reinterpret_cast<SharedMemoryRecord *>(_data + size_t(w % _capacity));
+        record->type = type;
+        record->length = uint32_t(length);
+        return reinterpret_cast<char *>(record + 1);
+    }
+
+    //! The number of free bytes in the ring
+    size_t writeAvailable(void) const
+    {
+        const auto w = _header->writeIndex.load(std::memory_order_relaxed);
+        const auto r = _header->readIndex.load(std::memory_order_acquire);
+        return _capacity - size_t(w - r);
+    }
+
+    //! Publish the record from the last writeFront()
+    void writePush(const size_t length)
+    {
+        const auto w = _header->writeIndex.load(std::memory_order_relaxed);
+        _header->writeIndex.store(w + alignRecord(sizeof(SharedMemoryRecord) + length), std::memory_order_release);
+    }
+
+    //! Get the next record or null when the ring is empty
+    const SharedMemoryRecord *readFront(void)
+    {
+        while (true)
+        {
+            const uint64_t r = _header->readIndex.load(std::memory_order_relaxed);
+            const uint64_t w = _header->writeIndex.load(std::memory_order_acquire);
+            if (r == w) return nullptr;
+            const size_t offset = size_t(r % _capacity);
+            auto record = reinterpret_cast<const SharedMemoryRecord *>(_data + offset);
+            if (record->type != SHM_RECORD_WRAP) return record;
+            _header->readIndex.store(r + (_capacity - offset), std::memory_order_release);
+        }
+    }
+
+    //! Release the record from the last readFront()
+    void readPop(const SharedMemoryRecord *record)
+    {
+        const auto r = _header->readIndex.load(std::memory_order_relaxed);
+        _header->readIndex.store(r + alignRecord(sizeof(SharedMemoryRecord) + record->length), std::memory_order_release);
+    }
+
+private:
+    static const size_t _dataOffset = 192;
+    Pothos::SharedBuffer _buffer;
+    SharedMemoryRingHeader *_header;
+    char *_data;
+    size_t _capacity;
+};
+
+static_assert(sizeof(SharedMemoryRingHeader) <= 192, "ring header overlaps the data");
+
+//! The sink and source blocks are from the same release,
+//! so the newest archive version is written to the ring
+static std::string serializeObject(const Pothos::Object &obj)
+{
+    std::ostringstream os;
+    Pothos::Archive::OStreamArchiver oa(os, POTHOS_ARCHIVE_VERSION);
+    oa << obj;
+    return os.str();
+}
+
+static Pothos::Object deserializeObject(const char *payload, const size_t length)
+{
+    std::istringstream is(std::string(payload, length));
+    Pothos::Object obj;
+    obj.deserialize(is);
+    return obj;
+}
+
+/***********************************************************************
+ * |PothosDoc Shared Memory Sink
+ *
+ * Forward a stream into a shared memory ring file
+ * for a Shared Memory Source in another process on the same host.
+ * Buffers, labels, and messages are copied into the ring.
+ * The topology uses this block instead of the network sink
+ * when both processes report the same node ID.
+ *
+ * |category /Network
+ *
+ * |param capacity[Capacity] The size of the ring in bytes.
+ * |default 8388608
+ *
+ * |factory /blocks/shared_memory_sink(capacity)
+ **********************************************************************/
+class SharedMemorySink : public Pothos::Block
+{
+public:
+    static Block *make(const size_t capacity)
+    {
+        return new SharedMemorySink(capacity);
+    }
+
+    SharedMemorySink(const size_t capacity):
+        _file(sharedMemoryDir()),
+        _pendingType(SHM_RECORD_MESSAGE),
+        _pendingOffset(0)
+    {
+        this->setupInput(0, "byte");
+        this->registerCall(this, POTHOS_FCN_TUPLE(SharedMemorySink, getPath));
+        _file.createFile();
+        _ring.open(_file.path(), true, capacity);
+    }
+
+    //! The ring file to map in the source block
+    std::string getPath(void) const
+    {
+        return _file.path();
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+
+        //finish the label or message that did not fit in the last call
+        bool blocked = not this->writePending();
+
+        //messages are not ordered with respect to the stream
+        while (not blocked and inPort->hasMessage())
+        {
+            this->setPending(SHM_RECORD_MESSAGE, serializeObject(inPort->popMessage()));
+            blocked = not this->writePending();
+        }
+
+        const auto &buffer = inPort->buffer();
+        if (not blocked and buffer.length != 0)
+        {
+            const auto elemSize = std::max<size_t>(1, buffer.dtype.size());
+            size_t length = std::min(buffer.length, _ring.maxPayload());
+            if (length > elemSize) length -= length % elemSize;
+
+            //labels precede their buffer record with an index relative to it
+            std::vector<Pothos::Label> labels;
+            for (const auto &label : inPort->labels())
+            {
+                if (label.index < length) labels.push_back(label);
+            }
+            for (const auto &label : labels)
+            {
+                if (blocked) break;
+                this->setPending(SHM_RECORD_LABEL, serializeObject(Pothos::Object(label)));
+                inPort->removeLabel(label);
+                blocked = not this->writePending();
+            }
+
+            if (not blocked) blocked = not this->writeBuffer(buffer, length);
+            if (not blocked) inPort->consume(length/inPort->dtype().size());
+        }
+
+        //the source cannot notify this process when it makes space,
+        //return the thread to the scheduler and poll again next call
+        if (blocked) this->yield();
+    }
+
+private:
+    static std::string sharedMemoryDir(void)
+    {
+        //a tmpfs mount keeps the ring in memory on linux
+        if (Poco::File("/dev/shm").exists()) return "/dev/shm";
+        return Poco::Path::temp();
+    }
+
+    bool writeRecord(const uint32_t type, const char *data, const size_t length)
+    {
+        auto payload = _ring.writeFront(type, length);
+        if (payload == nullptr) return false;
+        std::memcpy(payload, data, length);
+        _ring.writePush(length);
+        return true;
+    }
+
+    //! Take ownership of a serialized label or message to write
+    void setPending(const uint32_t type, std::string &&data)
+    {
+        _pendingType = type;
+        _pendingData = std::move(data);
+        _pendingOffset = 0;
+    }
+
+    /*!
+     * Write the pending label or message, split into fragments
+     * when it is larger than a record. The rest of a partial write
+     * is resumed in the next call, before any other record.
+     * \return true when nothing remains to be written
+     */
+    bool writePending(void)
+    {
+        if (_pendingData.empty()) return true;
+        const auto maxPayload = _ring.maxPayload();
+        while (_pendingData.size() - _pendingOffset > maxPayload)
+        {
+            if (not this->writeRecord(SHM_RECORD_FRAGMENT, _pendingData.data() + _pendingOffset, maxPayload)) return false;
+            _pendingOffset += maxPayload;
+        }
+        if (not this->writeRecord(_pendingType, _pendingData.data() + _pendingOffset, _pendingData.size() - _pendingOffset)) return false;
+        _pendingData.clear();
+        _pendingOffset = 0;
+        return true;
+    }
+
+    //! The buffer record holds the dtype markup followed by the 8-byte aligned data
+    bool writeBuffer(const Pothos::BufferChunk &buffer, const size_t length)
+    {
+        const auto markup = buffer.dtype.toMarkup();
+        const size_t dataOffset = alignRecord(sizeof(uint32_t) + markup.size());
+        auto payload = _ring.writeFront(SHM_RECORD_BUFFER, dataOffset + length);
+        if (payload == nullptr) return false;
+        const auto markupLength = uint32_t(markup.size());
+        std::memcpy(payload, &markupLength, sizeof(markupLength));
+        std::memcpy(payload + sizeof(markupLength), markup.data(), markup.size());
+        std::memcpy(payload + dataOffset, buffer.as<const void *>(), length);
+        _ring.writePush(dataOffset + length);
+        return true;
+    }
+
+    Poco::TemporaryFile _file;
+    SharedMemoryRing _ring;
+    uint32_t _pendingType;
+    std::string _pendingData;
+    size_t _pendingOffset;
+};
+
+static Pothos::BlockRegistry registerSharedMemorySink(
+    "/blocks/shared_memory_sink", &SharedMemorySink::make);
+
+/***********************************************************************
+ * |PothosDoc Shared Memory Source
+ *
+ * Produce a stream from the shared memory ring file
+ * of a Shared Memory Sink in another process on the same host.
+ *
+ * |category /Network
+ *
+ * |param path[Path] The ring file from the sink's getPath().
+ * |default ""
+ *
+ * |factory /blocks/shared_memory_source(path)
+ **********************************************************************/
+class SharedMemorySource : public Pothos::Block
+{
+public:
+    static Block *make(const std::string &path)
+    {
+        return new SharedMemorySource(path);
+    }
+
+    SharedMemorySource(const std::string &path)
+    {
+        this->setupOutput(0, "byte");
+        _ring.open(path, false, 0);
+    }
+
+    void work(void)
+    {
+        auto outPort = this->output(0);
+
+        //label indexes are relative to the bytes posted in this call
+        size_t postedBytes = 0;
+        const SharedMemoryRecord *record = nullptr;
+        while (postedBytes < _ring.maxPayload() and (record = _ring.readFront()) != nullptr)
+        {
+            const auto payload = reinterpret_cast<const char *>(record + 1);
+            if (record->type == SHM_RECORD_FRAGMENT)
+            {
+                _fragments.append(payload, record->length);
+            }
+            else if (record->type == SHM_RECORD_MESSAGE)
+            {
+                outPort->postMessage(this->deserializeRecord(payload, record->length));
+            }
+            else if (record->type == SHM_RECORD_LABEL)
+            {
+                auto label = this->deserializeRecord(payload, record->length).extract<Pothos::Label>();
+                label.index += postedBytes;
+                outPort->postLabel(std::move(label));
+            }
+            else if (record->type == SHM_RECORD_BUFFER)
+            {
+                uint32_t markupLength(0);
+                std::memcpy(&markupLength, payload, sizeof(markupLength));
+                const std::string markup(payload + sizeof(markupLength), markupLength);
+                if (markup != _lastMarkup)
+                {
+                    _lastDType = Pothos::DType(markup);
+                    _lastMarkup = markup;
+                }
+                const size_t dataOffset = alignRecord(sizeof(uint32_t) + markupLength);
+                const size_t length = record->length - dataOffset;
+                const auto elemSize = std::max<size_t>(1, _lastDType.size());
+                auto buffer = outPort->getBuffer(_lastDType, (length+elemSize-1)/elemSize);
+                buffer.dtype = _lastDType;
+                buffer.length = length;
+                std::memcpy(buffer.as<void *>(), payload + dataOffset, length);
+                outPort->postBuffer(std::move(buffer));
+                postedBytes += length;
+            }
+            _ring.readPop(record);
+        }
+
+        //the sink cannot notify this process when it writes records,
+        //return the thread to the scheduler and poll again next call
+        this->yield();
+    }
+
+private:
+    //! Deserialize a record payload, joined with the preceding fragments
+    Pothos::Object deserializeRecord(const char *payload, const size_t length)
+    {
+        if (_fragments.empty()) return deserializeObject(payload, length);
+        _fragments.append(payload, length);
+        auto obj = deserializeObject(_fragments.data(), _fragments.size());
+        _fragments.clear();
+        return obj;
+    }
+
+    SharedMemoryRing _ring;
+    std::string _lastMarkup;
+    Pothos::DType _lastDType;
+    std::string _fragments;
+};
+
+static Pothos::BlockRegistry registerSharedMemorySource(
+    "/blocks/shared_memory_source", &SharedMemorySource::make);
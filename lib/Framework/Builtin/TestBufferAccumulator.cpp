@@ -0,0 +1,131 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework/BufferAccumulator.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
+#include <Pothos/Framework/BufferPool.hpp>
+#include <vector>
+
+static Pothos::BufferChunk makeCountingChunk(const size_t start, const size_t numBytes)
+{
+    Pothos::BufferChunk chunk(numBytes);
+    auto p = chunk.as<unsigned char *>();
+    for (size_t i = 0; i < numBytes; i++) p[i] = (unsigned char)(start+i);
+    return chunk;
+}
+
+static bool checkCountingChunk(const Pothos::BufferChunk &chunk, const size_t start, const size_t numBytes)
+{
+    auto p = chunk.as<const unsigned char *>();
+    for (size_t i = 0; i < numBytes; i++)
+    {
+        if (p[i] != (unsigned char)(start+i)) return false;
+    }
+    return true;
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_pool)
+{
+    Pothos::BufferPool pool;
+
+    //small requests get the smallest size class
+    auto b0 = pool.get(100);
+    POTHOS_TEST_EQUAL(b0.length, 100);
+    POTHOS_TEST_EQUAL(b0.getBuffer().getLength(), 8*1024);
+
+    //held buffers are not handed out twice
+    auto b1 = pool.get(100);
+    POTHOS_TEST_NOT_EQUAL(b0.address, b1.address);
+
+    //larger requests round up to a power of two class
+    auto b2 = pool.get(20000);
+    POTHOS_TEST_EQUAL(b2.length, 20000);
+    POTHOS_TEST_EQUAL(b2.getBuffer().getLength(), 32*1024);
+    const auto b2Addr = b2.address;
+    b2 = Pothos::BufferChunk();
+
+    //unused buffers from larger classes are re-used,
+    //with the length trimmed to the request
+    auto b3 = pool.get(9000);
+    POTHOS_TEST_EQUAL(b3.address, b2Addr);
+    POTHOS_TEST_EQUAL(b3.length, 9000);
+
+    //and the smaller classes were not dropped
+    const auto b0Addr = b0.address;
+    b0 = Pothos::BufferChunk();
+    POTHOS_TEST_EQUAL(pool.get(100).address, b0Addr);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_pool_idle_classes)
+{
+    Pothos::BufferPool pool;
+
+    //a large request that is not repeated
+    const auto big = pool.get(1024*1024).getBuffer();
+    POTHOS_TEST_EQUAL(big.useCount(), 2);
+
+    //the unused buffer of the idle class is freed
+    for (size_t i = 0; i < 100; i++) pool.get(100);
+    POTHOS_TEST_EQUAL(big.useCount(), 1);
+
+    //buffers that are still held are kept
+    const auto held = pool.get(1024*1024);
+    for (size_t i = 0; i < 100; i++) pool.get(100);
+    POTHOS_TEST_EQUAL(held.getBuffer().useCount(), 2);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_accumulator_require)
+{
+    //small and streaming sized fragment patterns
+    for (const size_t fragSize : {size_t(1000), size_t(4096), size_t(700*1024)})
+    {
+        Pothos::BufferAccumulator acc;
+        size_t total = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            acc.push(makeCountingChunk(total, fragSize));
+            total += fragSize;
+        }
+        POTHOS_TEST_EQUAL(acc.getTotalBytesAvailable(), total);
+
+        //require across three fragments and check the contents
+        const size_t required = fragSize*2 + fragSize/2;
+        acc.require(required);
+        POTHOS_TEST_TRUE(acc.front().length >= required);
+        POTHOS_TEST_TRUE(checkCountingChunk(acc.front(), 0, required));
+
+        //consume past the amalgamated region and check the rest
+        acc.pop(required);
+        acc.require(total-required);
+        POTHOS_TEST_EQUAL(acc.front().length, total-required);
+        POTHOS_TEST_TRUE(checkCountingChunk(acc.front(), required, total-required));
+    }
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_accumulator_circular_require)
+{
+    //circular buffers accumulate into a contiguous front without copies
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 4;
+    args.bufferSize = 4096;
+    auto manager = Pothos::BufferManager::make("circular", args);
+
+    Pothos::BufferAccumulator acc;
+    auto buff = manager->front();
+    manager->pop(buff.length);
+    acc.push(Pothos::BufferChunk(buff));
+    const auto frontAddress = acc.front().address;
+
+    //the requirement is not met yet, the front is not copied
+    acc.require(2*args.bufferSize);
+    POTHOS_TEST_EQUAL(acc.front().address, frontAddress);
+
+    //the next buffer accumulates into the same front
+    buff = manager->front();
+    manager->pop(buff.length);
+    acc.push(Pothos::BufferChunk(buff));
+    acc.require(2*args.bufferSize);
+    POTHOS_TEST_EQUAL(acc.front().address, frontAddress);
+    POTHOS_TEST_EQUAL(acc.front().length, 2*args.bufferSize);
+}
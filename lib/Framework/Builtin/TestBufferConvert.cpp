@@ -11,6 +11,7 @@
 #include <random>
 #include <cstdint>
 #include <complex>
+#include <limits>
 #include <iostream>
 #include <type_traits>
 
@@ -173,6 +174,38 @@ void testBufferConvertComplexComponents(const size_t inVlen, const size_t outVle
     std::cout << "OK" << std::endl;
 }
 
+template <typename InType, typename OutType>
+void testBufferMergeComplexComponents(const size_t inVlen, const size_t outVlen)
+{
+    const size_t numElems = rng.next(1024);
+    Pothos::BufferChunk b0Re(Pothos::DType(typeid(InType), inVlen), numElems);
+    Pothos::BufferChunk b0Im(Pothos::DType(typeid(InType), inVlen), numElems);
+    const auto primElems = b0Re.length/b0Re.dtype.elemSize();
+
+    //random fill primitive elements
+    for (size_t i = 0; i < primElems; i++) randType<InType, OutType>(b0Re.as<InType *>()[i]);
+    for (size_t i = 0; i < primElems; i++) randType<InType, OutType>(b0Im.as<InType *>()[i]);
+
+    //convert
+    const auto b1 = b0Re.mergeComplex(b0Im, Pothos::DType(typeid(OutType), outVlen), numElems);
+
+    //check
+    std::cout << "testBufferMergeComplexComponents: " << b0Re.dtype.toString() << " to " << b1.dtype.toString() << "...\t" << std::flush;
+    for (size_t i = 0; i < primElems; i++)
+    {
+        const auto inRe = b0Re.as<const InType *>()[i];
+        const auto inIm = b0Im.as<const InType *>()[i];
+        const auto out = b1.as<const OutType *>()[i];
+        if (not checkEqual(inRe, out.real()) or not checkEqual(inIm, out.imag()))
+        {
+            std::cerr << "elem " << i << ": " << Pothos::Object(inRe).toString() << ", "
+                      << Pothos::Object(inIm).toString() << " != " << Pothos::Object(out).toString() << std::endl;
+            POTHOS_TEST_TRUE(checkEqual(inRe, out.real()) and checkEqual(inIm, out.imag()));
+        }
+    }
+    std::cout << "OK" << std::endl;
+}
+
 /***********************************************************************
  * templated test dispatch
  **********************************************************************/
@@ -198,6 +231,11 @@ void dispatchTests(void)
     testBufferConvertComplexComponents<std::complex<InType>, OutType>(1, 1);
     testBufferConvertComplexComponents<std::complex<InType>, OutType>(2, 1);
     testBufferConvertComplexComponents<std::complex<InType>, OutType>(1, 2);
+
+    //components to complex -- vary dtype
+    testBufferMergeComplexComponents<InType, std::complex<OutType>>(1, 1);
+    testBufferMergeComplexComponents<InType, std::complex<OutType>>(2, 1);
+    testBufferMergeComplexComponents<InType, std::complex<OutType>>(1, 2);
 }
 
 template <typename InType>
@@ -235,3 +273,91 @@ POTHOS_TEST_BLOCK("/framework/tests", test_buffer_convert)
     dispatchTestsForType<float>();
     dispatchTestsForType<double>();
 }
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_convert_scaled)
+{
+    //Q15 to float
+    Pothos::BufferChunk q15(Pothos::DType(typeid(std::int16_t)), 4);
+    const std::int16_t q15In[] = {-32768, -16384, 0, 16384};
+    for (size_t i = 0; i < 4; i++) q15.as<std::int16_t *>()[i] = q15In[i];
+    const auto f32 = q15.convert(Pothos::DType(typeid(float)), 1.0/(1 << 15), 0.0, Pothos::BufferChunk::CONVERT_TRUNCATE);
+    POTHOS_TEST_EQUAL(f32.elements(), 4);
+    const float f32Out[] = {-1.0f, -0.5f, 0.0f, 0.5f};
+    POTHOS_TEST_EQUALA(f32.as<const float *>(), f32Out, 4);
+
+    //float to Q15 with rounding and saturation, NaN saturates to zero
+    Pothos::BufferChunk flt(Pothos::DType(typeid(float)), 7);
+    const float fltIn[] = {-2.0f, -1.0f, 0.25f, 0.50002f, 0.99999f, 1.5f, std::numeric_limits<float>::quiet_NaN()};
+    for (size_t i = 0; i < 7; i++) flt.as<float *>()[i] = fltIn[i];
+    const auto i16 = flt.convert(Pothos::DType(typeid(std::int16_t)), (1 << 15), 0.0,
+        Pothos::BufferChunk::CONVERT_ROUND | Pothos::BufferChunk::CONVERT_SATURATE);
+    const std::int16_t i16Out[] = {-32768, -32768, 8192, 16385, 32767, 32767, 0};
+    POTHOS_TEST_EQUALA(i16.as<const std::int16_t *>(), i16Out, 7);
+
+    //NaN saturates to zero without rounding and in double precision
+    Pothos::BufferChunk nan64(Pothos::DType(typeid(double)), 2);
+    nan64.as<double *>()[0] = std::numeric_limits<double>::quiet_NaN();
+    nan64.as<double *>()[1] = 1e20;
+    const auto i32Sat = nan64.convert(Pothos::DType(typeid(std::int32_t)), 1.0, 0.0, Pothos::BufferChunk::CONVERT_SATURATE);
+    const std::int32_t i32SatOut[] = {0, std::numeric_limits<std::int32_t>::max()};
+    POTHOS_TEST_EQUALA(i32Sat.as<const std::int32_t *>(), i32SatOut, 2);
+
+    //truncation versus rounding with an offset
+    Pothos::BufferChunk dbl(Pothos::DType(typeid(double)), 3);
+    const double dblIn[] = {1.25, 1.75, -1.75};
+    for (size_t i = 0; i < 3; i++) dbl.as<double *>()[i] = dblIn[i];
+    Pothos::BufferChunk i32(Pothos::DType(typeid(std::int32_t)), 3);
+    POTHOS_TEST_EQUAL(dbl.convert(i32, 2.0, 0.25, Pothos::BufferChunk::CONVERT_TRUNCATE), 3);
+    const std::int32_t truncOut[] = {2, 3, -3};
+    POTHOS_TEST_EQUALA(i32.as<const std::int32_t *>(), truncOut, 3);
+    dbl.convert(i32, 2.0, 0.25, Pothos::BufferChunk::CONVERT_ROUND);
+    const std::int32_t roundOut[] = {3, 4, -3};
+    POTHOS_TEST_EQUALA(i32.as<const std::int32_t *>(), roundOut, 3);
+    dbl.convert(i32, 1.0, 0.0, Pothos::BufferChunk::CONVERT_ROUND);
+    const std::int32_t nearestOut[] = {1, 2, -2};
+    POTHOS_TEST_EQUALA(i32.as<const std::int32_t *>(), nearestOut, 3);
+
+    //complex applies the scale and offset to each component
+    Pothos::BufferChunk cs8(Pothos::DType(typeid(std::complex<std::int8_t>)), 2);
+    const std::int8_t cs8In[] = {64, -64, -128, 127};
+    for (size_t i = 0; i < 4; i++) cs8.as<std::int8_t *>()[i] = cs8In[i];
+    const auto cf64 = cs8.convert(Pothos::DType(typeid(std::complex<double>)), 1.0/128, 1.0, Pothos::BufferChunk::CONVERT_TRUNCATE);
+    POTHOS_TEST_EQUAL(cf64.elements(), 2);
+    const double cf64Out[] = {1.5, 0.5, 0.0, 1.0 + 127.0/128};
+    POTHOS_TEST_EQUALA(cf64.as<const double *>(), cf64Out, 4);
+
+    //unsupported types throw
+    POTHOS_TEST_THROWS(q15.convert(Pothos::DType(typeid(std::uint64_t)), 1.0, 0.0, 0), Pothos::BufferConvertError);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_get_converter)
+{
+    //resolve once and convert multiple buffers
+    const auto fcn = Pothos::BufferChunk::getConverter(
+        Pothos::DType(typeid(std::int16_t)), Pothos::DType(typeid(std::complex<float>)));
+    for (size_t numElems : {size_t(1), size_t(100), size_t(1000)})
+    {
+        Pothos::BufferChunk in(Pothos::DType(typeid(std::int16_t)), numElems);
+        Pothos::BufferChunk out(Pothos::DType(typeid(std::complex<float>)), numElems);
+        for (size_t i = 0; i < numElems; i++) in.as<std::int16_t *>()[i] = std::int16_t(i);
+        fcn(in.as<const void *>(), out.as<void *>(), numElems);
+        for (size_t i = 0; i < numElems; i++)
+        {
+            POTHOS_TEST_EQUAL(out.as<const std::complex<float> *>()[i], std::complex<float>(float(i), 0.0f));
+        }
+    }
+
+    //the same converter is used by convert()
+    Pothos::BufferChunk in(Pothos::DType(typeid(double)), 10);
+    for (size_t i = 0; i < 10; i++) in.as<double *>()[i] = double(i);
+    const auto viaConvert = in.convert(Pothos::DType(typeid(std::int32_t)));
+    Pothos::BufferChunk viaFcn(Pothos::DType(typeid(std::int32_t)), 10);
+    Pothos::BufferChunk::getConverter(in.dtype, viaFcn.dtype)(in.as<const void *>(), viaFcn.as<void *>(), 10);
+    POTHOS_TEST_EQUALA(viaConvert.as<const std::int32_t *>(), viaFcn.as<const std::int32_t *>(), 10);
+
+    //complex to real and custom types are not supported
+    POTHOS_TEST_THROWS(Pothos::BufferChunk::getConverter(
+        Pothos::DType(typeid(std::complex<float>)), Pothos::DType(typeid(float))), Pothos::BufferConvertError);
+    POTHOS_TEST_THROWS(Pothos::BufferChunk::getConverter(
+        Pothos::DType("custom"), Pothos::DType(typeid(float))), Pothos::BufferConvertError);
+}
@@ -0,0 +1,190 @@
+// Copyright (c) 2013-2014 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Poco/TemporaryFile.h>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+POTHOS_TEST_BLOCK("/framework/tests", test_mmap_reader_buffer_manager)
+{
+    //a file that ends in the middle of a buffer
+    std::vector<char> contents(3*4096+100);
+    for (size_t i = 0; i < contents.size(); i++) contents[i] = char(i*7);
+    Poco::TemporaryFile tempFile;
+    {
+        std::ofstream ofile(tempFile.path(), std::ios::binary);
+        ofile.write(contents.data(), contents.size());
+    }
+
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 2;
+    args.bufferSize = 4096;
+    args.filePath = tempFile.path();
+    auto manager = Pothos::BufferManager::make("mmap_reader", args);
+
+    //partial pops continue in the same region without copies
+    size_t offset = 0;
+    std::vector<Pothos::BufferChunk> buffs;
+    while (not manager->empty())
+    {
+        auto buff = manager->front();
+        buff.length = std::min<size_t>(buff.length, 1000);
+        POTHOS_TEST_EQUALA(buff.as<const char *>(), contents.data()+offset, buff.length);
+        if (not buffs.empty() and buffs.back().getManagedBuffer() == buff.getManagedBuffer())
+        {
+            POTHOS_TEST_EQUAL(buffs.back().getEnd(), buff.address);
+        }
+        manager->pop(buff.length);
+        offset += buff.length;
+        buffs.push_back(buff);
+
+        //return the buffers once all of the tokens are held
+        if (manager->empty() and offset != contents.size()) buffs.clear();
+    }
+    POTHOS_TEST_EQUAL(offset, contents.size());
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_mmap_writer_buffer_manager)
+{
+    Poco::TemporaryFile tempFile;
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 2;
+    args.bufferSize = 4096;
+    args.filePath = tempFile.path();
+    auto manager = Pothos::BufferManager::make("mmap_writer", args);
+
+    //record uneven writes across the buffers
+    const size_t total = 20000;
+    size_t offset = 0;
+    std::vector<Pothos::BufferChunk> buffs;
+    while (offset != total)
+    {
+        if (manager->empty()) buffs.clear();
+        auto buff = manager->front();
+        buff.length = std::min<size_t>(std::min<size_t>(buff.length, 3000), total-offset);
+        auto p = buff.as<char *>();
+        for (size_t i = 0; i < buff.length; i++) p[i] = char((offset+i)*7);
+        manager->pop(buff.length);
+        offset += buff.length;
+        buffs.push_back(buff);
+    }
+
+    //the file is truncated to the recording when the manager is deleted
+    buffs.clear();
+    manager.reset();
+    POTHOS_TEST_EQUAL(tempFile.getSize(), total);
+    std::vector<char> contents(total), expected(total);
+    for (size_t i = 0; i < total; i++) expected[i] = char(i*7);
+    std::ifstream ifile(tempFile.path(), std::ios::binary);
+    ifile.read(contents.data(), contents.size());
+    POTHOS_TEST_EQUALA(contents.data(), expected.data(), total);
+}
+
+struct MmapFileSource : Pothos::Block
+{
+    MmapFileSource(const std::string &filePath):
+        _filePath(filePath)
+    {
+        this->setupOutput(0, "uint8");
+    }
+
+    void work(void)
+    {
+        //the buffer already holds the file contents
+        auto out0 = this->output(0);
+        out0->produce(out0->elements());
+    }
+
+    std::shared_ptr<Pothos::BufferManager> getOutputBufferManager(const std::string &, const std::string &)
+    {
+        Pothos::BufferManagerArgs args;
+        args.numBuffers = 4;
+        args.bufferSize = 4096;
+        args.filePath = _filePath;
+        return Pothos::BufferManager::make("mmap_reader", args);
+    }
+
+    const std::string _filePath;
+};
+
+struct InvertInPlace : Pothos::Block
+{
+    InvertInPlace(void):
+        numInPlace(0)
+    {
+        this->setupInput(0, "uint8");
+        this->setupOutput(0, "uint8");
+        this->output(0)->setReadBeforeWrite(this->input(0));
+    }
+
+    void work(void)
+    {
+        const size_t n = this->workInfo().minElements;
+        if (n == 0) return;
+        const auto in = this->input(0)->buffer().as<const char *>();
+        const auto out = this->output(0)->buffer().as<char *>();
+        if (in == out) numInPlace++;
+        for (size_t i = 0; i < n; i++) out[i] = ~in[i];
+        this->input(0)->consume(n);
+        this->output(0)->produce(n);
+    }
+
+    size_t numInPlace;
+};
+
+struct ByteCollector : Pothos::Block
+{
+    ByteCollector(void)
+    {
+        this->setupInput(0, "uint8");
+    }
+
+    void work(void)
+    {
+        auto in0 = this->input(0);
+        const auto in = in0->buffer().as<const char *>();
+        bytes.insert(bytes.end(), in, in+in0->elements());
+        in0->consume(in0->elements());
+    }
+
+    std::vector<char> bytes;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_mmap_reader_read_before_write)
+{
+    std::vector<char> contents(64*4096+100);
+    for (size_t i = 0; i < contents.size(); i++) contents[i] = char(i*7);
+    Poco::TemporaryFile tempFile;
+    {
+        std::ofstream ofile(tempFile.path(), std::ios::binary);
+        ofile.write(contents.data(), contents.size());
+    }
+
+    //the downstream block writes into the mapped buffers in place
+    auto source = std::make_shared<MmapFileSource>(tempFile.path());
+    auto invert = std::make_shared<InvertInPlace>();
+    auto collector = std::make_shared<ByteCollector>();
+    {
+        Pothos::Topology topology;
+        topology.connect(source, 0, invert, 0);
+        topology.connect(invert, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+    POTHOS_TEST_TRUE(invert->numInPlace != 0);
+
+    std::vector<char> expected(contents.size());
+    for (size_t i = 0; i < contents.size(); i++) expected[i] = ~contents[i];
+    POTHOS_TEST_EQUAL(collector->bytes.size(), expected.size());
+    POTHOS_TEST_EQUALA(collector->bytes.data(), expected.data(), expected.size());
+
+    //the file is not modified by the writes
+    std::vector<char> fileContents(contents.size());
+    std::ifstream ifile(tempFile.path(), std::ios::binary);
+    ifile.read(fileContents.data(), fileContents.size());
+    POTHOS_TEST_EQUALA(fileContents.data(), contents.data(), contents.size());
+}
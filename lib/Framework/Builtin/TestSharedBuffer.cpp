@@ -67,6 +67,23 @@ POTHOS_TEST_BLOCK("/framework/tests", test_circular_shared_buffer)
     }
 }
 
+POTHOS_TEST_BLOCK("/framework/tests", test_circular_shared_buffer_huge_pages)
+{
+    //huge pages fall-back to regular pages when unavailable
+    auto b0 = Pothos::SharedBuffer::makeCirc(1024, 0/*node*/, true/*huge*/);
+    POTHOS_TEST_NOT_EQUAL(b0.getAddress(), 0);
+    POTHOS_TEST_GE(b0.getLength(), 1024);
+
+    const size_t alias = b0.getLength()/sizeof(int);
+    int *p = reinterpret_cast<int *>(b0.getAddress());
+    for (size_t i = 0; i < alias; i += 1024)
+    {
+        const int randNum = std::rand();
+        p[i] = randNum;
+        POTHOS_TEST_EQUAL(p[i+alias], randNum);
+    }
+}
+
 POTHOS_TEST_BLOCK("/framework/tests", test_mmap_shared_buffer)
 {
     static constexpr size_t numElems = 1024;
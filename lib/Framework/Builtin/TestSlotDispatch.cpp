@@ -0,0 +1,131 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <string>
+#include <vector>
+
+struct SlotEmitter : Pothos::Block
+{
+    SlotEmitter(void)
+    {
+        this->registerSignal("values");
+        this->registerSignal("probe");
+    }
+
+    void activate(void)
+    {
+        this->emitSignal("values", int(1));
+        this->emitSignal("values", std::string("two"));
+        this->emitSignal("values", int(3));
+        this->emitSignal("values", short(4)); //converted for the int overload
+        this->emitSignal("probe", int(21));
+    }
+};
+
+struct SlotReceiver : Pothos::Block
+{
+    SlotReceiver(void)
+    {
+        this->registerCall(this, "setValue", &SlotReceiver::setInt);
+        this->registerCall(this, "setValue", &SlotReceiver::setString);
+        this->registerCall(this, POTHOS_FCN_TUPLE(SlotReceiver, doubleValue));
+        this->registerProbe("doubleValue");
+    }
+
+    void setInt(const int value)
+    {
+        ints.push_back(value);
+    }
+
+    void setString(const std::string &value)
+    {
+        strings.push_back(value);
+    }
+
+    int doubleValue(const int value)
+    {
+        return value*2;
+    }
+
+    std::vector<int> ints;
+    std::vector<std::string> strings;
+};
+
+struct SlotReceiverOverride : SlotReceiver
+{
+    SlotReceiverOverride(void):
+        numSetValue(0)
+    {
+        return;
+    }
+
+    Pothos::Object opaqueCallHandler(const std::string &name, const Pothos::Object *inputArgs, const size_t numArgs)
+    {
+        if (name == "setValue") numSetValue++;
+        return Pothos::Block::opaqueCallHandler(name, inputArgs, numArgs);
+    }
+
+    size_t numSetValue;
+};
+
+struct ProbeCollector : Pothos::Block
+{
+    ProbeCollector(void)
+    {
+        this->registerCall(this, POTHOS_FCN_TUPLE(ProbeCollector, handleValue));
+    }
+
+    void handleValue(const int value)
+    {
+        values.push_back(value);
+    }
+
+    std::vector<int> values;
+};
+
+static void checkSlotReceiver(const SlotReceiver &receiver, const ProbeCollector &collector)
+{
+    POTHOS_TEST_EQUALV(receiver.ints, std::vector<int>({1, 3, 4}));
+    POTHOS_TEST_EQUAL(receiver.strings.size(), 1);
+    POTHOS_TEST_EQUAL(receiver.strings.front(), "two");
+    POTHOS_TEST_EQUALV(collector.values, std::vector<int>({42}));
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_slot_dispatch)
+{
+    auto emitter = std::shared_ptr<SlotEmitter>(new SlotEmitter());
+    auto receiver = std::shared_ptr<SlotReceiver>(new SlotReceiver());
+    auto collector = std::shared_ptr<ProbeCollector>(new ProbeCollector());
+
+    //overloaded slot, probe slot, and the triggered signal into a slot
+    Pothos::Topology topology;
+    topology.connect(emitter, "values", receiver, "setValue");
+    topology.connect(emitter, "probe", receiver, "probeDoubleValue");
+    topology.connect(receiver, "doubleValueTriggered", collector, "handleValue");
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    checkSlotReceiver(*receiver, *collector);
+
+    //calls made outside of the worker still lookup by name
+    receiver->call("setValue", int(5));
+    POTHOS_TEST_EQUAL(receiver->ints.back(), 5);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_slot_dispatch_override)
+{
+    auto emitter = std::shared_ptr<SlotEmitter>(new SlotEmitter());
+    auto receiver = std::shared_ptr<SlotReceiverOverride>(new SlotReceiverOverride());
+    auto collector = std::shared_ptr<ProbeCollector>(new ProbeCollector());
+
+    //slot calls go through the overridden handler
+    Pothos::Topology topology;
+    topology.connect(emitter, "values", receiver, "setValue");
+    topology.connect(emitter, "probe", receiver, "probeDoubleValue");
+    topology.connect(receiver, "doubleValueTriggered", collector, "handleValue");
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    checkSlotReceiver(*receiver, *collector);
+    POTHOS_TEST_EQUAL(receiver->numSetValue, 4);
+}
@@ -24,6 +24,19 @@ POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool)
     Pothos::ThreadPoolArgs args4;
     args4.priority = -1e6;
     POTHOS_TEST_THROWS(Pothos::ThreadPool tp4(args4), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args5(2/*threads*/);
+    args5.yieldMode = "STEAL";
+    Pothos::ThreadPool tp5(args5);
+    POTHOS_TEST_TRUE(tp5);
+
+    Pothos::ThreadPoolArgs args6;
+    args6.burstIterations = 0;
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp6(args6), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args7;
+    args7.burstTime = -1.0;
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp7(args7), Pothos::ThreadPoolError);
 }
 
 POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool_args)
@@ -35,4 +48,18 @@ POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool_args)
     POTHOS_TEST_EQUAL(args.priority, 0.0);
     POTHOS_TEST_EQUAL(args.affinityMode, "");
     POTHOS_TEST_EQUAL(args.yieldMode, "");
+    POTHOS_TEST_EQUAL(args.burstIterations, 1);
+    POTHOS_TEST_EQUAL(args.burstTime, 0.0);
+    POTHOS_TEST_TRUE(not args.adaptiveBuffers);
+    POTHOS_TEST_TRUE(not args.circularFanout);
+
+    Pothos::ThreadPoolArgs burstArgs("{\"burstIterations\":16, \"burstTime\":0.001}");
+    POTHOS_TEST_EQUAL(burstArgs.burstIterations, 16);
+    POTHOS_TEST_EQUAL(burstArgs.burstTime, 0.001);
+
+    Pothos::ThreadPoolArgs adaptiveArgs("{\"adaptiveBuffers\":true}");
+    POTHOS_TEST_TRUE(adaptiveArgs.adaptiveBuffers);
+
+    Pothos::ThreadPoolArgs circularArgs("{\"circularFanout\":true}");
+    POTHOS_TEST_TRUE(circularArgs.circularFanout);
 }
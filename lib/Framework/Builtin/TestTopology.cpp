@@ -4,6 +4,10 @@
 
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
+#include <Pothos/Remote.hpp>
+#include <Pothos/System/HostInfo.hpp>
+#include <Pothos/Util/Network.hpp>
+#include <algorithm>
 #include <iostream>
 #include <json.hpp>
 
@@ -130,6 +134,73 @@ POTHOS_TEST_BLOCK("/framework/tests/topology", test_unused_ports)
     POTHOS_TEST_EQUAL(pong->triggered, 1);
 }
 
+/***********************************************************************
+ * Test operation with a work stealing thread pool
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_steal_thread_pool)
+{
+    Pothos::ThreadPoolArgs args(2/*threads*/);
+    args.yieldMode = "STEAL";
+    Pothos::ThreadPool threadPool(args);
+
+    //create blocks
+    auto ping = std::shared_ptr<Ping>(new Ping());
+    auto passer = std::shared_ptr<Passer>(new Passer());
+    auto pong = std::shared_ptr<Pong>(new Pong());
+    ping->setThreadPool(threadPool);
+    passer->setThreadPool(threadPool);
+    pong->setThreadPool(threadPool);
+
+    //connect all the blocks
+    Pothos::Topology topology;
+    topology.connect(ping, "out0", passer, "in0");
+    topology.connect(passer, "out0", pong, "in0");
+    topology.commit();
+
+    //check that the message flowed
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    POTHOS_TEST_EQUAL(pong->triggered, 1);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_auto_placement)
+{
+    Pothos::ThreadPoolArgs args(1/*threads*/);
+    args.affinityMode = "AUTO";
+    Pothos::ThreadPool threadPool(args);
+
+    //create blocks
+    auto ping = std::shared_ptr<Ping>(new Ping());
+    auto passer = std::shared_ptr<Passer>(new Passer());
+    auto pong = std::shared_ptr<Pong>(new Pong());
+
+    //connect all the blocks
+    Pothos::Topology topology;
+    topology.setThreadPool(threadPool);
+    topology.connect(ping, "out0", passer, "in0");
+    topology.connect(passer, "out0", pong, "in0");
+    topology.commit();
+
+    //check that the message flowed
+    POTHOS_TEST_TRUE(topology.waitInactive());
+    POTHOS_TEST_EQUAL(pong->triggered, 1);
+
+    //the blocks were placed onto per-node pools
+    POTHOS_TEST_TRUE(ping->getThreadPool() != threadPool);
+    POTHOS_TEST_TRUE(passer->getThreadPool() != threadPool);
+    POTHOS_TEST_TRUE(pong->getThreadPool() != threadPool);
+
+    //the placement is reported with the make() markup
+    const auto topObj = json::parse(topology.dumpJSON());
+    POTHOS_TEST_TRUE(topObj.count("threadPools") != 0);
+    const auto &threadPoolsObj = topObj["threadPools"];
+    for (const auto &block : {ping->uid(), passer->uid(), pong->uid()})
+    {
+        const std::string poolName = topObj["blocks"][block]["threadPool"];
+        POTHOS_TEST_TRUE(threadPoolsObj.count(poolName) != 0);
+        POTHOS_TEST_EQUAL(threadPoolsObj[poolName]["numThreads"].get<size_t>(), 1);
+    }
+}
+
 /***********************************************************************
  * Test a simple pass-through topology
  **********************************************************************/
@@ -589,3 +660,193 @@ POTHOS_TEST_BLOCK("/framework/tests/topology", test_independent_passthrough)
         POTHOS_TEST_TRUE(connectionsHave(connsArray, pingInner->uid(), "out0", pongInner->uid(), "in0"));
     }
 }
+
+/***********************************************************************
+ * Test a stream through the same host shared memory blocks
+ **********************************************************************/
+struct CountingFeeder : Pothos::Block
+{
+    CountingFeeder(const int total):
+        total(total),
+        count(0),
+        numLabels(0)
+    {
+        this->setupOutput(0, "int32");
+    }
+
+    void work(void)
+    {
+        if (count == total) return;
+        auto out0 = this->output(0);
+        if (count == 0) out0->postMessage(std::string("hello"));
+        const int n = std::min<int>(total-count, int(out0->elements()));
+        int *p = out0->buffer();
+        for (int i = 0; i < n; i++) p[i] = count+i;
+        out0->postLabel("start", count, 0);
+        numLabels++;
+        count += n;
+        out0->produce(n);
+    }
+
+    const int total;
+    int count;
+    size_t numLabels;
+};
+
+struct CountingChecker : Pothos::Block
+{
+    CountingChecker(void):
+        count(0),
+        numLabels(0),
+        numMessages(0),
+        ok(true)
+    {
+        this->setupInput(0, "int32");
+    }
+
+    void work(void)
+    {
+        auto in0 = this->input(0);
+        if (in0->hasMessage())
+        {
+            in0->popMessage();
+            numMessages++;
+        }
+        const int *p = in0->buffer();
+        const size_t n = in0->elements();
+        for (const auto &label : in0->labels())
+        {
+            if (label.index >= n) continue;
+            ok = ok and p[label.index] == label.data.convert<int>();
+            numLabels++;
+        }
+        for (size_t i = 0; i < n; i++) ok = ok and p[i] == count++;
+        in0->consume(n);
+    }
+
+    int count;
+    size_t numLabels;
+    size_t numMessages;
+    bool ok;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_shared_memory_flow)
+{
+    //a small ring wraps many times over the stream
+    auto feeder = std::shared_ptr<CountingFeeder>(new CountingFeeder(1000000));
+    auto checker = std::shared_ptr<CountingChecker>(new CountingChecker());
+    auto shmSink = Pothos::BlockRegistry::make("/shared_memory_sink", size_t(64*1024));
+    auto shmSource = Pothos::BlockRegistry::make("/shared_memory_source", shmSink.call<std::string>("getPath"));
+
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, shmSink, 0);
+    topology.connect(shmSource, 0, checker, 0);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+
+    POTHOS_TEST_EQUAL(checker->count, feeder->total);
+    POTHOS_TEST_EQUAL(checker->numLabels, feeder->numLabels);
+    POTHOS_TEST_EQUAL(checker->numMessages, 1);
+    POTHOS_TEST_TRUE(checker->ok);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_shared_memory_network_flow)
+{
+    //a server process on this host reports the same node ID
+    Pothos::RemoteServer server("tcp://"+Pothos::Util::getWildcardAddr());
+    Pothos::RemoteClient client("tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort()));
+    auto env = client.makeEnvironment("managed");
+    POTHOS_TEST_EQUAL(env->getNodeId(), Pothos::System::HostInfo::get().nodeId);
+
+    //a stream into a block of the server process crosses through shared memory
+    auto feeder = std::shared_ptr<CountingFeeder>(new CountingFeeder(1000));
+    auto remoteSink = env->findProxy("Pothos/BlockRegistry").call("/blocks/shared_memory_sink", size_t(64*1024));
+    Pothos::Topology topology;
+    topology.setSharedMemoryCapacity(1024*1024);
+    POTHOS_TEST_EQUAL(topology.getSharedMemoryCapacity(), 1024*1024);
+    topology.connect(feeder, 0, remoteSink, 0);
+    topology.commit();
+
+    size_t numShmBlocks(0), numNetBlocks(0);
+    const auto topObj = json::parse(topology.dumpJSON("{\"mode\":\"rendered\"}"));
+    for (const auto &blockObj : topObj["blocks"])
+    {
+        const auto name = blockObj["name"].get<std::string>();
+        if (name.find("ShmTo: ") == 0 or name.find("ShmFrom: ") == 0) numShmBlocks++;
+        if (name.find("NetTo: ") == 0 or name.find("NetFrom: ") == 0) numNetBlocks++;
+    }
+    POTHOS_TEST_EQUAL(numShmBlocks, 2);
+    POTHOS_TEST_EQUAL(numNetBlocks, 0);
+}
+
+/***********************************************************************
+ * Test labels and messages larger than a shared memory record
+ **********************************************************************/
+struct LargeObjectFeeder : Pothos::Block
+{
+    LargeObjectFeeder(const size_t objectSize):
+        objectSize(objectSize),
+        once(false)
+    {
+        this->setupOutput(0, "int32");
+    }
+
+    void work(void)
+    {
+        if (once) return;
+        once = true;
+        auto out0 = this->output(0);
+        out0->postMessage(std::string(objectSize, 'm'));
+        out0->postLabel("big", std::string(objectSize, 'l'), 0);
+        int *p = out0->buffer();
+        p[0] = 0;
+        out0->produce(1);
+    }
+
+    const size_t objectSize;
+    bool once;
+};
+
+struct LargeObjectChecker : Pothos::Block
+{
+    LargeObjectChecker(void)
+    {
+        this->setupInput(0, "int32");
+    }
+
+    void work(void)
+    {
+        auto in0 = this->input(0);
+        if (in0->hasMessage()) messages.push_back(in0->popMessage().extract<std::string>());
+        const size_t n = in0->elements();
+        for (const auto &label : in0->labels())
+        {
+            if (label.index < n) labels.push_back(label.data.extract<std::string>());
+        }
+        in0->consume(n);
+    }
+
+    std::vector<std::string> messages;
+    std::vector<std::string> labels;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_shared_memory_flow_large_objects)
+{
+    //the objects are several times larger than the ring
+    const size_t capacity = 64*1024;
+    auto feeder = std::shared_ptr<LargeObjectFeeder>(new LargeObjectFeeder(5*capacity));
+    auto checker = std::shared_ptr<LargeObjectChecker>(new LargeObjectChecker());
+    auto shmSink = Pothos::BlockRegistry::make("/shared_memory_sink", capacity);
+    auto shmSource = Pothos::BlockRegistry::make("/shared_memory_source", shmSink.call<std::string>("getPath"));
+
+    Pothos::Topology topology;
+    topology.connect(feeder, 0, shmSink, 0);
+    topology.connect(shmSource, 0, checker, 0);
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+
+    POTHOS_TEST_EQUAL(checker->messages.size(), 1);
+    POTHOS_TEST_EQUAL(checker->labels.size(), 1);
+    POTHOS_TEST_TRUE(checker->messages.front() == std::string(feeder->objectSize, 'm'));
+    POTHOS_TEST_TRUE(checker->labels.front() == std::string(feeder->objectSize, 'l'));
+}
@@ -3,10 +3,16 @@
 
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
+#include "Framework/WorkProfiler.hpp"
+#include "Framework/AdaptiveBuffers.hpp"
+#include <Poco/Environment.h>
+#include <json.hpp>
 #include <chrono>
 #include <thread>
 #include <iostream>
 
+using json = nlohmann::json;
+
 struct MyWorker0 : Pothos::Block
 {
     MyWorker0(void)
@@ -125,3 +131,340 @@ POTHOS_TEST_BLOCK("/framework/tests", test_activate_throw)
         POTHOS_TEST_THROWS(t.commit(), Pothos::TopologyConnectError);
     }
 }
+
+struct LabelCollector : Pothos::Block
+{
+    LabelCollector(void)
+    {
+        this->setupInput(0, "float32");
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        const std::vector<Pothos::Label> labels(inPort->labels().begin(), inPort->labels().end());
+        for (const auto &label : labels)
+        {
+            ids.push_back(label.id);
+            inPort->removeLabel(label);
+        }
+        inPort->consume(inPort->elements());
+    }
+
+    std::vector<std::string> ids;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_input_port_delivery_order)
+{
+    auto w0 = std::shared_ptr<MyWorker0>(new MyWorker0());
+    auto w1 = std::shared_ptr<LabelCollector>(new LabelCollector());
+
+    //preload more entries than the lock-free ring holds
+    const size_t numEntries = 200;
+    for (size_t i = 0; i < numEntries; i++)
+    {
+        w1->input(0)->pushBuffer(Pothos::BufferChunk("float32", 1));
+        w1->input(0)->pushLabel(Pothos::Label(std::to_string(i), i, 0));
+    }
+
+    Pothos::Topology t;
+    t.connect(w0, 0, w1, 0);
+    t.commit();
+    POTHOS_TEST_TRUE(t.waitInactive());
+
+    POTHOS_TEST_EQUAL(w1->input(0)->totalElements(), numEntries+10);
+    POTHOS_TEST_EQUAL(w1->ids.size(), numEntries);
+    for (size_t i = 0; i < w1->ids.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(w1->ids[i], std::to_string(i));
+    }
+}
+
+struct SingleConsumer : Pothos::Block
+{
+    SingleConsumer(void)
+    {
+        this->setupInput(0, "float32");
+    }
+
+    void work(void)
+    {
+        this->input(0)->consume(1);
+    }
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_burst_work_calls)
+{
+    Pothos::ThreadPoolArgs args(1/*threads*/);
+    args.burstIterations = 64;
+    Pothos::ThreadPool threadPool(args);
+
+    auto w0 = std::shared_ptr<MyWorker0>(new MyWorker0());
+    auto w1 = std::shared_ptr<SingleConsumer>(new SingleConsumer());
+    w0->setThreadPool(threadPool);
+    w1->setThreadPool(threadPool);
+
+    //a backlog of single element buffers is consumed in bursts
+    const size_t numBuffers = 200;
+    for (size_t i = 0; i < numBuffers; i++)
+    {
+        w1->input(0)->pushBuffer(Pothos::BufferChunk("float32", 1));
+    }
+
+    Pothos::Topology t;
+    t.connect(w0, 0, w1, 0);
+    t.commit();
+    POTHOS_TEST_TRUE(t.waitInactive());
+    POTHOS_TEST_EQUAL(w1->input(0)->totalElements(), numBuffers+10);
+}
+
+struct CountingSource : Pothos::Block
+{
+    CountingSource(const size_t total):
+        total(total),
+        count(0)
+    {
+        this->setupOutput(0, "float32");
+    }
+
+    void work(void)
+    {
+        auto outPort = this->output(0);
+        const size_t n = std::min<size_t>(outPort->elements(), total-count);
+        if (n == 0) return;
+        float *out = outPort->buffer();
+        for (size_t i = 0; i < n; i++) out[i] = float(count+i);
+        outPort->postLabel(Pothos::Label(std::to_string(count), count, 0));
+        outPort->produce(n);
+        count += n;
+    }
+
+    const size_t total;
+    size_t count;
+};
+
+struct CheckingSink : Pothos::Block
+{
+    CheckingSink(const size_t reserve):
+        reserve(reserve),
+        count(0),
+        errors(0),
+        numLabels(0)
+    {
+        this->setupInput(0, "float32");
+        this->input(0)->setReserve(reserve);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        const std::vector<Pothos::Label> labels(inPort->labels().begin(), inPort->labels().end());
+        for (const auto &label : labels)
+        {
+            if (label.id != std::to_string(count+label.index)) errors++;
+            inPort->removeLabel(label);
+            numLabels++;
+        }
+        const float *in = inPort->buffer();
+        const size_t n = inPort->elements();
+        for (size_t i = 0; i < n; i++)
+        {
+            if (in[i] != float(count+i)) errors++;
+        }
+        inPort->consume(n);
+        count += n;
+    }
+
+    const size_t reserve;
+    size_t count;
+    size_t errors;
+    size_t numLabels;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_fanout_shared_batches)
+{
+    const size_t total = 100000;
+    auto src = std::shared_ptr<CountingSource>(new CountingSource(total));
+
+    //odd reserves force the accumulators to require() across buffers
+    std::vector<std::shared_ptr<CheckingSink>> sinks;
+    for (const size_t reserve : {1, 333, 1000, 3001})
+    {
+        sinks.emplace_back(new CheckingSink(reserve));
+    }
+
+    Pothos::Topology t;
+    for (const auto &sink : sinks) t.connect(src, 0, sink, 0);
+    t.commit();
+    POTHOS_TEST_TRUE(t.waitInactive());
+
+    //a remainder smaller than the reserve is never consumed
+    for (const auto &sink : sinks)
+    {
+        POTHOS_TEST_TRUE(sink->count <= total);
+        POTHOS_TEST_TRUE(sink->count+sink->reserve > total);
+        POTHOS_TEST_EQUAL(sink->errors, 0);
+        POTHOS_TEST_TRUE(sink->numLabels > 0);
+    }
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_work_histogram)
+{
+    //every value lands in a bucket whose lower bound is within 1/4 below
+    for (unsigned long long value : {0ull, 1ull, 3ull, 4ull, 7ull, 8ull, 1000ull, 123456789ull, ~0ull})
+    {
+        const auto index = WorkHistogram::bucketIndex(value);
+        POTHOS_TEST_TRUE(index < WorkHistogram::NumBuckets);
+        const auto lower = WorkHistogram::bucketLowerBound(index);
+        POTHOS_TEST_TRUE(lower <= value);
+        POTHOS_TEST_TRUE(value - lower <= value/4);
+    }
+
+    WorkHistogram hist;
+    for (unsigned long long i = 1; i <= 100; i++) hist.record(i);
+    POTHOS_TEST_EQUAL(hist.count, 100);
+    POTHOS_TEST_EQUAL(hist.min, 1);
+    POTHOS_TEST_EQUAL(hist.max, 100);
+    POTHOS_TEST_TRUE(hist.percentile(50.0) <= 51);
+    POTHOS_TEST_TRUE(hist.percentile(50.0) >= 40);
+    POTHOS_TEST_TRUE(hist.percentile(99.0) >= 80);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_adaptive_buffer_state)
+{
+    Pothos::BufferManagerArgs args;
+    AdaptiveBufferState state("generic", args, Pothos::BufferManager::Sptr());
+    const auto timeout = std::chrono::high_resolution_clock::now() + std::chrono::seconds(1);
+
+    //saturated calls at a high rate grow the buffers
+    while (not state.update(args.bufferSize, args.bufferSize))
+    {
+        POTHOS_TEST_TRUE(std::chrono::high_resolution_clock::now() < timeout);
+    }
+    POTHOS_TEST_EQUAL(state.args.bufferSize, args.bufferSize*2);
+    POTHOS_TEST_EQUAL(state.numResizes, 1);
+
+    //sparse calls shrink the buffers back to the initial size
+    while (not state.update(16, state.args.bufferSize))
+    {
+        POTHOS_TEST_TRUE(std::chrono::high_resolution_clock::now() < timeout);
+    }
+    POTHOS_TEST_EQUAL(state.args.bufferSize, args.bufferSize);
+
+    //but not below the reserve of the port, across several windows
+    const auto reserveEnd = std::chrono::high_resolution_clock::now() + 3*AdaptiveBufferState::windowTime();
+    while (std::chrono::high_resolution_clock::now() < reserveEnd)
+    {
+        POTHOS_TEST_TRUE(not state.update(16, state.args.bufferSize, args.bufferSize));
+    }
+    POTHOS_TEST_EQUAL(state.args.bufferSize, args.bufferSize);
+
+    //and down to the fixed floor below the initial size
+    while (state.args.bufferSize > AdaptiveBufferState::MinBufferSize)
+    {
+        while (not state.update(16, state.args.bufferSize))
+        {
+            POTHOS_TEST_TRUE(std::chrono::high_resolution_clock::now() < timeout);
+        }
+    }
+    POTHOS_TEST_EQUAL(state.args.bufferSize, size_t(AdaptiveBufferState::MinBufferSize));
+    POTHOS_TEST_EQUAL(state.args.numBuffers, args.numBuffers);
+
+    //but never below the floor
+    for (size_t i = 0; i < 1000; i++)
+    {
+        POTHOS_TEST_TRUE(not state.update(16, state.args.bufferSize));
+    }
+    POTHOS_TEST_EQUAL(state.args.bufferSize, size_t(AdaptiveBufferState::MinBufferSize));
+}
+
+struct SaturatingSource : Pothos::Block
+{
+    SaturatingSource(void)
+    {
+        this->setupOutput(0);
+    }
+
+    void work(void)
+    {
+        auto outPort = this->output(0);
+        outPort->produce(outPort->elements());
+    }
+};
+
+struct DiscardingSink : Pothos::Block
+{
+    DiscardingSink(void)
+    {
+        this->setupInput(0);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        inPort->consume(inPort->elements());
+    }
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_adaptive_buffers_topology)
+{
+    Pothos::ThreadPoolArgs args(2/*threads*/);
+    args.adaptiveBuffers = true;
+    Pothos::ThreadPool threadPool(args);
+
+    auto src = std::shared_ptr<SaturatingSource>(new SaturatingSource());
+    auto dst = std::shared_ptr<DiscardingSink>(new DiscardingSink());
+    src->setThreadPool(threadPool);
+    dst->setThreadPool(threadPool);
+
+    Pothos::Topology t;
+    t.connect(src, 0, dst, 0);
+    t.commit();
+
+    //the source fills every buffer with a trivial work(), so the link is
+    //bound by the scheduling overhead and the source buffers should grow
+    unsigned long long numResizes = 0;
+    const auto timeout = std::chrono::high_resolution_clock::now() + std::chrono::seconds(10);
+    while (numResizes == 0 and std::chrono::high_resolution_clock::now() < timeout)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto stats = json::parse(t.queryJSONStats());
+        const auto &portStats = stats.at(src->uid()).at("outputStats").at(0);
+        if (portStats.count("adaptiveBuffers") == 0) continue;
+        const auto &adaptiveStats = portStats["adaptiveBuffers"];
+        numResizes = adaptiveStats["numResizes"].get<unsigned long long>();
+        if (numResizes != 0) POTHOS_TEST_TRUE(adaptiveStats["bufferSize"].get<size_t>() > Pothos::BufferManagerArgs().bufferSize);
+    }
+    POTHOS_TEST_TRUE(numResizes != 0);
+}
+
+#ifdef POTHOS_WORK_PROFILER
+POTHOS_TEST_BLOCK("/framework/tests", test_work_profiler_stats)
+{
+    //the profiler is enabled for blocks created with the variable set
+    Poco::Environment::set("POTHOS_WORK_PROFILER", "1");
+    auto w0 = std::shared_ptr<MyWorker0>(new MyWorker0());
+    auto w1 = std::shared_ptr<LabelCollector>(new LabelCollector());
+    Poco::Environment::set("POTHOS_WORK_PROFILER", "0");
+
+    Pothos::Topology t;
+    t.connect(w0, 0, w1, 0);
+    t.commit();
+    POTHOS_TEST_TRUE(t.waitInactive());
+
+    const auto stats = json::parse(t.queryJSONStats());
+    const auto &w0Stats = stats.at(w0->uid());
+    const auto &w1Stats = stats.at(w1->uid());
+    POTHOS_TEST_TRUE(w0Stats.count("workProfiler") != 0);
+    POTHOS_TEST_TRUE(w1Stats.count("workProfiler") != 0);
+
+    //one histogram entry per work() call
+    const auto &w0Prof = w0Stats["workProfiler"];
+    const auto &w1Prof = w1Stats["workProfiler"];
+    POTHOS_TEST_EQUAL(w0Prof["workDuration"]["count"].get<unsigned long long>(), w0Stats["numWorkCalls"].get<unsigned long long>());
+    POTHOS_TEST_EQUAL(w1Prof["workDuration"]["count"].get<unsigned long long>(), w1Stats["numWorkCalls"].get<unsigned long long>());
+    POTHOS_TEST_EQUAL(w0Prof["elementsProduced"]["sum"].get<unsigned long long>(), 10);
+    POTHOS_TEST_EQUAL(w1Prof["elementsConsumed"]["sum"].get<unsigned long long>(), 10);
+    POTHOS_TEST_TRUE(w1Prof["schedulingDelay"]["count"].get<unsigned long long>() != 0);
+}
+#endif
@@ -2,6 +2,7 @@
 //                    2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Framework/DTypeElementTypes.hpp"
 #include <Pothos/Framework/DType.hpp>
 #include <Pothos/Framework/Exception.hpp>
 #include <Pothos/Object.hpp>
@@ -15,46 +16,6 @@
 #include <array>
 #include <map>
 
-/***********************************************************************
- * officially supported element types
- **********************************************************************/
-static const int Custom = (1 << 0);
-static const int Signed = (1 << 1);
-static const int Integer = (1 << 2);
-static const int Float = (1 << 3);
-static const int Complex = (1 << 4);
-static const int Bytes1 = (0 << 5);
-static const int Bytes2 = (1 << 5);
-static const int Bytes4 = (2 << 5);
-static const int Bytes8 = (3 << 5);
-static const int Length = 128;
-
-enum ElementTypes : unsigned char
-{
-    EmptyType = 0,
-    CustomType = Custom,
-    Int8 = Signed | Integer | Bytes1,
-    UInt8 = Integer | Bytes1,
-    Int16 = Signed | Integer | Bytes2,
-    UInt16 = Integer | Bytes2,
-    Int32 = Signed | Integer | Bytes4,
-    UInt32 = Integer | Bytes4,
-    Int64 = Signed | Integer | Bytes8,
-    UInt64 = Integer | Bytes8,
-    ComplexInt8 = Complex | Signed | Integer | Bytes1,
-    ComplexUInt8 = Complex | Integer | Bytes1,
-    ComplexInt16 = Complex | Signed | Integer | Bytes2,
-    ComplexUInt16 = Complex | Integer | Bytes2,
-    ComplexInt32 = Complex | Signed | Integer | Bytes4,
-    ComplexUInt32 = Complex | Integer | Bytes4,
-    ComplexInt64 = Complex | Signed | Integer | Bytes8,
-    ComplexUInt64 = Complex | Integer | Bytes8,
-    Float32 = Float | Bytes4,
-    Float64 = Float | Bytes8,
-    ComplexFloat32 = Complex | Float | Bytes4,
-    ComplexFloat64 = Complex | Float | Bytes8,
-};
-
 /***********************************************************************
  * lookup map for various element type properties
  **********************************************************************/
@@ -0,0 +1,55 @@
+// Copyright (c) 2014-2017 Josh Blum
+//                    2020 Nicholas Corgan
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <cstddef>
+
+/***********************************************************************
+ * officially supported element types
+ **********************************************************************/
+static const int Custom = (1 << 0);
+static const int Signed = (1 << 1);
+static const int Integer = (1 << 2);
+static const int Float = (1 << 3);
+static const int Complex = (1 << 4);
+static const int Bytes1 = (0 << 5);
+static const int Bytes2 = (1 << 5);
+static const int Bytes4 = (2 << 5);
+static const int Bytes8 = (3 << 5);
+static const int Length = 128;
+
+enum ElementTypes : unsigned char
+{
+    EmptyType = 0,
+    CustomType = Custom,
+    Int8 = Signed | Integer | Bytes1,
+    UInt8 = Integer | Bytes1,
+    Int16 = Signed | Integer | Bytes2,
+    UInt16 = Integer | Bytes2,
+    Int32 = Signed | Integer | Bytes4,
+    UInt32 = Integer | Bytes4,
+    Int64 = Signed | Integer | Bytes8,
+    UInt64 = Integer | Bytes8,
+    ComplexInt8 = Complex | Signed | Integer | Bytes1,
+    ComplexUInt8 = Complex | Integer | Bytes1,
+    ComplexInt16 = Complex | Signed | Integer | Bytes2,
+    ComplexUInt16 = Complex | Integer | Bytes2,
+    ComplexInt32 = Complex | Signed | Integer | Bytes4,
+    ComplexUInt32 = Complex | Integer | Bytes4,
+    ComplexInt64 = Complex | Signed | Integer | Bytes8,
+    ComplexUInt64 = Complex | Integer | Bytes8,
+    Float32 = Float | Bytes4,
+    Float64 = Float | Bytes8,
+    ComplexFloat32 = Complex | Float | Bytes4,
+    ComplexFloat64 = Complex | Float | Bytes8,
+};
+
+//! The number of element type codes, excluding the custom bit
+static const int NumElementTypeIndexes = Length >> 1;
+
+//! A dense index from the element type code of a numeric type
+constexpr size_t elementTypeIndex(const unsigned char elemType)
+{
+    return size_t(elemType >> 1);
+}
@@ -4,6 +4,7 @@
 
 #include <Pothos/Framework/InputPortImpl.hpp>
 #include "Framework/WorkerActor.hpp"
+#include "Framework/InputPortInbox.hpp"
 
 /*!
  * An arbitrary bound on the queue size to detect buggy situations
@@ -25,7 +26,8 @@ Pothos::InputPort::InputPort(void):
     _totalMessages(0),
     _pendingElements(0),
     _reserveElements(0),
-    _workEvents(0)
+    _workEvents(0),
+    _inbox(new InputPortInbox())
 {
     return;
 }
@@ -145,6 +147,105 @@ void Pothos::InputPort::slotCallsClear(void)
     _slotCalls.clear();
 }
 
+void Pothos::InputPort::inlineMessagesPush(const Pothos::Label &label)
+{
+    std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
+    _inbox->pushLabel(Label(label), true/*absolute*/);
+}
+
+void Pothos::InputPort::inlineMessagesClear(void)
+{
+    std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
+    _inbox->pushClear(InputPortInbox::CLEAR_LABELS);
+}
+
+void Pothos::InputPort::inboxDrain(void)
+{
+    _inbox->drain([this](InputPortInbox::Entry &&entry)
+    {
+        switch (entry.kind)
+        {
+        case InputPortInbox::BUFFER:
+            this->bufferAccumulatorPushNoLock(std::move(entry.buffer));
+            break;
+
+        //adjust relative labels for the current offset
+        case InputPortInbox::LABEL:
+            entry.label.index += _bufferAccumulator.getTotalBytesAvailable();
+            if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
+            _inputInlineMessages.push_back(std::move(entry.label));
+            break;
+
+        case InputPortInbox::ABSOLUTE_LABEL:
+            if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
+            _inputInlineMessages.push_back(std::move(entry.label));
+            break;
+
+        //labels then buffers from a batch shared with other subscribers,
+        //the last subscriber to drain the batch can move out of it
+        case InputPortInbox::BATCH:
+        {
+            auto &batch = *entry.batch;
+            const bool unique = batch.pending.load(std::memory_order_acquire) == 1;
+            const auto offset = _bufferAccumulator.getTotalBytesAvailable();
+            for (auto &label : batch.labels)
+            {
+                if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
+                if (unique) _inputInlineMessages.push_back(std::move(label));
+                else _inputInlineMessages.push_back(label);
+                _inputInlineMessages.back().index += offset;
+            }
+            for (auto &buffer : batch.buffers)
+            {
+                if (unique) this->bufferAccumulatorPushNoLock(std::move(buffer));
+                else this->bufferAccumulatorPushNoLock(BufferChunk(buffer));
+            }
+            if (not unique) batch.pending.fetch_sub(1, std::memory_order_acq_rel);
+            break;
+        }
+
+        case InputPortInbox::CLEAR_BUFFERS:
+            _bufferAccumulator = BufferAccumulator();
+            break;
+
+        case InputPortInbox::CLEAR_LABELS:
+            _inputInlineMessages.clear();
+            _inlineMessages.clear();
+            break;
+        }
+    });
+}
+
+void Pothos::InputPort::bufferAccumulatorFront(Pothos::BufferChunk &buff)
+{
+    this->inboxDrain();
+    while (not _inputInlineMessages.empty())
+    {
+        _inlineMessages.push_back(std::move(_inputInlineMessages.front()));
+        _inlineMessages.back().adjust(1, this->dtype().size());
+        _inputInlineMessages.pop_front();
+    }
+    buff = _bufferAccumulator.front();
+}
+
+void Pothos::InputPort::bufferAccumulatorPush(const BufferChunk &buffer)
+{
+    std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
+    _inbox->pushBuffer(BufferChunk(buffer));
+}
+
+void Pothos::InputPort::bufferAccumulatorRequire(const size_t numBytes)
+{
+    this->inboxDrain();
+    _bufferAccumulator.require(numBytes);
+}
+
+void Pothos::InputPort::bufferAccumulatorClear(void)
+{
+    std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
+    _inbox->pushClear(InputPortInbox::CLEAR_BUFFERS);
+}
+
 void Pothos::InputPort::bufferAccumulatorPushNoLock(BufferChunk &&buffer)
 {
     if (not buffer.dtype or not this->dtype() or //unspecified
@@ -164,8 +265,6 @@ void Pothos::InputPort::bufferAccumulatorPushNoLock(BufferChunk &&buffer)
 
 void Pothos::InputPort::bufferAccumulatorPop(const size_t numBytes)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-
     if (numBytes > _bufferAccumulator.getTotalBytesAvailable())
     {
         poco_error_f4(Poco::Logger::get("Pothos.Block.consume"), "%s[%s] overconsumed %z bytes, %z available",
@@ -190,43 +289,28 @@ void Pothos::InputPort::bufferLabelPush(
     Pothos::Util::RingDeque<Pothos::BufferChunk> &postedBuffers)
 {
     {
-        std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-
-        const size_t currentBytes = _bufferAccumulator.getTotalBytesAvailable();
-        const size_t requiredLabelSize = _inputInlineMessages.size() + postedLabels.size();
-        if (_inputInlineMessages.capacity() < requiredLabelSize) _inputInlineMessages.set_capacity(requiredLabelSize);
+        std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
 
+        //labels are relative to the posted buffers,
+        //push them first so the worker can apply the offset
         if (enableMove)
         {
-            //insert labels (in order) and adjust for the current offset
-            for (auto &label : postedLabels)
-            {
-                label.index += currentBytes; //increment by enqueued bytes
-                _inputInlineMessages.push_back(std::move(label));
-            }
+            for (auto &label : postedLabels) _inbox->pushLabel(std::move(label));
             postedLabels.clear();
 
-            //push all buffers into the accumulator
             while (not postedBuffers.empty())
             {
-                this->bufferAccumulatorPushNoLock(std::move(postedBuffers.front()));
+                _inbox->pushBuffer(std::move(postedBuffers.front()));
                 postedBuffers.pop_front();
             }
         }
         else
         {
+            for (const auto &label : postedLabels) _inbox->pushLabel(Label(label));
 
-            //insert labels (in order) and adjust for the current offset
-            for (auto label : postedLabels)
-            {
-                label.index += currentBytes; //increment by enqueued bytes
-                _inputInlineMessages.push_back(std::move(label));
-            }
-
-            //push all buffers into the accumulator
             for (size_t i = 0; i < postedBuffers.size(); i++)
             {
-                this->bufferAccumulatorPushNoLock(BufferChunk(postedBuffers[i]));
+                _inbox->pushBuffer(BufferChunk(postedBuffers[i]));
             }
         }
     }
@@ -235,6 +319,17 @@ void Pothos::InputPort::bufferLabelPush(
     _actor->flagExternalChange();
 }
 
+void Pothos::InputPort::bufferBatchPush(const std::shared_ptr<InputPortBatch> &batch)
+{
+    {
+        std::lock_guard<Util::SpinLock> lock(_inbox->pushLock);
+        _inbox->pushBatch(batch);
+    }
+
+    assert(_actor != nullptr);
+    _actor->flagExternalChange();
+}
+
 #include <Pothos/Managed.hpp>
 
 static auto managedInputPort = Pothos::ManagedClass()
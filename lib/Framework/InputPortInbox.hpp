@@ -0,0 +1,196 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/Label.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Util/SpinLock.hpp>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * The labels and buffers posted by an output port with multiple subscribers.
+ * The batch is built once and shared by every subscriber's inbox,
+ * rather than copying the labels and buffers for each subscriber.
+ * Labels are relative to the first buffer in the batch.
+ *
+ * The pending count starts at the number of subscribers,
+ * and each subscriber counts down after copying out of the batch.
+ * A subscriber which finds itself the only one pending
+ * is the last reader and takes the contents by move.
+ */
+class Pothos::InputPortBatch
+{
+public:
+    InputPortBatch(const size_t numSubscribers):
+        pending(numSubscribers)
+    {
+        return;
+    }
+
+    std::vector<Label> labels;
+    std::vector<BufferChunk> buffers;
+    std::atomic<size_t> pending;
+};
+
+/*!
+ * The InputPortInbox delivers buffers and labels from upstream producers
+ * to the worker thread which owns the input port's buffer accumulator.
+ *
+ * The fast path is a single-producer/single-consumer lock-free ring:
+ * Producers serialize amongst themselves with the push lock,
+ * which is uncontended in the common case of one upstream port.
+ * The consumer never takes the push lock unless the ring overflowed,
+ * so the producer and consumer do not contend on a shared lock.
+ *
+ * When the ring is full, producers append to an overflow queue.
+ * Once overflow is active, all entries go to the overflow queue,
+ * until the consumer has drained both, preserving the entry order.
+ */
+class Pothos::InputPortInbox
+{
+public:
+
+    enum EntryKind
+    {
+        BUFFER, //!< a buffer to push into the accumulator
+        LABEL, //!< a label with an index relative to the pushed buffers
+        ABSOLUTE_LABEL, //!< a label with an index relative to the accumulator
+        CLEAR_BUFFERS, //!< clear the buffer accumulator
+        CLEAR_LABELS, //!< clear all enqueued labels
+        BATCH, //!< labels and buffers shared with other subscribers
+    };
+
+    struct Entry
+    {
+        EntryKind kind;
+        BufferChunk buffer;
+        Label label;
+        std::shared_ptr<InputPortBatch> batch;
+    };
+
+    //! The number of entries in the lock-free ring (power of two)
+    static const size_t Capacity = 64;
+
+    InputPortInbox(void):
+        _head(0),
+        _tail(0),
+        _useRing(false),
+        _overflowActive(false)
+    {
+        return;
+    }
+
+    //! Producer: serialize producers, hold while pushing
+    Util::SpinLock pushLock;
+
+    //! Producer: push a buffer entry (pushLock held)
+    void pushBuffer(BufferChunk &&buffer)
+    {
+        auto &entry = this->_back();
+        entry.kind = BUFFER;
+        entry.buffer = std::move(buffer);
+        this->_commit();
+    }
+
+    //! Producer: push a label entry (pushLock held)
+    void pushLabel(Label &&label, const bool absolute = false)
+    {
+        auto &entry = this->_back();
+        entry.kind = absolute?ABSOLUTE_LABEL:LABEL;
+        entry.label = std::move(label);
+        this->_commit();
+    }
+
+    //! Producer: push a shared batch entry (pushLock held)
+    void pushBatch(const std::shared_ptr<InputPortBatch> &batch)
+    {
+        auto &entry = this->_back();
+        entry.kind = BATCH;
+        entry.batch = batch;
+        this->_commit();
+    }
+
+    //! Producer: push a clear entry (pushLock held)
+    void pushClear(const EntryKind kind)
+    {
+        auto &entry = this->_back();
+        entry.kind = kind;
+        this->_commit();
+    }
+
+    /*!
+     * Consumer: handle all available entries in order.
+     * The handler takes the entry by rvalue reference,
+     * and the entry is reset after the handler is called,
+     * so that buffer references are always released.
+     */
+    template <typename HandlerType>
+    void drain(const HandlerType &handler)
+    {
+        this->_drainRing(handler);
+
+        //overflow active, lockout producers and drain again
+        if (not _overflowActive.load(std::memory_order_acquire)) return;
+        std::lock_guard<Util::SpinLock> lock(pushLock);
+        this->_drainRing(handler);
+        for (auto &entry : _overflow) handler(std::move(entry));
+        _overflow.clear();
+        _overflowActive.store(false, std::memory_order_release);
+    }
+
+private:
+
+    //! Get the next entry to fill, the ring or the overflow
+    Entry &_back(void)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        _useRing = not _overflowActive.load(std::memory_order_relaxed) and
+            (tail - _head.load(std::memory_order_acquire)) < Capacity;
+        if (_useRing) return _ring[tail % Capacity];
+        _overflow.emplace_back();
+        return _overflow.back();
+    }
+
+    //! Publish the entry filled with _back()
+    void _commit(void)
+    {
+        if (_useRing) _tail.store(_tail.load(std::memory_order_relaxed)+1, std::memory_order_release);
+        else _overflowActive.store(true, std::memory_order_release);
+    }
+
+    template <typename HandlerType>
+    void _drainRing(const HandlerType &handler)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        if (head == tail) return;
+        while (head != tail)
+        {
+            auto &entry = _ring[(head++) % Capacity];
+            handler(std::move(entry));
+            if (entry.kind == BUFFER) entry.buffer = BufferChunk();
+            else if (entry.kind == BATCH) entry.batch.reset();
+            else entry.label = Label();
+        }
+        _head.store(head, std::memory_order_release);
+    }
+
+    //consumer index on its own cache line
+    char _pad0[64];
+    std::atomic<size_t> _head;
+
+    //producer state on its own cache line
+    char _pad1[64];
+    std::atomic<size_t> _tail;
+    bool _useRing;
+    std::atomic<bool> _overflowActive;
+    std::deque<Entry> _overflow;
+
+    char _pad2[64];
+    Entry _ring[Capacity];
+};
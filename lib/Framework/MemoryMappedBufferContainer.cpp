@@ -11,6 +11,8 @@
 #include <Poco/Logger.h>
 #include <Poco/Platform.h>
 
+#include <algorithm>
+
 static Poco::Logger& getLogger()
 {
     static auto& logger = Poco::Logger::get("MemoryMappedBufferContainer");
@@ -45,7 +47,10 @@ class MemoryMappedBufferContainer::Impl
 public:
     Impl(const std::string& filepath,
          bool readable,
-         bool writable): _buffer(nullptr), _length(0)
+         bool writable,
+         size_t offset,
+         size_t length,
+         bool copyOnWrite): _buffer(nullptr), _length(length)
     {
         int openFlags = 0;
         if(readable && writable) openFlags = O_RDWR;
@@ -56,15 +61,17 @@ public:
         if(readable) mmapProt |= PROT_READ;
         if(writable) mmapProt |= PROT_WRITE;
 
-        constexpr int mmapFlags = MAP_SHARED;
+        //private pages are copied on the first write and never written back
+        if(copyOnWrite) mmapProt |= PROT_WRITE;
+        const int mmapFlags = copyOnWrite? MAP_PRIVATE : MAP_SHARED;
 
-        _length = Poco::File(filepath).getSize();
+        if (_length == 0) _length = Poco::File(filepath).getSize() - offset;
 
         int fd = 0;
         throwErrnoOnFailure<Pothos::OpenFileException>(
             (fd = ::open(filepath.c_str(), openFlags)));
 
-        _buffer = ::mmap(nullptr, _length, mmapProt, mmapFlags, fd, 0);
+        _buffer = ::mmap(nullptr, _length, mmapProt, mmapFlags, fd, off_t(offset));
         if(!_buffer || (MAP_FAILED == _buffer))
         {
             throw Pothos::IOException("mmap", ::strerror(errno));
@@ -90,11 +97,35 @@ public:
         return _length;
     }
 
+    void advise(size_t offset, size_t length, Advice advice) const
+    {
+        int flag = MADV_NORMAL;
+        if (advice == ADVISE_SEQUENTIAL) flag = MADV_SEQUENTIAL;
+        if (advice == ADVISE_WILLNEED) flag = MADV_WILLNEED;
+        if (advice == ADVISE_DONTNEED) flag = MADV_DONTNEED;
+
+        //madvise() requires a page aligned start address
+        offset = std::min(offset, _length);
+        length = std::min(length, _length - offset);
+        const size_t start = size_t(_buffer) + offset;
+        const size_t alignedStart = start - (start % mapAlignment());
+        if (length == 0) return;
+        logErrnoOnFailure(
+            ::madvise(reinterpret_cast<void *>(alignedStart), length + (start - alignedStart), flag),
+            "madvise");
+    }
+
 private:
     void* _buffer;
     size_t _length;
 };
 
+size_t MemoryMappedBufferContainer::mapAlignment()
+{
+    static const size_t pageSize = size_t(::sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
 #else
 //
 // Windows
@@ -126,9 +157,12 @@ class MemoryMappedBufferContainer::Impl
 public:
     Impl(const std::string& filepath,
         bool readable,
-        bool writable) : _buffer(nullptr), _length(0), _fileHandle(nullptr)
+        bool writable,
+        size_t offset,
+        size_t length,
+        bool copyOnWrite) : _buffer(nullptr), _length(length), _fileHandle(nullptr)
     {
-        _length = Poco::File(filepath).getSize();
+        if (_length == 0) _length = Poco::File(filepath).getSize() - offset;
 
         //
         // Variables used by multiple functions
@@ -144,7 +178,8 @@ public:
         if (readable) createFileDesiredAccess |= GENERIC_READ;
         if (writable) createFileDesiredAccess |= GENERIC_WRITE;
 
-        constexpr DWORD shareMode = 0; // Don't let other processes mess with this file
+        // Windows of the same file may be mapped by several containers
+        constexpr DWORD shareMode = FILE_SHARE_READ | FILE_SHARE_WRITE;
         constexpr DWORD creationDisposition = OPEN_ALWAYS; // Only support existing files
         constexpr DWORD flagsAndAttributes = FILE_ATTRIBUTE_NORMAL;
         constexpr ::HANDLE templateFile = nullptr;
@@ -173,10 +208,12 @@ public:
         if (readable && writable) fileProtection = PAGE_READWRITE;
         else if (readable)        fileProtection = PAGE_READONLY;
         else if (writable)        fileProtection = PAGE_WRITECOPY;
+        if (copyOnWrite)          fileProtection = PAGE_WRITECOPY;
 
         // This function takes the file size in through two parameters.
-        DWORD maxSizeHigh = static_cast<DWORD>(_length >> 32);
-        DWORD maxSizeLow = static_cast<DWORD>(_length & 0xFFFFFFFF);
+        const unsigned long long maxSize = offset + _length;
+        DWORD maxSizeHigh = static_cast<DWORD>(maxSize >> 32);
+        DWORD maxSizeLow = static_cast<DWORD>(maxSize & 0xFFFFFFFF);
 
         constexpr LPCSTR name = nullptr;
 
@@ -204,9 +241,10 @@ public:
         if (readable && writable) mapViewOfFileDesiredAccess = FILE_MAP_ALL_ACCESS;
         else if (readable)        mapViewOfFileDesiredAccess = FILE_MAP_READ;
         else if (writable)        mapViewOfFileDesiredAccess = FILE_MAP_WRITE;
+        if (copyOnWrite)          mapViewOfFileDesiredAccess = FILE_MAP_COPY;
 
-        constexpr DWORD offsetHigh = 0;
-        constexpr DWORD offsetLow = 0;
+        const DWORD offsetHigh = static_cast<DWORD>((unsigned long long)(offset) >> 32);
+        const DWORD offsetLow = static_cast<DWORD>(offset & 0xFFFFFFFF);
 
         _buffer = ::MapViewOfFile(
                        _mappingHandle,
@@ -245,6 +283,12 @@ public:
         return _length;
     }
 
+    void advise(size_t, size_t, Advice) const
+    {
+        // No equivalent hints for views of file mappings,
+        // the cache manager performs its own read-ahead.
+    }
+
 private:
     void* _buffer;
     size_t _length;
@@ -261,6 +305,12 @@ private:
         }
     }
 };
+size_t MemoryMappedBufferContainer::mapAlignment()
+{
+    ::SYSTEM_INFO systemInfo;
+    ::GetSystemInfo(&systemInfo);
+    return size_t(systemInfo.dwAllocationGranularity);
+}
 #endif
 
 //
@@ -275,19 +325,39 @@ MemoryMappedBufferContainer::SPtr MemoryMappedBufferContainer::make(
     return std::make_shared<MemoryMappedBufferContainer>(filepath, readable, writable);
 }
 
+MemoryMappedBufferContainer::SPtr MemoryMappedBufferContainer::make(
+    const std::string& filepath,
+    bool readable,
+    bool writable,
+    size_t offset,
+    size_t length)
+{
+    return std::make_shared<MemoryMappedBufferContainer>(filepath, readable, writable, offset, length);
+}
+
+MemoryMappedBufferContainer::SPtr MemoryMappedBufferContainer::makeCopyOnWrite(const std::string& filepath)
+{
+    return std::make_shared<MemoryMappedBufferContainer>(filepath, true, false, 0, 0, true);
+}
+
 MemoryMappedBufferContainer::MemoryMappedBufferContainer(
     const std::string& filepath,
     bool readable,
-    bool writable): _implUPtr(nullptr)
+    bool writable,
+    size_t offset,
+    size_t length,
+    bool copyOnWrite): _implUPtr(nullptr)
 {
     const Poco::File pocoFile(filepath);
 
     if (!pocoFile.exists()) throw Pothos::FileNotFoundException(filepath);
     if (pocoFile.getSize() == 0) throw Pothos::InvalidArgumentException("Empty files not supported", filepath);
+    if (offset % mapAlignment() != 0) throw Pothos::InvalidArgumentException("Unaligned mapping offset", filepath);
+    if (length == 0 && offset >= pocoFile.getSize()) throw Pothos::InvalidArgumentException("Mapping offset past the end", filepath);
     if (readable && !pocoFile.canRead()) throw Pothos::FileAccessDeniedException(filepath);
     if (writable && !pocoFile.canWrite()) throw Pothos::FileReadOnlyException(filepath);
 
-    _implUPtr.reset(new Impl(filepath, readable, writable));
+    _implUPtr.reset(new Impl(filepath, readable, writable, offset, length, copyOnWrite));
 }
 
 MemoryMappedBufferContainer::~MemoryMappedBufferContainer()
@@ -303,3 +373,8 @@ size_t MemoryMappedBufferContainer::length() const
 {
     return _implUPtr->length();
 }
+
+void MemoryMappedBufferContainer::advise(size_t offset, size_t length, Advice advice) const
+{
+    _implUPtr->advise(offset, length, advice);
+}
@@ -13,21 +13,52 @@ class MemoryMappedBufferContainer
 public:
     using SPtr = std::shared_ptr<MemoryMappedBufferContainer>;
 
+    //! Hints about the upcoming accesses to a mapped range
+    enum Advice
+    {
+        ADVISE_SEQUENTIAL,
+        ADVISE_WILLNEED,
+        ADVISE_DONTNEED,
+    };
+
     static SPtr make(
         const std::string& filepath,
         bool readable,
         bool writable);
 
+    //! Map a window of the file, the offset must be a multiple of mapAlignment()
+    static SPtr make(
+        const std::string& filepath,
+        bool readable,
+        bool writable,
+        size_t offset,
+        size_t length);
+
+    /*!
+     * Map the file readable with private copy-on-write pages.
+     * Writes to the buffer are allowed but never reach the file.
+     */
+    static SPtr makeCopyOnWrite(const std::string& filepath);
+
+    //! The required alignment for the file offset of a window
+    static size_t mapAlignment();
+
     MemoryMappedBufferContainer(
         const std::string& filepath,
         bool readable,
-        bool writable);
+        bool writable,
+        size_t offset = 0,
+        size_t length = 0,
+        bool copyOnWrite = false);
 
     ~MemoryMappedBufferContainer();
 
     void* buffer() const;
     size_t length() const;
 
+    //! Advise the OS about accesses to a range relative to buffer()
+    void advise(size_t offset, size_t length, Advice advice) const;
+
 private:
     class Impl;
 
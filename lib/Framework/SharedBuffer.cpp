@@ -52,7 +52,7 @@ static std::mutex &getCircMutex(void)
     return mutex;
 }
 
-Pothos::SharedBuffer Pothos::SharedBuffer::makeCirc(const size_t numBytes, const long nodeAffinity)
+Pothos::SharedBuffer Pothos::SharedBuffer::makeCirc(const size_t numBytes, const long nodeAffinity, const bool hugePages)
 {
     //circular buffer implementations form a natural race condition
     //combine a mutex with retry logic to ensure the call succeeds
@@ -62,7 +62,7 @@ Pothos::SharedBuffer Pothos::SharedBuffer::makeCirc(const size_t numBytes, const
         std::lock_guard<std::mutex> lock(getCircMutex());
         try
         {
-            SharedBuffer buff = SharedBuffer::makeCircUnprotected(numBytes, nodeAffinity);
+            SharedBuffer buff = SharedBuffer::makeCircUnprotected(numBytes, nodeAffinity, hugePages);
             buff._alias = buff.getAddress() + buff.getLength();
             return buff;
         }
@@ -11,14 +11,22 @@
 #include <cerrno> //errno
 #include <cstring> //strerror
 #include <sys/mman.h> //mmap
+#ifdef __linux__
+#include <sys/syscall.h> //SYS_memfd_create
+#endif
 
 //MAP_ANON is deprecated - this supports older headers
 #ifndef MAP_ANONYMOUS
 #define MAP_ANONYMOUS MAP_ANON
 #endif
 
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
 #if HAVE_LIBNUMA
 #include <numa.h>
+#include <numaif.h> //mbind
 #endif
 
 #ifdef __FreeBSD__
@@ -91,12 +99,68 @@ private:
 };
 
 /***********************************************************************
- * numa allocator for an affinitized memory slab
+ * physical memory file descriptor for circular buffers
+ **********************************************************************/
+#if defined(__linux__) && defined(SYS_memfd_create)
+#define HAVE_MEMFD_CREATE 1
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_HUGETLB
+#define MFD_HUGETLB 0x0004U
+#endif
+#ifndef MFD_HUGE_2MB
+#define MFD_HUGE_2MB (21U << 26)
+#endif
+#endif
+
+#define HUGE_PAGE_BYTES (size_t(2)*1024*1024)
+
+//! Anonymous memory file or -1 when unsupported
+static int openMemoryFd(const bool hugePages)
+{
+    #ifdef HAVE_MEMFD_CREATE
+    unsigned flags = MFD_CLOEXEC;
+    if (hugePages) flags |= MFD_HUGETLB | MFD_HUGE_2MB;
+    return int(syscall(SYS_memfd_create, "PothosCircBuff", flags));
+    #else
+    (void)hugePages;
+    return -1;
+    #endif
+}
+
+//! Temporary file that is unlinked when the path goes out of scope
+static int openTemporaryFd(void)
+{
+    Poco::TemporaryFile tmpFile;
+    const int fd = open(
+        tmpFile.path().c_str(),
+        O_RDWR | O_CREAT | O_EXCL,
+        S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        const int errnoSave = errno;
+        throw Pothos::SharedBufferError(
+            "Pothos::CircularBufferContainer::open("+ tmpFile.path() +")",
+            Poco::format("errno %d - %s", errnoSave, std::string(strerror(errnoSave))));
+    }
+    return fd;
+}
+
+/***********************************************************************
+ * double mapped memory for a circular buffer
  **********************************************************************/
 class CircularBufferContainer
 {
 public:
-    CircularBufferContainer(const size_t numBytes);
+    /*!
+     * Map the physical memory file twice into contiguous virtual memory.
+     * \param numBytes the size of the memory (a multiple of the page size)
+     * \param fd the physical memory file descriptor (owned by the container)
+     * \param pageSize the alignment of the mapping
+     * \param nodeAffinity the NUMA node for the physical memory or -1
+     */
+    CircularBufferContainer(const size_t numBytes, const int fd, const size_t pageSize, const long nodeAffinity);
     ~CircularBufferContainer(void)
     {
         this->cleanup();
@@ -125,6 +189,9 @@ private:
         if (mapPtr0 != MAP_FAILED) munmap(mapPtr0, _numBytes);
         mapPtr0 = MAP_FAILED;
 
+        if (reserved != MAP_FAILED) munmap(reserved, reservedBytes);
+        reserved = MAP_FAILED;
+
         if (tmpFd >= 0)
         {
             close(tmpFd);
@@ -135,54 +202,50 @@ private:
     const size_t _numBytes;
     void *virtualAddr2X;
     int tmpFd;
+    void *reserved;
+    size_t reservedBytes;
     void *mapPtr0;
     void *mapPtr1;
 };
 
-CircularBufferContainer::CircularBufferContainer(const size_t numBytes):
+CircularBufferContainer::CircularBufferContainer(const size_t numBytes, const int fd, const size_t pageSize, const long nodeAffinity):
     _numBytes(numBytes),
     virtualAddr2X(nullptr),
-    tmpFd(-1),
+    tmpFd(fd),
+    reserved(MAP_FAILED),
+    reservedBytes(0),
     mapPtr0(MAP_FAILED),
     mapPtr1(MAP_FAILED)
 {
     int ret = 0;
 
     /*******************************************************************
-     * Step 1) open a temp file for physical memory
+     * Step 1) size the file for physical memory
      ******************************************************************/
-    Poco::TemporaryFile tmpFile;
-    tmpFd = open(
-        tmpFile.path().c_str(),
-        O_RDWR | O_CREAT | O_EXCL,
-        S_IRUSR | S_IWUSR);
-    if (tmpFd < 0) this->errorOut("open("+ tmpFile.path() +")");
-
-    ret = ftruncate(tmpFd, numBytes*2);
-    if (ret != 0) this->errorOut("ftruncate("+ tmpFile.path() +")");
+    ret = ftruncate(tmpFd, numBytes);
+    if (ret != 0) this->errorOut("ftruncate()");
 
     /*******************************************************************
-     * Step 2) find a 2X chunk of virtual memory
+     * Step 2) reserve an aligned 2X chunk of virtual memory
      ******************************************************************/
-    virtualAddr2X = mmap(
+    reservedBytes = numBytes*2 + pageSize;
+    reserved = mmap(
         nullptr,
-        numBytes*2,
+        reservedBytes,
         PROT_NONE,
-        MAP_PRIVATE | MAP_ANONYMOUS,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
         -1, off_t(0));
-    if (virtualAddr2X == MAP_FAILED) this->errorOut("mmap(2x)");
-
-    ret = munmap(virtualAddr2X, numBytes*2);
-    if (ret != 0) this->errorOut("munmap(2x)");
+    if (reserved == MAP_FAILED) this->errorOut("mmap(2x)");
+    virtualAddr2X = (void *)(((size_t(reserved) + pageSize - 1)/pageSize)*pageSize);
 
     /*******************************************************************
-     * Step 3) perform overlapping virtual mappings
+     * Step 3) perform overlapping virtual mappings over the reservation
      ******************************************************************/
     mapPtr0 = mmap(
         virtualAddr2X,
         numBytes,
         PROT_READ | PROT_WRITE,
-        MAP_SHARED,
+        MAP_SHARED | MAP_FIXED,
         tmpFd, off_t(0));
     if (mapPtr0 == MAP_FAILED) this->errorOut("mmap(0)");
 
@@ -190,9 +253,30 @@ CircularBufferContainer::CircularBufferContainer(const size_t numBytes):
         (void *)(size_t(virtualAddr2X) + numBytes),
         numBytes,
         PROT_READ | PROT_WRITE,
-        MAP_SHARED,
+        MAP_SHARED | MAP_FIXED,
         tmpFd, off_t(0));
     if (mapPtr1 == MAP_FAILED) this->errorOut("mmap(1)");
+
+    //release the unused head and tail of the reservation
+    const size_t headBytes = size_t(virtualAddr2X) - size_t(reserved);
+    const size_t tailBytes = reservedBytes - headBytes - numBytes*2;
+    if (headBytes != 0) munmap(reserved, headBytes);
+    if (tailBytes != 0) munmap((void *)(size_t(virtualAddr2X) + numBytes*2), tailBytes);
+    reserved = MAP_FAILED;
+
+    /*******************************************************************
+     * Step 4) prefer the NUMA node before the memory is first touched
+     ******************************************************************/
+    #if HAVE_LIBNUMA
+    if (nodeAffinity >= 0 and nodeAffinity < 1024 and numa_available() != -1)
+    {
+        unsigned long nodeMask[1024/(8*sizeof(unsigned long))] = {};
+        nodeMask[nodeAffinity/(8*sizeof(unsigned long))] |= 1UL << (nodeAffinity%(8*sizeof(unsigned long)));
+        mbind(mapPtr0, numBytes, MPOL_PREFERRED, nodeMask, 1024, 0); //best effort
+    }
+    #else
+    (void)nodeAffinity;
+    #endif
 }
 
 /***********************************************************************
@@ -222,9 +306,24 @@ Pothos::SharedBuffer Pothos::SharedBuffer::make(const size_t numBytes, const lon
     return SharedBuffer(address, numBytes, deleter);
 }
 
-Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numBytesIn, const long)
+Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numBytesIn, const long nodeAffinity, const bool hugePages)
 {
-    const size_t numBytes = ((numBytesIn + getpagesize() - 1)/getpagesize())*getpagesize();
-    std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes));
+    //huge pages: use a hugetlb memory file or fall-back to regular pages
+    //the allocation fails when the system has no huge pages reserved
+    const int hugeFd = hugePages?openMemoryFd(true):-1;
+    if (hugeFd >= 0) try
+    {
+        const size_t numBytes = ((numBytesIn + HUGE_PAGE_BYTES - 1)/HUGE_PAGE_BYTES)*HUGE_PAGE_BYTES;
+        std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes, hugeFd, HUGE_PAGE_BYTES, nodeAffinity));
+        return SharedBuffer(container->getAddress(), numBytes, container);
+    }
+    catch (const SharedBufferError &){}
+
+    //regular pages: use an anonymous memory file or fall-back to a temp file
+    const size_t pageSize = getpagesize();
+    const size_t numBytes = ((numBytesIn + pageSize - 1)/pageSize)*pageSize;
+    int fd = openMemoryFd(false);
+    if (fd < 0) fd = openTemporaryFd();
+    std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes, fd, pageSize, nodeAffinity));
     return SharedBuffer(container->getAddress(), numBytes, container);
 }
@@ -187,7 +187,7 @@ Pothos::SharedBuffer Pothos::SharedBuffer::make(const size_t numBytes, const lon
     return SharedBuffer(container->getAddress(), numBytes, container);
 }
 
-Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numBytesIn, const long nodeAffinity)
+Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numBytesIn, const long nodeAffinity, const bool)
 {
     const size_t numBytes = ((numBytesIn + getregionsize() - 1)/getregionsize())*getregionsize();
     std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes, nodeAffinity));
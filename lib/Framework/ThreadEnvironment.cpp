@@ -3,15 +3,23 @@
 
 #include "Framework/ThreadEnvironment.hpp"
 #include <Poco/Logger.h>
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 
 ThreadEnvironment::ThreadEnvironment(const Pothos::ThreadPoolArgs &args):
     _args(args),
     _waitModeEnabled(_args.yieldMode != "SPIN"),
-    _configurationSignature(0)
+    _stealModeEnabled(_args.yieldMode == "STEAL" and _args.numThreads != 0),
+    _configurationSignature(0),
+    _numSleepers(0),
+    _poolChanges(0),
+    _nextHome(0)
 {
-    return;
+    if (_stealModeEnabled) for (size_t i = 0; i < _args.numThreads; i++)
+    {
+        _readyQueues.emplace_back(new ReadyQueue());
+    }
 }
 
 ThreadEnvironment::~ThreadEnvironment(void)
@@ -34,7 +42,8 @@ void ThreadEnvironment::registerTask(void *handle, TaskData::Task task, TaskData
     //register the new task and bump the signature to notify threads
     {
         std::lock_guard<std::mutex> lock0(_handleUpdateMutex);
-        _handleToTask[handle].reset(new TaskData(task, wake));
+        const size_t home = _readyQueues.empty()?0:(_nextHome++ % _readyQueues.size());
+        _handleToTask[handle].reset(new TaskData(task, wake, home));
         _configurationSignature++;
     }
 
@@ -50,11 +59,19 @@ void ThreadEnvironment::registerTask(void *handle, TaskData::Task task, TaskData
         if (_threadPool.size() < _args.numThreads)
         {
             size_t index = _threadPool.size();
-            _threadPool.push_back(std::thread(std::bind(&ThreadEnvironment::poolProcessLoop, this, index)));
+            _threadPool.push_back(std::thread(std::bind(_stealModeEnabled?
+                &ThreadEnvironment::stealProcessLoop : &ThreadEnvironment::poolProcessLoop, this, index)));
         }
         assert(_threadPool.size() <= _args.numThreads);
     }
 
+    //steal mode: wake idle threads to accept the new config state
+    if (_stealModeEnabled)
+    {
+        std::lock_guard<std::mutex> lock0(_readyMutex);
+        _readyCond.notify_all();
+    }
+
     //restore wait mode
     std::swap(waitModeEnabled, _waitModeEnabled);
 }
@@ -79,6 +96,11 @@ void ThreadEnvironment::unregisterTask(void *handle)
     //wake every known task to accept the new config state
     data->wake();
     for (const auto &pair : _handleToTask) pair.second->wake();
+    if (_stealModeEnabled)
+    {
+        std::lock_guard<std::mutex> lock0(_readyMutex);
+        _readyCond.notify_all();
+    }
 
     //single task mode: stop the explicit task for this handle
     if (_args.numThreads == 0)
@@ -99,7 +121,13 @@ void ThreadEnvironment::unregisterTask(void *handle)
     }
 
     //wait for all threads to relinquish the old configuration
-    while (not data.unique()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    //steal mode: ready queues may hold references, purge them
+    while (not data.unique())
+    {
+        if (_stealModeEnabled) this->purgeReady(data);
+        if (data.unique()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 
     //restore wait mode
     std::swap(waitModeEnabled, _waitModeEnabled);
@@ -148,12 +176,30 @@ void wakeAllBusyTasks(const TasksType &tasks, void *self)
  * it must wake up all other potentially waiting threads.
  * This ensures that threads will be available to process
  * new tasks that are capable of performing useful work.
+ *
+ * The wait in a task has no timeout, so a change flagged
+ * in another task must also wake the waiting threads:
+ * Every flagged change counts up the pool change counter,
+ * and wakes all busy tasks when there are waiting threads.
+ * A thread registers as a waiter before it compares the counter
+ * with the value seen at the start of its failed acquisitions;
+ * so either the thread sees the change and scans again,
+ * or the change notification sees the thread and wakes it.
  */
 
+void ThreadEnvironment::notifyPoolChange(void)
+{
+    _poolChanges++;
+    if (_numSleepers.load() == 0) return;
+    std::lock_guard<std::mutex> lock(_handleUpdateMutex);
+    wakeAllBusyTasks(_handleToTask, nullptr);
+}
+
 void ThreadEnvironment::poolProcessLoop(size_t index)
 {
     this->applyThreadConfig();
     size_t failAcquireCount = 0;
+    size_t localChanges = 0;
     size_t localSignature = 0;
     std::map<void *, std::shared_ptr<TaskData>> localTasks;
     auto it = localTasks.end();
@@ -173,11 +219,17 @@ void ThreadEnvironment::poolProcessLoop(size_t index)
             if (index >= localTasks.size()) return;
         }
 
+        //remember the pool changes at the start of failed acquisitions
+        if (failAcquireCount == 0) localChanges = _poolChanges.load();
+
         //perform a task and increment
         if (it == localTasks.end()) it = localTasks.begin();
         if (not it->second->flag.test_and_set(std::memory_order_acquire))
         {
-            const bool waitOnce = _waitModeEnabled and failAcquireCount >= localTasks.size();
+            //register as a waiter, then only wait when no change was missed
+            const bool idle = _waitModeEnabled and failAcquireCount >= localTasks.size();
+            if (idle) _numSleepers++;
+            const bool waitOnce = idle and _poolChanges.load() == localChanges;
             if (it->second->task(waitOnce))
             {
                 //the task was successfully executed, wake all other potential blockers
@@ -185,7 +237,8 @@ void ThreadEnvironment::poolProcessLoop(size_t index)
                 failAcquireCount = 0; //reset fail count
             }
             else failAcquireCount++;
-            if (waitOnce) failAcquireCount = 0; //reset fail count
+            if (idle) _numSleepers--;
+            if (idle) failAcquireCount = 0; //reset fail count
             it->second->flag.clear(std::memory_order_release);
         }
         else failAcquireCount++;
@@ -193,6 +246,153 @@ void ThreadEnvironment::poolProcessLoop(size_t index)
     }
 }
 
+/*!
+ * Work stealing mechanics:
+ * Rather than probe every task in round-robin order,
+ * tasks are pushed onto a ready queue when a change is flagged.
+ * Threads only visit tasks from the ready queues, their own first,
+ * and idle threads steal from the ready queues of other threads.
+ * When all queues are empty, threads wait on a condition variable
+ * and are woken by the next task that becomes ready.
+ *
+ * The queued flag prevents duplicate entries in the ready queues.
+ * The flag is cleared before the task is run, so that changes flagged
+ * while the task runs will place the task back onto a ready queue.
+ * If the task is currently held by another thread, the rerun flag
+ * asks the holder to re-queue the task once it has been released.
+ */
+
+static thread_local ThreadEnvironment *currentStealEnv(nullptr);
+static thread_local size_t currentStealIndex(0);
+
+TaskData::Notify ThreadEnvironment::getReadyNotifier(void *handle)
+{
+    //pool mode with waiting: threads may wait in other tasks
+    if (not _stealModeEnabled)
+    {
+        if (_args.numThreads == 0 or _args.yieldMode == "SPIN") return TaskData::Notify();
+        return [this](void){this->notifyPoolChange();};
+    }
+
+    std::lock_guard<std::mutex> lock(_handleUpdateMutex);
+    auto data = _handleToTask.at(handle);
+    return [this, data](void){this->notifyReady(data);};
+}
+
+void ThreadEnvironment::notifyReady(const std::shared_ptr<TaskData> &data)
+{
+    //already in a ready queue, nothing to do
+    if (data->queued.exchange(true)) return;
+
+    //prefer the queue of the calling thread when its in this pool,
+    //otherwise use the queue of the thread that last ran the task
+    const size_t index = (currentStealEnv == this)?
+        currentStealIndex : data->home.load(std::memory_order_relaxed);
+    auto &queue = *_readyQueues[index];
+    {
+        std::lock_guard<Pothos::Util::SpinLock> lock(queue.lock);
+        queue.tasks.push_back(data);
+    }
+
+    //wake an idle thread to process or steal the task
+    if (_numSleepers.load() != 0)
+    {
+        std::lock_guard<std::mutex> lock(_readyMutex);
+        _readyCond.notify_one();
+    }
+}
+
+bool ThreadEnvironment::popReady(const size_t index, std::shared_ptr<TaskData> &data)
+{
+    const size_t numQueues = _readyQueues.size();
+    for (size_t i = 0; i < numQueues; i++)
+    {
+        auto &queue = *_readyQueues[(index+i)%numQueues];
+        std::lock_guard<Pothos::Util::SpinLock> lock(queue.lock);
+        if (queue.tasks.empty()) continue;
+        data = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadEnvironment::anyReady(void)
+{
+    for (const auto &queue : _readyQueues)
+    {
+        std::lock_guard<Pothos::Util::SpinLock> lock(queue->lock);
+        if (not queue->tasks.empty()) return true;
+    }
+    return false;
+}
+
+void ThreadEnvironment::purgeReady(const std::shared_ptr<TaskData> &data)
+{
+    for (const auto &queue : _readyQueues)
+    {
+        std::lock_guard<Pothos::Util::SpinLock> lock(queue->lock);
+        auto &tasks = queue->tasks;
+        tasks.erase(std::remove(tasks.begin(), tasks.end(), data), tasks.end());
+    }
+}
+
+void ThreadEnvironment::stealProcessLoop(size_t index)
+{
+    this->applyThreadConfig();
+    currentStealEnv = this;
+    currentStealIndex = index;
+    size_t localSignature = 0;
+    std::shared_ptr<TaskData> data;
+
+    while (true)
+    {
+        //check for a configuration change and update the local state
+        if (_configurationSignature != localSignature)
+        {
+            std::lock_guard<std::mutex> lock(_handleUpdateMutex);
+            localSignature = _configurationSignature;
+
+            //pool mode, index out of range
+            if (index >= _handleToTask.size()) break;
+        }
+
+        //no runnable tasks: wait for a task to be flagged or a config change
+        if (not this->popReady(index, data))
+        {
+            std::unique_lock<std::mutex> lock(_readyMutex);
+            _numSleepers++;
+            if (not this->anyReady() and _configurationSignature == localSignature) _readyCond.wait(lock);
+            _numSleepers--;
+            continue;
+        }
+
+        //clear queued so changes flagged from now on re-queue the task
+        data->queued.store(false);
+
+        //held by another thread: ask the holder to re-queue the task,
+        //then try once more in case the holder already released it
+        if (data->flag.test_and_set())
+        {
+            data->rerun.store(true);
+            if (data->flag.test_and_set())
+            {
+                data.reset();
+                continue;
+            }
+        }
+
+        //perform the task, it returns immediately without a change
+        data->home.store(index, std::memory_order_relaxed);
+        data->task(false);
+        data->flag.clear();
+        if (data->rerun.exchange(false)) this->notifyReady(data);
+        data.reset();
+    }
+
+    currentStealEnv = nullptr;
+}
+
 void ThreadEnvironment::singleProcessLoop(void *handle)
 {
     this->applyThreadConfig();
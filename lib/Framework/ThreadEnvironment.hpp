@@ -4,12 +4,15 @@
 #pragma once
 #include <Pothos/Config.hpp>
 #include <Pothos/Framework/ThreadPool.hpp>
+#include <Pothos/Util/SpinLock.hpp>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <functional>
 #include <atomic>
 #include <thread>
 #include <vector>
+#include <deque>
 #include <map>
 
 /*!
@@ -20,10 +23,14 @@ struct TaskData
 {
     typedef std::function<bool(bool)> Task;
     typedef std::function<void(void)> Wake;
+    typedef std::function<void(void)> Notify;
 
-    TaskData(const Task task, const Wake wake):
+    TaskData(const Task task, const Wake wake, const size_t home = 0):
         task(task),
-        wake(wake)
+        wake(wake),
+        queued(false),
+        rerun(false),
+        home(home)
     {
         flag.clear(std::memory_order_release);
     }
@@ -31,6 +38,26 @@ struct TaskData
     Task task;
     Wake wake;
     std::atomic_flag flag;
+
+    //! steal mode: true when the task is in a ready queue
+    std::atomic<bool> queued;
+
+    //! steal mode: ready while another thread held the flag
+    std::atomic<bool> rerun;
+
+    //! steal mode: index of the preferred ready queue
+    std::atomic<size_t> home;
+};
+
+/*!
+ * A ready queue of runnable tasks used in steal mode.
+ * Tasks are popped in FIFO order by the owner thread,
+ * idle threads steal from the queues of other threads.
+ */
+struct ReadyQueue
+{
+    Pothos::Util::SpinLock lock;
+    std::deque<std::shared_ptr<TaskData>> tasks;
 };
 
 /*!
@@ -58,6 +85,15 @@ public:
      */
     void unregisterTask(void *handle);
 
+    /*!
+     * Get a notifier which is called when the task flags a change.
+     * In steal mode, the notifier marks the task as runnable.
+     * In pool mode, the notifier wakes threads waiting in other tasks.
+     * Otherwise an empty function is returned.
+     * \param handle the unique handle used to register
+     */
+    TaskData::Notify getReadyNotifier(void *handle);
+
     //! Query the thread pool construction args
     const Pothos::ThreadPoolArgs &getArgs(void) const
     {
@@ -81,6 +117,29 @@ private:
      */
     void poolProcessLoop(size_t index);
 
+    /*!
+     * Process loop used in steal mode:
+     * Threads only visit tasks that were flagged as runnable,
+     * first from their own ready queue, then from other queues.
+     * The index specifies the thread and ready queue index.
+     */
+    void stealProcessLoop(size_t index);
+
+    //! Pool mode: wake threads waiting in tasks after a change
+    void notifyPoolChange(void);
+
+    //! Steal mode: push a runnable task onto a ready queue
+    void notifyReady(const std::shared_ptr<TaskData> &data);
+
+    //! Steal mode: pop a runnable task, own queue first
+    bool popReady(const size_t index, std::shared_ptr<TaskData> &data);
+
+    //! Steal mode: is any ready queue non-empty?
+    bool anyReady(void);
+
+    //! Steal mode: remove all references to this task
+    void purgeReady(const std::shared_ptr<TaskData> &data);
+
     /*!
      * Process loop used in thread per task mode.
      * If the handle is removed, the thread exists.
@@ -108,6 +167,9 @@ private:
     //whether or not waiting is allowed based on args
     bool _waitModeEnabled;
 
+    //whether or not the pool uses work stealing based on args
+    const bool _stealModeEnabled;
+
     //map of handle handles to tasks
     std::map<void *, std::shared_ptr<TaskData>> _handleToTask;
 
@@ -125,4 +187,20 @@ private:
 
     //per-thread process loop done flags (used in thread pool mode)
     std::vector<std::thread> _threadPool;
+
+    //per-thread ready queues (used in steal mode)
+    std::vector<std::unique_ptr<ReadyQueue>> _readyQueues;
+
+    //idle thread waiting (used in steal mode)
+    std::mutex _readyMutex;
+    std::condition_variable _readyCond;
+
+    //count of waiting threads (used in steal and pool mode)
+    std::atomic<size_t> _numSleepers;
+
+    //count of changes flagged by any task (used in pool mode)
+    std::atomic<size_t> _poolChanges;
+
+    //round robin home queue assignment (used in steal mode)
+    size_t _nextHome;
 };
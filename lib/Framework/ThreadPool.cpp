@@ -10,21 +10,33 @@ using json = nlohmann::json;
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(void):
     numThreads(0),
-    priority(0.0)
+    priority(0.0),
+    burstIterations(1),
+    burstTime(0.0),
+    adaptiveBuffers(false),
+    circularFanout(false)
 {
     return;
 }
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(const size_t numThreads):
     numThreads(numThreads),
-    priority(0.0)
+    priority(0.0),
+    burstIterations(1),
+    burstTime(0.0),
+    adaptiveBuffers(false),
+    circularFanout(false)
 {
     return;
 }
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(const std::string &jsonStr):
     numThreads(0),
-    priority(0.0)
+    priority(0.0),
+    burstIterations(1),
+    burstTime(0.0),
+    adaptiveBuffers(false),
+    circularFanout(false)
 {
     //parse to JSON object
     const auto topObj = json::parse(jsonStr);
@@ -34,6 +46,10 @@ Pothos::ThreadPoolArgs::ThreadPoolArgs(const std::string &jsonStr):
     this->priority = topObj.value("priority", 0.0);
     this->affinityMode = topObj.value("affinityMode", "");
     this->yieldMode = topObj.value("yieldMode", "");
+    this->burstIterations = topObj.value("burstIterations", size_t(1));
+    this->burstTime = topObj.value("burstTime", 0.0);
+    this->adaptiveBuffers = topObj.value("adaptiveBuffers", false);
+    this->circularFanout = topObj.value("circularFanout", false);
 
     //parse out the affinity list
     this->affinity = topObj.value("affinity", std::vector<size_t>());
@@ -57,6 +73,7 @@ Pothos::ThreadPool::ThreadPool(const ThreadPoolArgs &args)
     else if (args.affinityMode == "ALL"){}
     else if (args.affinityMode == "CPU"){}
     else if (args.affinityMode == "NUMA"){}
+    else if (args.affinityMode == "AUTO"){}
     else throw ThreadPoolError("Pothos::ThreadPool()", "unknown affinityMode " + args.affinityMode);
 
     //validate the yield strategy
@@ -64,6 +81,7 @@ Pothos::ThreadPool::ThreadPool(const ThreadPoolArgs &args)
     else if (args.yieldMode == "CONDITION"){}
     else if (args.yieldMode == "HYBRID"){}
     else if (args.yieldMode == "SPIN"){}
+    else if (args.yieldMode == "STEAL"){}
     else throw ThreadPoolError("Pothos::ThreadPool()", "unknown yieldMode " + args.yieldMode);
 
     //validate the thread priority
@@ -72,6 +90,16 @@ Pothos::ThreadPool::ThreadPool(const ThreadPoolArgs &args)
         throw ThreadPoolError("Pothos::ThreadPool()", "priority out of range " + std::to_string(args.priority));
     }
 
+    //validate the burst policy
+    if (args.burstIterations == 0)
+    {
+        throw ThreadPoolError("Pothos::ThreadPool()", "burstIterations must be positive");
+    }
+    if (args.burstTime < 0.0)
+    {
+        throw ThreadPoolError("Pothos::ThreadPool()", "burstTime is negative " + std::to_string(args.burstTime));
+    }
+
     //safe to create the thread environment
     _impl.reset(new ThreadEnvironment(args));
 }
@@ -102,6 +130,10 @@ static auto managedThreadPoolArgs = Pothos::ManagedClass()
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, affinityMode))
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, affinity))
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, yieldMode))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, burstIterations))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, burstTime))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, adaptiveBuffers))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, circularFanout))
     .commit("Pothos/ThreadPoolArgs");
 
 static auto managedThreadPool = Pothos::ManagedClass()
@@ -123,6 +155,10 @@ void serialize(Archive &ar, Pothos::ThreadPoolArgs &t, const unsigned int)
     ar & t.affinityMode;
     ar & t.affinity;
     ar & t.yieldMode;
+    ar & t.burstIterations;
+    ar & t.burstTime;
+    ar & t.adaptiveBuffers;
+    ar & t.circularFanout;
 }
 }}
 
@@ -65,6 +65,8 @@ Port Pothos::Topology::Impl::makePort(const Pothos::Proxy &obj, const std::strin
 
 void Pothos::Topology::setThreadPool(const ThreadPool &threadPool)
 {
+    //the placement pools were derived from the previous pool's args
+    if (_impl->threadPool != threadPool) _impl->placementPools.clear();
     _impl->threadPool = threadPool;
 }
 
@@ -73,6 +75,16 @@ const Pothos::ThreadPool &Pothos::Topology::getThreadPool(void) const
     return _impl->threadPool;
 }
 
+void Pothos::Topology::setSharedMemoryCapacity(const size_t numBytes)
+{
+    _impl->sharedMemoryCapacity = numBytes;
+}
+
+size_t Pothos::Topology::getSharedMemoryCapacity(void) const
+{
+    return _impl->sharedMemoryCapacity;
+}
+
 void Pothos::Topology::setInputAlias(const std::string &portName, const std::string &alias)
 {
     if (_impl->inputPortInfo.count(portName) == 0) throw PortAccessError(
@@ -352,6 +364,8 @@ static auto managedTopology = Pothos::ManagedClass()
     .registerMethod("resolveFlows", &resolveFlowsFromTopology)
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, setThreadPool))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, getThreadPool))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, setSharedMemoryCapacity))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, getSharedMemoryCapacity))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, commit))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, disconnectAll))
     .registerMethod("disconnectAll", Pothos::Callable(&Pothos::Topology::disconnectAll).bind(false, 1))
@@ -0,0 +1,187 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Framework/TopologyImpl.hpp"
+#include "Framework/ThreadEnvironment.hpp"
+#include <Pothos/Framework/Block.hpp>
+#include <Pothos/Framework/OutputPort.hpp>
+#include <Pothos/Framework/Exception.hpp>
+#include <Pothos/System/NumaInfo.hpp>
+#include <Pothos/Proxy.hpp>
+#include <algorithm>
+#include <map>
+
+/***********************************************************************
+ * Partition the local flow graph across NUMA nodes:
+ * The graph is seeded by splitting a depth-first traversal
+ * from the sources into equal sized contiguous groups,
+ * so that chains of blocks begin on the same node.
+ * Then blocks are greedily moved or swapped to the node
+ * where most of their connected bandwidth lives,
+ * within a balance limit on the number of blocks per node.
+ * The edge weight is the dtype size of the source port,
+ * as a proxy for the bytes that would cross the node boundary.
+ **********************************************************************/
+static std::vector<size_t> partitionFlowGraph(
+    const std::vector<std::map<size_t, size_t>> &adjacency,
+    const std::vector<bool> &isSource,
+    const size_t numParts)
+{
+    const size_t numBlocks = adjacency.size();
+    std::vector<size_t> part(numBlocks, 0);
+    if (numParts <= 1 or numBlocks == 0) return part;
+
+    //depth first ordering starting from the sources
+    std::vector<size_t> order;
+    std::vector<bool> visited(numBlocks, false);
+    for (const bool sourcesOnly : {true, false})
+    {
+        for (size_t start = 0; start < numBlocks; start++)
+        {
+            if (visited[start] or (sourcesOnly and not isSource[start])) continue;
+            std::vector<size_t> stack(1, start);
+            while (not stack.empty())
+            {
+                const auto v = stack.back(); stack.pop_back();
+                if (visited[v]) continue;
+                visited[v] = true;
+                order.push_back(v);
+                for (auto it = adjacency[v].rbegin(); it != adjacency[v].rend(); ++it)
+                {
+                    if (not visited[it->first]) stack.push_back(it->first);
+                }
+            }
+        }
+    }
+
+    //seed with contiguous groups of the traversal
+    const size_t capacity = (numBlocks + numParts - 1)/numParts;
+    const size_t maxSize = capacity + capacity/8;
+    std::vector<size_t> sizes(numParts, 0);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        part[order[i]] = i/capacity;
+        sizes[i/capacity]++;
+    }
+
+    //the reduction in cut weight when moving v into part p
+    const auto gain = [&](const size_t v, const size_t p)
+    {
+        long long g = 0;
+        for (const auto &edge : adjacency[v])
+        {
+            if (part[edge.first] == p) g += edge.second;
+            else if (part[edge.first] == part[v]) g -= edge.second;
+        }
+        return g;
+    };
+
+    //greedy refinement: move or swap blocks to reduce the cut weight
+    for (size_t pass = 0; pass < 8; pass++)
+    {
+        bool moved = false;
+        for (const auto v : order)
+        {
+            for (size_t p = 0; p < numParts; p++)
+            {
+                if (p == part[v]) continue;
+                const auto g = gain(v, p);
+                if (g <= 0) continue;
+
+                //move when there is room in the other part
+                if (sizes[p] < maxSize)
+                {
+                    sizes[part[v]]--;
+                    sizes[p]++;
+                    part[v] = p;
+                    moved = true;
+                    break;
+                }
+
+                //otherwise find the best block to swap places with
+                size_t swapWith = numBlocks;
+                long long bestGain = 0;
+                for (size_t u = 0; u < numBlocks; u++)
+                {
+                    if (part[u] != p) continue;
+                    const auto uvIt = adjacency[v].find(u);
+                    const long long uv = (uvIt == adjacency[v].end())?0:uvIt->second;
+                    const auto swapGain = g + gain(u, part[v]) - 2*uv;
+                    if (swapGain > bestGain) {bestGain = swapGain; swapWith = u;}
+                }
+                if (swapWith == numBlocks) continue;
+                part[swapWith] = part[v];
+                part[v] = p;
+                moved = true;
+                break;
+            }
+        }
+        if (not moved) break;
+    }
+
+    return part;
+}
+
+/***********************************************************************
+ * Automatic placement of local blocks onto per-node thread pools
+ **********************************************************************/
+void Pothos::Topology::Impl::autoPlacement(const std::vector<Flow> &flatFlows)
+{
+    const auto localUpid = Pothos::ProxyEnvironment::getLocalUniquePid();
+
+    //enumerate the local blocks
+    std::map<std::string, size_t> uidToIndex;
+    std::vector<Block *> blocks;
+    std::vector<std::string> uids;
+    for (const auto &obj : getObjSetFromFlowList(flatFlows))
+    {
+        if (obj.getEnvironment()->getUniquePid() != localUpid) continue;
+        const auto uid = obj.call<std::string>("uid");
+        uidToIndex[uid] = blocks.size();
+        blocks.push_back(obj.call<Block *>("getPointer"));
+        uids.push_back(uid);
+    }
+
+    //build the undirected graph with dtype size weights
+    std::vector<std::map<size_t, size_t>> adjacency(blocks.size());
+    std::vector<bool> isSource(blocks.size(), true);
+    for (const auto &flow : flatFlows)
+    {
+        const auto srcIt = uidToIndex.find(flow.src.uid);
+        const auto dstIt = uidToIndex.find(flow.dst.uid);
+        if (srcIt == uidToIndex.end() or dstIt == uidToIndex.end()) continue;
+        const auto src = srcIt->second, dst = dstIt->second;
+        const size_t weight = std::max<size_t>(1, blocks[src]->output(flow.src.name)->dtype().size());
+        adjacency[src][dst] += weight;
+        adjacency[dst][src] += weight;
+        isSource[dst] = false;
+    }
+
+    //the candidate nodes are those with CPUs
+    std::vector<size_t> nodes;
+    for (const auto &info : Pothos::System::NumaInfo::get())
+    {
+        if (not info.cpus.empty()) nodes.push_back(info.nodeNumber);
+    }
+    const bool haveNumaInfo = not nodes.empty();
+    if (not haveNumaInfo) nodes.push_back(0);
+
+    //partition and create a thread pool for each used node
+    const auto part = partitionFlowGraph(adjacency, isSource, nodes.size());
+    const auto &topArgs = std::static_pointer_cast<ThreadEnvironment>(threadPool.getContainer())->getArgs();
+    placementNodes.clear();
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        const auto node = nodes[part[i]];
+        auto &pool = placementPools[node];
+        if (not pool)
+        {
+            ThreadPoolArgs args(topArgs);
+            args.affinityMode = haveNumaInfo?"NUMA":"ALL";
+            args.affinity = haveNumaInfo?std::vector<size_t>(1, node):std::vector<size_t>();
+            pool = ThreadPool(args);
+        }
+        placementNodes[uids[i]] = node;
+        blocks[i]->setThreadPool(pool);
+    }
+}
@@ -2,19 +2,21 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
+#include "Framework/ThreadEnvironment.hpp"
 #include <Pothos/Framework/Block.hpp>
 #include <Pothos/Framework/Exception.hpp>
 #include <Poco/Format.h>
+#include <algorithm>
 #include <iostream>
 #include <future>
 
 struct FutureInfo
 {
-    FutureInfo(const std::string &what, const Pothos::Proxy &block, const std::shared_future<void> &result):
+    FutureInfo(const std::string &what, const Pothos::Proxy &block, const ProxyFuture &result):
         what(what), block(block), result(result){}
     std::string what;
     Pothos::Proxy block;
-    std::shared_future<void> result;
+    ProxyFuture result;
 };
 
 std::string collectFutureInfoErrors(const std::vector<FutureInfo> infoFutures)
@@ -37,22 +39,14 @@ std::string collectFutureInfoErrors(const std::vector<FutureInfo> infoFutures)
 /***********************************************************************
  * helpers to deal with buffer managers
  **********************************************************************/
-static std::string getBufferMode(const Port &port, const std::string &domain, const bool &isInput)
+struct BufferManagerInstall
 {
-    auto actor = port.obj.get("_actor");
-    return actor.call("getBufferMode", port.name, domain, isInput);
-}
-
-static Pothos::Proxy getBufferManager(const Port &port, const std::string &domain, const bool &isInput)
-{
-    auto actor = port.obj.get("_actor");
-    return actor.call("getBufferManager", port.name, domain, isInput);
-}
-
-static void setOutputBufferManager(const Port &src, const Pothos::Proxy &manager)
-{
-    src.obj.get("_actor").call("setOutputBufferManager", src.name, manager);
-}
+    Port src;
+    std::vector<Port> dsts;
+    ProxyFuture srcActor, srcPort, srcDomain, srcMode;
+    std::vector<ProxyFuture> dstActors, dstPorts, dstDomains, dstModes;
+    ProxyFuture manager;
+};
 
 static void installBufferManagers(const std::vector<Flow> &flatFlows)
 {
@@ -60,50 +54,85 @@ static void installBufferManagers(const std::vector<Flow> &flatFlows)
     std::unordered_map<Port, std::vector<Port>> srcs;
     for (const auto &flow : flatFlows)
     {
-        for (const auto &subFlow : flatFlows)
+        auto &dsts = srcs[flow.src];
+        if (std::find(dsts.begin(), dsts.end(), flow.dst) == dsts.end()) dsts.push_back(flow.dst);
+    }
+
+    //query the actors and ports for all source ports
+    std::vector<BufferManagerInstall> installs;
+    for (const auto &pair : srcs)
+    {
+        BufferManagerInstall install;
+        install.src = pair.first;
+        install.dsts = pair.second;
+        install.srcActor = pipelineCall(install.src.obj, "get:_actor");
+        install.srcPort = pipelineCall(install.src.obj, "output", install.src.name);
+        for (const auto &dst : install.dsts)
         {
-            if (subFlow.src == flow.src) srcs[flow.src].push_back(subFlow.dst);
+            install.dstActors.push_back(pipelineCall(dst.obj, "get:_actor"));
+            install.dstPorts.push_back(pipelineCall(dst.obj, "input", dst.name));
         }
+        installs.push_back(install);
     }
 
-    //result list is used to ack all install messages
-    std::vector<FutureInfo> infoFutures;
+    //query the domains given the ports
+    for (auto &install : installs)
+    {
+        install.srcDomain = pipelineCall(install.srcPort, "domain");
+        for (const auto &dstPort : install.dstPorts)
+        {
+            install.dstDomains.push_back(pipelineCall(dstPort, "domain"));
+        }
+    }
 
-    //for each source port -- install managers
-    for (const auto &pair : srcs)
+    //query the buffer modes given the domains
+    for (auto &install : installs)
     {
-        auto src = pair.first;
-        auto dsts = pair.second;
-        auto dst = dsts.at(0);
-        Pothos::Proxy manager;
+        install.srcMode = pipelineCall(install.srcActor, "getBufferMode", install.src.name, install.dstDomains.at(0), false);
+        install.dstModes.push_back(pipelineCall(install.dstActors.at(0), "getBufferMode", install.dsts.at(0).name, install.srcDomain, true));
+    }
 
-        std::string srcDomain = src.obj.call("output", src.name).call("domain");
-        std::string dstDomain = dst.obj.call("input", dst.name).call("domain");
+    //the other destinations are only queried when the first destination provides a manager
+    for (auto &install : installs)
+    {
+        if (install.srcMode.get().convert<std::string>() == "CUSTOM") continue;
+        if (install.dstModes.at(0).get().convert<std::string>() != "CUSTOM") continue;
+        for (size_t i = 1; i < install.dsts.size(); i++)
+        {
+            install.dstModes.push_back(pipelineCall(install.dstActors[i], "getBufferMode", install.dsts[i].name, install.srcDomain, true));
+        }
+    }
 
-        auto srcMode = getBufferMode(src, dstDomain, false);
-        auto dstMode = getBufferMode(dst, srcDomain, true);
+    //for each source port -- get managers
+    for (auto &install : installs)
+    {
+        const auto &src = install.src;
+        const auto &dsts = install.dsts;
+        const auto &dst = dsts.at(0);
+        const std::string srcMode = install.srcMode.get().convert<std::string>();
+        const std::string dstMode = install.dstModes.at(0).get().convert<std::string>();
 
         //check if the source provides a manager and install it to the source
         if (srcMode == "CUSTOM")
         {
-            manager = getBufferManager(src, dstDomain, false);
+            install.manager = pipelineCall(install.srcActor, "getBufferManager", src.name, install.dstDomains.at(0), false);
         }
 
         //check if the destination provides a manager and install it to the source
         else if (dstMode == "CUSTOM")
         {
-            for (const auto &otherDst : dsts)
+            for (size_t i = 1; i < dsts.size(); i++)
             {
-                if (otherDst == dst) continue;
-                std::string otherDstDomain = otherDst.obj.call("input", otherDst.name).call("domain");
-                if (getBufferMode(otherDst, srcDomain, true) != "ABDICATE" and not otherDstDomain.empty())
+                const std::string otherDstDomain = install.dstDomains[i].get().convert<std::string>();
+                const std::string otherDstMode = install.dstModes[i].get().convert<std::string>();
+                if (otherDstMode != "ABDICATE" and not otherDstDomain.empty())
                 {
                     throw Pothos::Exception("Pothos::Topology::installBufferManagers", Poco::format("%s->%s\n"
                         "rectifyDomainFlows() logic does not /yet/ handle multiple destinations w/ custom buffer managers",
-                        src.toString(), otherDst.toString()));
+                        src.toString(), dsts[i].toString()));
                 }
             }
-            manager = getBufferManager(dst, srcDomain, true);
+            install.manager = pipelineCall(install.dstActors.at(0), "getBufferManager", dst.name, install.srcDomain, true);
         }
 
         //otherwise create a generic manager and install it to the source
@@ -111,11 +140,16 @@ static void installBufferManagers(const std::vector<Flow> &flatFlows)
         {
             assert(srcMode == "ABDICATE"); //this must be true if the previous logic was good
             assert(dstMode == "ABDICATE");
-            manager = getBufferManager(src, dstDomain, false);
+            install.manager = pipelineCall(install.srcActor, "getBufferManager", src.name, install.dstDomains.at(0), false);
         }
+    }
 
-        std::shared_future<void> result(std::async(std::launch::async, setOutputBufferManager, src, manager));
-        infoFutures.push_back(FutureInfo(Poco::format("setOutputBufferManager(%s)", src.name), src.obj, result));
+    //result list is used to ack all install messages
+    std::vector<FutureInfo> infoFutures;
+    for (const auto &install : installs)
+    {
+        auto result = concurrentCall(install.srcActor, "setOutputBufferManager", install.src.name, install.manager);
+        infoFutures.push_back(FutureInfo(Poco::format("setOutputBufferManager(%s)", install.src.name), install.src.obj, result));
     }
 
     //check all subscribe message results
@@ -126,28 +160,29 @@ static void installBufferManagers(const std::vector<Flow> &flatFlows)
 /***********************************************************************
  * Helpers to implement port subscription
  **********************************************************************/
-static void subscribePort(const Port &src, const Port &dst, const std::string &action)
+static void updateFlows(const std::vector<Flow> &flows, const std::string &action)
 {
+    //query the actors and ports for all flows
+    std::vector<ProxyFuture> srcActors, dstActors, srcPorts, dstPorts;
+    for (const auto &flow : flows)
     {
-        auto actor = src.obj.get("_actor");
-        actor.call("subscribeInput", action, src.name, dst.obj.call("input", dst.name));
-    }
-    {
-        auto actor = dst.obj.get("_actor");
-        actor.call("subscribeOutput", action, dst.name, src.obj.call("output", src.name));
+        srcActors.push_back(pipelineCall(flow.src.obj, "get:_actor"));
+        dstActors.push_back(pipelineCall(flow.dst.obj, "get:_actor"));
+        srcPorts.push_back(pipelineCall(flow.src.obj, "output", flow.src.name));
+        dstPorts.push_back(pipelineCall(flow.dst.obj, "input", flow.dst.name));
     }
-}
 
-static void updateFlows(const std::vector<Flow> &flows, const std::string &action)
-{
     //result list is used to ack all subscribe messages
     std::vector<FutureInfo> infoFutures;
 
     //add new data acceptors
-    for (const auto &flow : flows)
+    for (size_t i = 0; i < flows.size(); i++)
     {
-        std::shared_future<void> result(std::async(std::launch::async, subscribePort, flow.src, flow.dst, action));
-        infoFutures.push_back(FutureInfo(action, flow.src.obj, result));
+        const auto &flow = flows[i];
+        infoFutures.push_back(FutureInfo(action, flow.src.obj,
+            concurrentCall(srcActors[i], "subscribeInput", action, flow.src.name, dstPorts[i])));
+        infoFutures.push_back(FutureInfo(action, flow.src.obj,
+            concurrentCall(dstActors[i], "subscribeOutput", action, flow.dst.name, srcPorts[i])));
     }
 
     //check all subscribe message results
@@ -199,9 +234,15 @@ static std::vector<Flow> completePassThroughFlows(const std::vector<Flow> &flows
 /***********************************************************************
  * Sub Topology commit on flattened flows
  **********************************************************************/
-static void setActiveState(const Pothos::Proxy &block, const bool state)
+static void setActiveState(const std::vector<Pothos::Proxy> &blocks, const bool state, std::vector<FutureInfo> &infoFutures)
 {
-    block.get("_actor").call(state?"setActiveStateOn":"setActiveStateOff");
+    std::vector<ProxyFuture> actors;
+    for (const auto &block : blocks) actors.push_back(pipelineCall(block, "get:_actor"));
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        auto result = concurrentCall(actors[i], state?"setActiveStateOn":"setActiveStateOff");
+        infoFutures.push_back(FutureInfo(state?"activate()":"deactivate()", blocks[i], result));
+    }
 }
 
 void topologySubCommit(Pothos::Topology &topology)
@@ -238,21 +279,13 @@ void topologySubCommit(Pothos::Topology &topology)
     std::vector<FutureInfo> infoFutures;
 
     //send activate to all new blocks not already in active flows
-    for (auto block : getObjSetFromFlowList(newFlows, activeFlatFlows))
-    {
-        std::shared_future<void> result(std::async(std::launch::async, setActiveState, block, true));
-        infoFutures.push_back(FutureInfo("activate()", block, result));
-    }
+    setActiveState(getObjSetFromFlowList(newFlows, activeFlatFlows), true, infoFutures);
 
     //update current flows
     _impl->activeFlatFlows = flatFlows;
 
     //send deactivate to all old blocks not in current active flows
-    for (auto block : getObjSetFromFlowList(oldFlows, _impl->activeFlatFlows))
-    {
-        std::shared_future<void> result(std::async(std::launch::async, setActiveState, block, false));
-        infoFutures.push_back(FutureInfo("deactivate()", block, result));
-    }
+    setActiveState(getObjSetFromFlowList(oldFlows, _impl->activeFlatFlows), false, infoFutures);
 
     //check all de/activate message results
     const auto errors = collectFutureInfoErrors(infoFutures);
@@ -281,6 +314,13 @@ void Pothos::Topology::commit(void)
     //3) deal with domain crossing
     flatFlows = _impl->rectifyDomainFlows(flatFlows);
 
+    //automatic placement sets the thread pools before the commit,
+    //so that buffer managers are allocated on the placement node
+    const bool autoPlacement = this->getThreadPool() and std::static_pointer_cast<ThreadEnvironment>(
+        this->getThreadPool().getContainer())->getArgs().affinityMode == "AUTO";
+    if (autoPlacement) _impl->autoPlacement(flatFlows);
+    else _impl->placementNodes.clear();
+
     //create remote topologies for all environments
     for (const auto &obj : getObjSetFromFlowList(flatFlows))
     {
@@ -290,15 +330,17 @@ void Pothos::Topology::commit(void)
     }
 
     //clear connections on old topologies
-    for (const auto &pair : _impl->remoteTopologies) pair.second.call("disconnectAll");
+    std::vector<std::future<Proxy>> results;
+    for (const auto &pair : _impl->remoteTopologies) results.push_back(pair.second.callAsync("disconnectAll"));
 
     //load each topology with connections from flat flows
     for (const auto &flow : flatFlows)
     {
         auto upid = flow.src.obj.getEnvironment()->getUniquePid();
         assert(upid == flow.dst.obj.getEnvironment()->getUniquePid());
-        _impl->remoteTopologies[upid].call("connect", flow.src.obj, flow.src.name, flow.dst.obj, flow.dst.name);
+        results.push_back(_impl->remoteTopologies[upid].callAsync("connect", flow.src.obj, flow.src.name, flow.dst.obj, flow.dst.name));
     }
+    for (auto &result : results) result.get();
 
     //Call commit on all sub-topologies:
     //Use futures so all sub-topologies commit at the same time,
@@ -322,7 +364,7 @@ void Pothos::Topology::commit(void)
     if (not errors.empty()) throw Pothos::TopologyConnectError("Pothos::Topology::commit()", errors);
 
     //set thread pools for all blocks in this process
-    if (this->getThreadPool()) for (auto block : getObjSetFromFlowList(flatFlows))
+    if (this->getThreadPool() and not autoPlacement) for (auto block : getObjSetFromFlowList(flatFlows))
     {
         if (block.getEnvironment()->getUniquePid() != Pothos::ProxyEnvironment::getLocalUniquePid()) continue; //is the block local?
         block.call<Block *>("getPointer")->setThreadPool(this->getThreadPool());
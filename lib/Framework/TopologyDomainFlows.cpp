@@ -2,55 +2,109 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
-#include <future>
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <set>
 
 /***********************************************************************
  * helpers to call into remote worker
  **********************************************************************/
-static std::string getBufferMode(const Port &port, const std::string &domain, const bool &isInput)
+class PortQueries
 {
-    auto actor = port.obj.get("_actor");
-    return actor.call("getBufferMode", port.name, domain, isInput);
-}
+public:
+    //! issue the query for the domain of a port once
+    void queryDomain(const Port &port, const bool isInput)
+    {
+        auto &domain = _domains[isInput][port];
+        if (not domain.valid()) domain = pipelineCall(pipelineCall(port.obj, isInput?"input":"output", port.name), "domain");
+    }
 
-static std::string getDomain(const Port &port, const bool &isInput)
-{
-    return port.obj.call(isInput?"input":"output", port.name).call("domain");
-}
+    //! get the result of the domain query
+    std::string getDomain(const Port &port, const bool isInput)
+    {
+        this->queryDomain(port, isInput);
+        auto &value = _domainValues[isInput];
+        auto it = value.find(port);
+        if (it != value.end()) return it->second;
+        return value[port] = _domains[isInput][port].get().convert<std::string>();
+    }
+
+    //! issue the query for the buffer mode of a port
+    ProxyFuture queryBufferMode(const Port &port, const std::string &domain, const bool isInput)
+    {
+        auto &actor = _actors[port.uid];
+        if (not actor.valid()) actor = pipelineCall(port.obj, "get:_actor");
+        return pipelineCall(actor, "getBufferMode", port.name, domain, isInput);
+    }
+
+private:
+    std::map<bool, std::unordered_map<Port, ProxyFuture>> _domains;
+    std::map<bool, std::unordered_map<Port, std::string>> _domainValues;
+    std::map<std::string, ProxyFuture> _actors;
+};
 
 /***********************************************************************
  * helpers to deal with domain interaction
  **********************************************************************/
+struct DomainInspection
+{
+    Port mainPort;
+    std::vector<Port> subPorts;
+    bool isInput;
+    std::string mainDomain;
+    std::set<std::string> subDomains;
+    std::vector<ProxyFuture> subModes;
+    ProxyFuture mainMode;
+};
 
 /*!
- * Is this domain crossing possible between mainPort and all connected subPorts?
+ * Issue the buffer mode queries to inspect a port for domain crossing.
  */
-static bool isDomainCrossingAcceptable(
+static DomainInspection inspectDomainCrossing(
+    PortQueries &queries,
     const Port &mainPort,
     const std::vector<Port> &subPorts,
     const bool isInput
 )
 {
-    auto mainDomain = getDomain(mainPort, isInput);
+    DomainInspection inspection;
+    inspection.mainPort = mainPort;
+    inspection.subPorts = subPorts;
+    inspection.isInput = isInput;
+    inspection.mainDomain = queries.getDomain(mainPort, isInput);
+    for (const auto &subPort : subPorts)
+    {
+        inspection.subDomains.insert(queries.getDomain(subPort, not isInput));
+        inspection.subModes.push_back(queries.queryBufferMode(subPort, inspection.mainDomain, not isInput));
+    }
+
+    //the main mode is only needed for a single sub domain
+    if (inspection.subDomains.size() == 1)
+    {
+        inspection.mainMode = queries.queryBufferMode(mainPort, *inspection.subDomains.begin(), isInput);
+    }
+    return inspection;
+}
+
+/*!
+ * Is this domain crossing possible between mainPort and all connected subPorts?
+ */
+static bool isDomainCrossingAcceptable(const DomainInspection &inspection)
+{
+    const bool isInput = inspection.isInput;
 
     bool allOthersAbdicate = true;
-    std::set<std::string> subDomains;
-    for (const auto &subPort : subPorts)
+    for (const auto &subMode : inspection.subModes)
     {
-        subDomains.insert(getDomain(subPort, not isInput));
-        const auto subMode = getBufferMode(subPort, mainDomain, not isInput);
-        if (subMode != "ABDICATE") allOthersAbdicate = false;
+        if (subMode.get().convert<std::string>() != "ABDICATE") allOthersAbdicate = false;
     }
 
     //can't handle multiple domains
-    if (subDomains.size() > 1) return false;
+    if (inspection.subDomains.size() > 1) return false;
 
-    assert(subDomains.size() == 1);
-    const auto subDomain = *subDomains.begin();
-    const auto mainMode = getBufferMode(mainPort, subDomain, isInput);
+    assert(inspection.subDomains.size() == 1);
+    const auto mainMode = inspection.mainMode.get().convert<std::string>();
 
     //error always means we make a copy block
     if (mainMode == "ERROR") return false;
@@ -62,7 +116,7 @@ static bool isDomainCrossingAcceptable(
     assert(mainMode == "CUSTOM");
 
     //can't handle custom with multiple upstream
-    if (isInput and mainMode == "CUSTOM" and subPorts.size() > 1) return false;
+    if (isInput and mainMode == "CUSTOM" and inspection.subPorts.size() > 1) return false;
 
     //if custom, the sub ports must abdicate
     if (mainMode == "CUSTOM" and not allOthersAbdicate) return false;
@@ -74,32 +128,41 @@ static bool isDomainCrossingAcceptable(
  * Get a copier block for a domain crossing between mainPort and all connected subPorts.
  * If the copier block is not needed to handle this domain crossing, return a null Proxy.
  */
-static Pothos::Proxy getCopierForDomainCrossing(
-    const Port &mainPort,
-    const std::vector<Port> &subPorts,
-    const bool isInput
-)
+static Pothos::Proxy getCopierForDomainCrossing(const DomainInspection &inspection)
 {
-    if (isDomainCrossingAcceptable(mainPort, subPorts, isInput)) return Pothos::Proxy();
-    auto registry = mainPort.obj.getEnvironment()->findProxy("Pothos/BlockRegistry");
+    if (isDomainCrossingAcceptable(inspection)) return Pothos::Proxy();
+    auto registry = inspection.mainPort.obj.getEnvironment()->findProxy("Pothos/BlockRegistry");
     auto copier = registry.call("/blocks/copier");
     copier.call("setName", "DomainBridge");
     return copier;
 }
 
 /*!
- * Get a future for each port to inspect it for domain crossing.
+ * Inspect each port for domain crossing and get its copier block.
+ * The queries for all ports are issued before waiting on any results.
  */
-static std::unordered_map<Port, std::shared_future<Pothos::Proxy>> domainInspection(
+static std::unordered_map<Port, Pothos::Proxy> domainInspection(
+    PortQueries &queries,
     const std::unordered_map<Port, std::vector<Port>> &ports,
     const bool isInput
 )
 {
-    std::unordered_map<Port, std::shared_future<Pothos::Proxy>> copiers;
     for (const auto &pair : ports)
     {
-        copiers[pair.first] = std::async(std::launch::async,
-            &getCopierForDomainCrossing, pair.first, pair.second, isInput);
+        queries.queryDomain(pair.first, isInput);
+        for (const auto &subPort : pair.second) queries.queryDomain(subPort, not isInput);
+    }
+
+    std::vector<DomainInspection> inspections;
+    for (const auto &pair : ports)
+    {
+        inspections.push_back(inspectDomainCrossing(queries, pair.first, pair.second, isInput));
+    }
+
+    std::unordered_map<Port, Pothos::Proxy> copiers;
+    for (const auto &inspection : inspections)
+    {
+        copiers[inspection.mainPort] = getCopierForDomainCrossing(inspection);
     }
     return copiers;
 }
@@ -121,14 +184,15 @@ std::vector<Flow> Pothos::Topology::Impl::rectifyDomainFlows(const std::vector<F
     }
 
     //get a list of ports with domain problems
-    auto badSrcsToCopier = domainInspection(srcs, false);
-    auto badDstsToCopier = domainInspection(dsts, true);
+    PortQueries queries;
+    auto badSrcsToCopier = domainInspection(queries, srcs, false);
+    auto badDstsToCopier = domainInspection(queries, dsts, true);
 
     std::vector<Flow> domainSafeFlows;
     for (const auto &flow : flatFlows)
     {
-        auto srcCopier = badSrcsToCopier.at(flow.src).get();
-        auto dstCopier = badDstsToCopier.at(flow.dst).get();
+        auto srcCopier = badSrcsToCopier.at(flow.src);
+        auto dstCopier = badDstsToCopier.at(flow.dst);
         Pothos::Proxy copier;
         if (srcCopier) copier = srcCopier;
         if (dstCopier) copier = dstCopier;
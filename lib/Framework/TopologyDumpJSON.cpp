@@ -4,6 +4,7 @@
 
 #include <Pothos/Framework/TopologyImpl.hpp>
 #include "Framework/TopologyImpl.hpp"
+#include "Framework/ThreadEnvironment.hpp"
 #include <Pothos/Proxy.hpp>
 #include <json.hpp>
 
@@ -151,6 +152,21 @@ static bool flattenDump(json &topObj)
     return hierFound;
 }
 
+static json threadPoolArgsToObj(const Pothos::ThreadPoolArgs &args)
+{
+    json argsObj;
+    argsObj["numThreads"] = args.numThreads;
+    argsObj["priority"] = args.priority;
+    argsObj["affinityMode"] = args.affinityMode;
+    argsObj["affinity"] = args.affinity;
+    argsObj["yieldMode"] = args.yieldMode;
+    argsObj["burstIterations"] = args.burstIterations;
+    argsObj["burstTime"] = args.burstTime;
+    argsObj["adaptiveBuffers"] = args.adaptiveBuffers;
+    argsObj["circularFanout"] = args.circularFanout;
+    return argsObj;
+}
+
 static json portInfoToObj(const Pothos::PortInfo &portInfo)
 {
     json infoObj;
@@ -244,6 +260,24 @@ std::string Pothos::Topology::dumpJSON(const std::string &request)
     //recursive flatten when instructed
     while (flatten and flattenDump(topObj));
 
+    //report the automatic placement in the markup used by make(),
+    //so that the chosen layout can be inspected and pinned
+    if (not _impl->placementNodes.empty())
+    {
+        json &threadPoolsObj = topObj["threadPools"];
+        auto &placedBlocksObj = topObj["blocks"];
+        for (const auto &pair : _impl->placementNodes)
+        {
+            if (placedBlocksObj.count(pair.first) == 0) continue;
+            const auto poolName = "numa" + std::to_string(pair.second);
+            placedBlocksObj[pair.first]["threadPool"] = poolName;
+            if (threadPoolsObj.count(poolName) != 0) continue;
+            const auto &pool = _impl->placementPools.at(pair.second);
+            threadPoolsObj[poolName] = threadPoolArgsToObj(
+                std::static_pointer_cast<ThreadEnvironment>(pool.getContainer())->getArgs());
+        }
+    }
+
     //return the string-formatted result
     return topObj.dump(4);
 }
@@ -8,6 +8,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <future>
 
 /*!
  * Utility to make a port that is unique to its destination environment.
@@ -25,9 +26,10 @@ static inline Port envTagPort(const Port &port, const Port &other)
  **********************************************************************/
 struct Pothos::Topology::Impl
 {
-    Impl(Topology *self): self(self){}
+    Impl(Topology *self): self(self), sharedMemoryCapacity(8*1024*1024){}
     Topology *self;
     ThreadPool threadPool;
+    size_t sharedMemoryCapacity;
     std::vector<Flow> flows;
     std::vector<Flow> activeFlatFlows;
     std::unordered_map<Port, std::pair<Pothos::Proxy, Pothos::Proxy>> srcToNetgressCache;
@@ -43,6 +45,11 @@ struct Pothos::Topology::Impl
     //! remote topology per unique environment
     std::map<std::string, Pothos::Proxy> remoteTopologies;
 
+    //! place local blocks onto per NUMA node thread pools (affinityMode AUTO)
+    void autoPlacement(const std::vector<Flow> &flatFlows);
+    std::map<size_t, ThreadPool> placementPools; //NUMA node to thread pool
+    std::map<std::string, size_t> placementNodes; //block uid to NUMA node
+
     //! special utility function to make a port with knowledge of this topology
     Port makePort(const Pothos::Object &obj, const std::string &name) const;
     Port makePort(const Pothos::Proxy &obj, const std::string &name) const;
@@ -70,6 +77,69 @@ inline std::vector<Pothos::Proxy> getObjSetFromFlowList(const std::vector<Flow>
     return set;
 }
 
+/***********************************************************************
+ * Pipelined calls -- chain a call onto the results of earlier calls.
+ * Each stage of calls is issued for all blocks before waiting on any result,
+ * so that calls into blocks in remote environments are pipelined.
+ * A future argument is waited on, so do not chain calls within a stage.
+ * Errors from the earlier calls are forwarded to the returned future.
+ **********************************************************************/
+typedef std::shared_future<Pothos::Proxy> ProxyFuture;
+
+template <typename T>
+const T &resolveProxyFuture(const T &value)
+{
+    return value;
+}
+
+inline Pothos::Proxy resolveProxyFuture(const ProxyFuture &future)
+{
+    return future.get();
+}
+
+template <typename ObjType, typename... ArgsType>
+ProxyFuture pipelineCall(const ObjType &obj, const std::string &name, const ArgsType&... args)
+{
+    try
+    {
+        return resolveProxyFuture(obj).callAsync(name, resolveProxyFuture(args)...).share();
+    }
+    catch (...)
+    {
+        std::promise<Pothos::Proxy> result;
+        result.set_exception(std::current_exception());
+        return result.get_future().share();
+    }
+}
+
+/*!
+ * Like pipelineCall(), but a call into an object in this process runs on its own thread.
+ * Calls such as activate() may block on other blocks in the same topology,
+ * so these calls must run concurrently rather than one after the other.
+ */
+template <typename ObjType, typename... ArgsType>
+ProxyFuture concurrentCall(const ObjType &obj, const std::string &name, const ArgsType&... args)
+{
+    try
+    {
+        const auto proxy = resolveProxyFuture(obj);
+        if (proxy.getEnvironment()->getUniquePid() != Pothos::ProxyEnvironment::getLocalUniquePid())
+        {
+            return proxy.callAsync(name, resolveProxyFuture(args)...).share();
+        }
+        return std::async(std::launch::async, [=]
+        {
+            return proxy.call(name, resolveProxyFuture(args)...);
+        }).share();
+    }
+    catch (...)
+    {
+        std::promise<Pothos::Proxy> result;
+        result.set_exception(std::current_exception());
+        return result.get_future().share();
+    }
+}
+
 /***********************************************************************
  * Make a proxy if not already
  **********************************************************************/
@@ -8,11 +8,46 @@
 #include <Poco/URI.h>
 #include <future>
 
+/***********************************************************************
+ * helpers to create shared memory flows on the same host
+ **********************************************************************/
+static bool hasSharedMemoryFlow(const Pothos::ProxyEnvironment::Sptr &env)
+{
+    //peers from older releases do not provide the shared memory blocks
+    auto registry = env->findProxy("Pothos/BlockRegistry");
+    return registry.call<bool>("doesBlockExist", "/shared_memory_sink") and
+        registry.call<bool>("doesBlockExist", "/shared_memory_source");
+}
+
+static std::pair<Pothos::Proxy, Pothos::Proxy> createSharedMemoryFlow(const Flow &flow, const size_t capacity)
+{
+    //the sink creates the ring file, the source maps it by path
+    auto srcEnv = flow.src.obj.getEnvironment();
+    auto dstEnv = flow.dst.obj.getEnvironment();
+    auto shmSink = srcEnv->findProxy("Pothos/BlockRegistry").call("/blocks/shared_memory_sink", capacity);
+    const std::string path = shmSink.call("getPath");
+    auto shmSource = dstEnv->findProxy("Pothos/BlockRegistry").call("/blocks/shared_memory_source", path);
+
+    //return the pair of shared memory blocks
+    const auto name = flow.src.obj.call<std::string>("getName")+"["+flow.src.name+"]";
+    shmSink.call("setName", "ShmTo: "+name);
+    shmSource.call("setName", "ShmFrom: "+name);
+    return std::make_pair(shmSource, shmSink);
+}
+
 /***********************************************************************
  * helpers to create network iogress flows
  **********************************************************************/
-std::pair<Pothos::Proxy, Pothos::Proxy> createNetworkFlow(const Flow &flow)
+std::pair<Pothos::Proxy, Pothos::Proxy> createNetworkFlow(const Flow &flow, const size_t shmCapacity)
 {
+    //processes on the same host skip the network stack
+    if (flow.src.obj.getEnvironment()->getNodeId() == flow.dst.obj.getEnvironment()->getNodeId() and
+        hasSharedMemoryFlow(flow.src.obj.getEnvironment()) and
+        hasSharedMemoryFlow(flow.dst.obj.getEnvironment()))
+    {
+        return createSharedMemoryFlow(flow, shmCapacity);
+    }
+
     //default behaviour: the sink binds, the source connects
     auto bindEnv = flow.src.obj.getEnvironment();
     auto connEnv = flow.dst.obj.getEnvironment();
@@ -75,7 +110,7 @@ std::vector<Flow> Pothos::Topology::Impl::createNetworkFlows(const std::vector<F
     {
         assert(not pair.second.empty());
         if (this->srcToNetgressCache.count(pair.first) != 0) continue;
-        srcToFutures[pair.first] = std::async(std::launch::async, &createNetworkFlow, pair.second.at(0));
+        srcToFutures[pair.first] = std::async(std::launch::async, &createNetworkFlow, pair.second.at(0), this->sharedMemoryCapacity);
     }
 
     //load all futures into the cache
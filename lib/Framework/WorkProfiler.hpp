@@ -0,0 +1,105 @@
+// Copyright (c) 2014-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <vector>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*!
+ * A log-bucketed histogram in the style of an HDR histogram.
+ * Each power of two is split into 2^SubBits linear sub-buckets,
+ * so the bucket width is at most 1/4 of the recorded value.
+ * Recording is a bit scan and an increment, no allocations.
+ * The histogram is only accessed from the worker context.
+ */
+class WorkHistogram
+{
+public:
+    static const size_t SubBits = 2;
+    static const size_t SubCount = size_t(1) << SubBits;
+    static const size_t NumBuckets = (64-SubBits+1)*SubCount;
+
+    WorkHistogram(void):
+        count(0), sum(0), min(~0ull), max(0),
+        buckets(NumBuckets, 0)
+    {
+        return;
+    }
+
+    //! Record a single value into the histogram
+    void record(const unsigned long long value)
+    {
+        count++;
+        sum += value;
+        if (value < min) min = value;
+        if (value > max) max = value;
+        buckets[bucketIndex(value)]++;
+    }
+
+    //! Get the bucket index that contains the value
+    static size_t bucketIndex(const unsigned long long value)
+    {
+        if (value < SubCount) return size_t(value);
+        const size_t shift = msb(value)-SubBits;
+        return ((shift+1) << SubBits) + size_t((value >> shift) & (SubCount-1));
+    }
+
+    //! Get the lowest value that falls into the bucket
+    static unsigned long long bucketLowerBound(const size_t index)
+    {
+        if (index < SubCount) return index;
+        const size_t shift = (index >> SubBits)-1;
+        return (SubCount | (index & (SubCount-1))) << shift;
+    }
+
+    //! Get the lower bound of the bucket which holds the given percentile
+    unsigned long long percentile(const double pct) const
+    {
+        if (count == 0) return 0;
+        const unsigned long long target = (unsigned long long)(count*pct/100.0);
+        unsigned long long total = 0;
+        for (size_t i = 0; i < NumBuckets; i++)
+        {
+            total += buckets[i];
+            if (total > target) return bucketLowerBound(i);
+        }
+        return max;
+    }
+
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long min;
+    unsigned long long max;
+    std::vector<unsigned long long> buckets;
+
+private:
+    static size_t msb(const unsigned long long value)
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+        return 63-__builtin_clzll(value);
+        #elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index; _BitScanReverse64(&index, value); return index;
+        #else
+        size_t index = 0; while (value >> (index+1)) index++; return index;
+        #endif
+    }
+};
+
+/*!
+ * Per-block work profiler histograms recorded by the WorkerActor.
+ * Durations are in high_resolution_clock ticks like the other work stats.
+ */
+struct WorkProfiler
+{
+    WorkHistogram workDuration; //!< time spent in each work() call
+    WorkHistogram schedulingDelay; //!< time between the first flagged change and the task
+    WorkHistogram elementsConsumed; //!< total input elements consumed per work() call
+    WorkHistogram elementsProduced; //!< total output elements produced per work() call
+
+    //! Is the profiler enabled for new blocks? (POTHOS_WORK_PROFILER environment variable)
+    static bool enabledByEnvironment(void);
+};
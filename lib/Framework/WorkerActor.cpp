@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/WorkerActor.hpp"
+#include "Framework/InputPortInbox.hpp"
 #include <Pothos/Framework/InputPortImpl.hpp>
 #include <Pothos/Framework/OutputPortImpl.hpp>
 #include <Pothos/Object/Containers.hpp>
 #include <Poco/Format.h>
 #include <Poco/Logger.h>
+#include <Poco/Environment.h>
 #include <cassert>
 #include <algorithm> //min/max
 #include <json.hpp>
@@ -14,21 +16,57 @@
 using json = nlohmann::json;
 
 //! Helper routine to deal with automatically accumulating time durations
+//! The optional histogram records each duration from the same timestamp pair
 struct TimeAccumulator
 {
-    inline TimeAccumulator(std::chrono::high_resolution_clock::duration &t):
-        t(t), start(std::chrono::high_resolution_clock::now())
+    inline TimeAccumulator(std::chrono::high_resolution_clock::duration &t, WorkHistogram *hist = nullptr):
+        t(t), hist(hist), start(std::chrono::high_resolution_clock::now())
     {
         return;
     }
     inline ~TimeAccumulator(void)
     {
-        t += std::chrono::high_resolution_clock::now() - start;
+        const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        t += elapsed;
+        if (hist != nullptr) hist->record(elapsed.count());
     }
     std::chrono::high_resolution_clock::duration &t;
+    WorkHistogram *hist;
     const std::chrono::high_resolution_clock::time_point start;
 };
 
+/***********************************************************************
+ * work profiler helpers
+ **********************************************************************/
+bool WorkProfiler::enabledByEnvironment(void)
+{
+    const auto value = Poco::Environment::get("POTHOS_WORK_PROFILER", "");
+    return not value.empty() and value != "0";
+}
+
+static json histogramToJSON(const WorkHistogram &hist)
+{
+    json out;
+    out["count"] = hist.count;
+    out["sum"] = hist.sum;
+    out["min"] = (hist.count == 0)?0:hist.min;
+    out["max"] = hist.max;
+    out["p50"] = hist.percentile(50.0);
+    out["p90"] = hist.percentile(90.0);
+    out["p99"] = hist.percentile(99.0);
+    out["p999"] = hist.percentile(99.9);
+
+    //sparse buckets as [lowerBound, count] pairs
+    json buckets = json::array();
+    for (size_t i = 0; i < WorkHistogram::NumBuckets; i++)
+    {
+        if (hist.buckets[i] == 0) continue;
+        buckets.push_back({WorkHistogram::bucketLowerBound(i), hist.buckets[i]});
+    }
+    out["buckets"] = buckets;
+    return out;
+}
+
 /***********************************************************************
  * buffer manager helpers
  **********************************************************************/
@@ -73,10 +111,34 @@ Pothos::BufferManager::Sptr Pothos::WorkerActor::getBufferManagerNoLock(const st
     auto &weakMgr = bufferManagerCache[isInput][name][domain];
     auto m = weakMgr.lock();
 
+    //default args allocate on the NUMA node of the thread pool
+    BufferManagerArgs args;
+    args.nodeAffinity = bufferNodeAffinity;
+
     //try to get the manager and make one if its null
     if (not m) m = isInput? block->getInputBufferManager(name, domain) : block->getOutputBufferManager(name, domain);
-    if (not m) m = BufferManager::make("generic", BufferManagerArgs());
-    else if (not m->isInitialized()) m->init(BufferManagerArgs()); //TODO pass this in from somewhere
+
+    if (m and not m->isInitialized()) m->init(args);
+
+    //circular buffers avoid a require() copy in each subscriber
+    //when the accumulated data wraps around the end of the pool
+    std::string factory;
+    if (not m and not isInput and circularFanout and outputs.at(name)->_subscribers.size() > 1)
+    {
+        try {m = BufferManager::make(factory = "circular", args);}
+        catch (const Exception &ex)
+        {
+            poco_warning_f3(Poco::Logger::get("Pothos.Block.circularFanout"), "%s[%s]: %s, using generic buffers",
+                block->getName(), name, ex.displayText());
+        }
+    }
+    if (not m) m = BufferManager::make(factory = "generic", args);
+
+    //default output managers are candidates for adaptive sizing
+    if (not factory.empty() and not isInput)
+    {
+        adaptiveBufferStates[name].reset(new AdaptiveBufferState(factory, args, m));
+    }
 
     //store the new buffer manager to the cache
     weakMgr = m;
@@ -87,6 +149,40 @@ void Pothos::WorkerActor::setOutputBufferManager(const std::string &name, const
 {
     ActorInterfaceLock lock(this);
     outputs.at(name)->bufferManagerSetup(manager);
+
+    //only the default managers made by this actor can be resized
+    auto it = adaptiveBufferStates.find(name);
+    if (it != adaptiveBufferStates.end() and not it->second->isInstalled(manager))
+    {
+        adaptiveBufferStates.erase(it);
+    }
+}
+
+void Pothos::WorkerActor::adaptOutputBufferManager(const std::string &name, OutputPort &port, const size_t bytesProduced)
+{
+    auto it = adaptiveBufferStates.find(name);
+    if (it == adaptiveBufferStates.end()) return;
+    auto &state = *it->second;
+    if (not state.isInstalled(port._bufferManager)) return;
+    const auto elemSize = port._dtype.size();
+    if (not state.update(bytesProduced, port._elements*elemSize, port._reserveElements*elemSize)) return;
+
+    //install a manager with the new size,
+    //buffers in flight are freed when they are released
+    BufferManager::Sptr m;
+    try
+    {
+        m = BufferManager::make(state.factory, state.args);
+    }
+    catch (const Exception &ex)
+    {
+        poco_warning_f3(Poco::Logger::get("Pothos.Block.adaptiveBuffers"), "%s[%s]: %s",
+            block->getName(), port.alias(), ex.displayText());
+        adaptiveBufferStates.erase(it);
+        return;
+    }
+    state.manager = m;
+    port.bufferManagerSetup(m);
 }
 
 void Pothos::WorkerActor::ensureOutputBufferManagerNoLock(const std::string &name)
@@ -217,11 +313,24 @@ void Pothos::WorkerActor::setActiveStateOff(void)
  **********************************************************************/
 void Pothos::WorkerActor::workTask(void)
 {
+    #ifdef POTHOS_WORK_PROFILER
+    const long long flagTime = workProfiler?this->takeFlagTimestamp():0;
+    #endif
+
     if (not activeState) return;
     if (not block->prepare()) return;
     this->numTaskCalls++;
     TimeAccumulator taskTime(this->totalTimeTask);
 
+    #ifdef POTHOS_WORK_PROFILER
+    //scheduling delay from the first flagged change to the task start
+    if (flagTime != 0)
+    {
+        const long long delay = taskTime.start.time_since_epoch().count() - flagTime;
+        workProfiler->schedulingDelay.record((delay > 0)?delay:0);
+    }
+    #endif
+
     //prework
     {
         TimeAccumulator preWorkTime(this->totalTimePreWork);
@@ -232,7 +341,11 @@ void Pothos::WorkerActor::workTask(void)
     POTHOS_EXCEPTION_TRY
     {
         this->numWorkCalls++;
+        #ifdef POTHOS_WORK_PROFILER
+        TimeAccumulator workTime(this->totalTimeWork, workProfiler?&workProfiler->workDuration:nullptr);
+        #else
         TimeAccumulator workTime(this->totalTimeWork);
+        #endif
         block->work();
     }
     POTHOS_EXCEPTION_CATCH(const Exception &ex)
@@ -249,11 +362,31 @@ void Pothos::WorkerActor::workTask(void)
     this->timeLastWork = std::chrono::high_resolution_clock::now();
 }
 
+/***********************************************************************
+ * burst of work tasks
+ **********************************************************************/
+void Pothos::WorkerActor::burstTasks(void)
+{
+    //The change flag is set by postWorkTasks() when work() consumed or produced,
+    //and by upstream/downstream ports when new buffers or resources arrive.
+    //No flag means the block is not backlogged: below reserve or out of buffers.
+    const bool timed = burstTime.count() != 0;
+    const auto deadline = timed?(std::chrono::high_resolution_clock::now() + burstTime):
+        std::chrono::high_resolution_clock::time_point();
+    for (size_t i = 1; i < burstIterations; i++)
+    {
+        if (not this->workerThreadContinue()) return;
+        this->workTask();
+        if (timed and std::chrono::high_resolution_clock::now() > deadline) return;
+    }
+}
+
 /***********************************************************************
  * call slots
  **********************************************************************/
-void Pothos::WorkerActor::handleSlotCalls(InputPort &port)
+void Pothos::WorkerActor::handleSlotCalls(SlotDispatch &slot)
 {
+    auto &port = *slot.port;
     while (not port.slotCallsEmpty())
     {
         POTHOS_EXCEPTION_TRY
@@ -261,24 +394,26 @@ void Pothos::WorkerActor::handleSlotCalls(InputPort &port)
             const auto call = port.slotCallsPop();
             const auto &args = call.extract<ObjectVector>();
 
-            //check if this name is a probe slot
-            auto probesIt = block->_probes.find(port.name());
-            if (probesIt != block->_probes.end())
+            //the handler recognizes the slot's own name string and
+            //dispatches through the slot table entry without a name lookup
+            this->currentSlot.store(&slot, std::memory_order_relaxed);
+            auto result = block->opaqueCallHandler(slot.callName, args.data(), args.size());
+            this->currentSlot.store(nullptr, std::memory_order_relaxed);
+
+            //probe slots forward the result to the triggered signal
+            if (not slot.signalName.empty())
             {
-                const auto &callName = probesIt->second.first;
-                const auto &signalName = probesIt->second.second;
-                auto result = block->opaqueCallHandler(callName, args.data(), args.size());
-                if (result) block->call(signalName, result);
-                else block->call(signalName);
+                if (result) block->call(slot.signalName, result);
+                else block->call(slot.signalName);
                 continue;
             }
 
-            block->opaqueCallHandler(port.name(), args.data(), args.size());
             this->flagInternalChange();
             this->activityIndicator.fetch_add(1, std::memory_order_relaxed);
         }
         POTHOS_EXCEPTION_CATCH(const Exception &ex)
         {
+            this->currentSlot.store(nullptr, std::memory_order_relaxed);
             poco_error_f3(Poco::Logger::get("Pothos.Block.callSlot"), "%s[%s]: %s", block->getName(), port.alias(), ex.displayText());
         }
     }
@@ -350,15 +485,16 @@ bool Pothos::WorkerActor::preWorkTasks(void)
     bool hasInputMessage = false;
     block->_workInfo.minInElements = BIG;
     block->_workInfo.minAllInElements = BIG;
+    for (const auto &slot : this->slotTable)
+    {
+        slot->port->_workEvents = 0;
+        this->handleSlotCalls(*slot);
+    }
     for (const auto &entry : this->inputs)
     {
         auto &port = *entry.second;
+        if (port.isSlot()) continue;
         port._workEvents = 0;
-        if (port.isSlot())
-        {
-            this->handleSlotCalls(port);
-            continue;
-        }
         hasBufferedPorts = true;
 
         //perform minimum reserve accumulator require to recover from possible element fragmentation
@@ -401,6 +537,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
     ///////////////////// input handling ////////////////////////
 
     size_t inputWorkEvents = 0;
+    size_t inputElements = 0;
 
     for (const auto &entry : this->inputs)
     {
@@ -442,6 +579,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
 
         //move consumed elements into total
         port._totalElements += port._pendingElements;
+        inputElements += port._pendingElements;
         inputWorkEvents += port._workEvents;
     }
 
@@ -457,6 +595,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
     //Note: output buffer production must come after propagateLabels()
 
     size_t outputWorkEvents = 0;
+    size_t outputElements = 0;
 
     for (const auto &entry : this->outputs)
     {
@@ -489,6 +628,10 @@ void Pothos::WorkerActor::postWorkTasks(void)
                 else port.bufferManagerPop(buffer.length);
             }
             port.postBuffer(std::move(buffer));
+            if (adaptiveBuffers and port._bufferFromManager)
+            {
+                this->adaptOutputBufferManager(entry.first, port, pendingBytes);
+            }
         }
 
         //Outside of produce, the block may use popElements() or increase the reserve.
@@ -512,12 +655,28 @@ void Pothos::WorkerActor::postWorkTasks(void)
         if (not postedLabels.empty()) std::sort(postedLabels.begin(), postedLabels.end());
 
         //send the outgoing labels with buffers
-        if (not postedLabels.empty() or not postedBuffers.empty())
+        if (postedLabels.empty() and postedBuffers.empty()) {}
+
+        //a single subscriber takes the labels and buffers by move
+        else if (port._subscribers.size() == 1)
+        {
+            port._subscribers.front()->bufferLabelPush(true, postedLabels, postedBuffers);
+        }
+
+        //multiple subscribers share a single batch without copies
+        else if (not port._subscribers.empty())
         {
+            auto batch = std::make_shared<InputPortBatch>(port._subscribers.size());
+            batch->labels = std::move(postedLabels);
+            batch->buffers.reserve(postedBuffers.size());
+            while (not postedBuffers.empty())
+            {
+                batch->buffers.push_back(std::move(postedBuffers.front()));
+                postedBuffers.pop_front();
+            }
             for (const auto &subscriber : port._subscribers)
             {
-                const bool last = (&subscriber == &port._subscribers.back());
-                subscriber->bufferLabelPush(last, postedLabels, postedBuffers);
+                subscriber->bufferBatchPush(batch);
             }
         }
 
@@ -526,6 +685,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
         postedBuffers.clear();
 
         //add produced bytes into total
+        outputElements += port._pendingElements;
         outputWorkEvents += port._workEvents;
     }
 
@@ -536,6 +696,17 @@ void Pothos::WorkerActor::postWorkTasks(void)
         this->activityIndicator.fetch_add(1, std::memory_order_relaxed);
         this->timeLastProduced = std::chrono::high_resolution_clock::now();
     }
+
+    #ifdef POTHOS_WORK_PROFILER
+    if (workProfiler)
+    {
+        workProfiler->elementsConsumed.record(inputElements);
+        workProfiler->elementsProduced.record(outputElements);
+    }
+    #else
+    (void)inputElements;
+    (void)outputElements;
+    #endif
 }
 
 std::string Pothos::WorkerActor::queryWorkStats(void)
@@ -577,11 +748,10 @@ std::string Pothos::WorkerActor::queryWorkStats(void)
         portStats["portAlias"] = port.alias();
         portStats["reserveElements"] = port._reserveElements;
         {
+            //the front call drains the inbox into the accumulator
+            //the accumulator is owned by the worker context (locked)
             BufferChunk frontBuff; port.bufferAccumulatorFront(frontBuff);
             portStats["frontBytes"] = frontBuff.length;
-        }
-        {
-            std::lock_guard<Util::SpinLock> lockB(port._bufferAccumulatorLock);
             portStats["enqueuedBytes"] = port._bufferAccumulator.getTotalBytesAvailable();
             portStats["enqueuedBuffers"] = port._bufferAccumulator.getUniqueManagedBufferCount();
             portStats["enqueuedLabels"] = port._inlineMessages.size()+port._inputInlineMessages.size();
@@ -614,10 +784,31 @@ std::string Pothos::WorkerActor::queryWorkStats(void)
             portStats["frontBytes"] = frontBuff.length;
         }
         portStats["tokensEmpty"] = port.tokenManagerEmpty();
+        const auto adaptiveIt = adaptiveBufferStates.find(name);
+        if (adaptiveBuffers and adaptiveIt != adaptiveBufferStates.end() and
+            adaptiveIt->second->isInstalled(port._bufferManager))
+        {
+            json adaptiveStats;
+            adaptiveStats["numBuffers"] = adaptiveIt->second->args.numBuffers;
+            adaptiveStats["bufferSize"] = adaptiveIt->second->args.bufferSize;
+            adaptiveStats["numResizes"] = adaptiveIt->second->numResizes;
+            portStats["adaptiveBuffers"] = adaptiveStats;
+        }
         outputStats.push_back(portStats);
     }
     if (not outputStats.empty()) stats["outputStats"] = outputStats;
 
+    //load the optional work profiler histograms
+    if (workProfiler)
+    {
+        json profilerStats;
+        profilerStats["workDuration"] = histogramToJSON(workProfiler->workDuration);
+        profilerStats["schedulingDelay"] = histogramToJSON(workProfiler->schedulingDelay);
+        profilerStats["elementsConsumed"] = histogramToJSON(workProfiler->elementsConsumed);
+        profilerStats["elementsProduced"] = histogramToJSON(workProfiler->elementsProduced);
+        stats["workProfiler"] = profilerStats;
+    }
+
     return stats.dump();
 }
 
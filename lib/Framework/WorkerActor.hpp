@@ -3,14 +3,57 @@
 
 #pragma once
 #include "Framework/ActorInterface.hpp"
+#include "Framework/WorkProfiler.hpp"
+#include "Framework/AdaptiveBuffers.hpp"
 #include <Pothos/Framework/BlockImpl.hpp>
 #include <Pothos/Framework/Exception.hpp>
 #include <Poco/Format.h>
 #include <Poco/Logger.h>
 #include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <memory>
 #include <set>
+#include <typeinfo>
+#include <vector>
 #include <iostream>
 
+/***********************************************************************
+ * Slot dispatch table entry
+ **********************************************************************/
+namespace Pothos {
+
+/*!
+ * A slot resolved when its input port is allocated.
+ * The slot handle is the index of the entry in the worker's slot table.
+ * Slot calls dispatch through the overloads collected here and cache
+ * the selected overload by argument types, without looking up the name.
+ */
+struct SlotDispatch
+{
+    SlotDispatch(const std::string &name, InputPort *port):
+        callName(name),
+        port(port),
+        generation(0)
+    {
+        return;
+    }
+
+    std::string callName; //!< the registered call (the probed call for probe slots)
+    std::string signalName; //!< the triggered signal for probe slots, otherwise empty
+    InputPort *port;
+    std::vector<Callable> calls; //!< overloads in registration order
+
+    //! overload cache: argument types to the index of the selected call
+    std::vector<std::pair<std::vector<const std::type_info *>, size_t>> overloads;
+    size_t generation; //!< conversion generation of the overload cache
+
+    //! Call the matching overload with the input arguments
+    Object call(const Object *inputArgs, const size_t numArgs);
+};
+
+}
+
 /***********************************************************************
  * Actor definition
  **********************************************************************/
@@ -21,14 +64,27 @@ public:
         block(block),
         activeState(false),
         activityIndicator(0),
+        burstIterations(1),
+        burstTime(0),
+        bufferNodeAffinity(-1),
+        adaptiveBuffers(false),
+        circularFanout(false),
+        currentSlot(nullptr),
         numTaskCalls(0),
         numWorkCalls(0)
     {
-        return;
+        #ifdef POTHOS_WORK_PROFILER
+        if (WorkProfiler::enabledByEnvironment())
+        {
+            this->workProfiler.reset(new WorkProfiler());
+            this->enableFlagTimestamps(true);
+        }
+        #endif
     }
 
     /*!
-     * Perform the main processing task once.
+     * Perform the main processing task once,
+     * or repeatedly while backlogged in burst mode.
      * Give the context back to the worker thread.
      */
     bool processTask(const bool waitEnabled)
@@ -36,12 +92,26 @@ public:
         if (this->workerThreadAcquire(waitEnabled))
         {
             this->workTask();
+            if (burstIterations > 1) this->burstTasks();
             this->workerThreadRelease();
             return true;
         }
         return false;
     }
 
+    /*!
+     * Configure the burst policy from the thread pool args.
+     * Set before the task is registered with the thread pool.
+     * \param iterations the maximum number of tasks per acquisition
+     * \param seconds the time budget for the burst or 0.0 for none
+     */
+    void setBurstPolicy(const size_t iterations, const double seconds)
+    {
+        burstIterations = std::max<size_t>(1, iterations);
+        burstTime = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+
     /*!
      * The activity indicator changes when work() produces or consumes.
      * Its value is used by the Topology's waitInactive() implementation.
@@ -61,6 +131,36 @@ public:
      */
     std::string queryWorkStats(void);
 
+    /*!
+     * Set the NUMA node used to allocate the default buffer managers.
+     * \param nodeAffinity the NUMA node or -1 for don't care
+     */
+    void setBufferNodeAffinity(const long nodeAffinity)
+    {
+        ActorInterfaceLock lock(this);
+        bufferNodeAffinity = nodeAffinity;
+    }
+
+    /*!
+     * Enable runtime sizing of the default output buffer managers.
+     * \param enabled true to adapt the buffer sizes to the throughput
+     */
+    void setAdaptiveBuffers(const bool enabled)
+    {
+        ActorInterfaceLock lock(this);
+        adaptiveBuffers = enabled;
+    }
+
+    /*!
+     * Enable circular default managers for outputs with multiple subscribers.
+     * \param enabled true to try the circular manager before the generic one
+     */
+    void setCircularFanout(const bool enabled)
+    {
+        ActorInterfaceLock lock(this);
+        circularFanout = enabled;
+    }
+
     ///////////////////// WorkerActor storage ///////////////////////
     Block *block;
     bool activeState;
@@ -71,6 +171,14 @@ public:
     std::map<bool, std::map<std::string, std::map<std::string, std::string>>> bufferModeCache;
     std::map<bool, std::map<std::string, Pothos::BufferManager::Sptr>> bufferManagerTmpCache;
     std::map<bool, std::map<std::string, std::map<std::string, std::weak_ptr<Pothos::BufferManager>>>> bufferManagerCache;
+    size_t burstIterations;
+    std::chrono::high_resolution_clock::duration burstTime;
+    long bufferNodeAffinity;
+    bool adaptiveBuffers;
+    bool circularFanout;
+    std::map<std::string, std::unique_ptr<AdaptiveBufferState>> adaptiveBufferStates;
+    std::vector<std::unique_ptr<SlotDispatch>> slotTable; //!< indexed by slot handle
+    std::atomic<SlotDispatch *> currentSlot; //!< slot dispatched by the worker, otherwise null
 
     ///////////////////// work stats collection ///////////////////////
     unsigned long long numTaskCalls;
@@ -82,12 +190,15 @@ public:
     std::chrono::high_resolution_clock::time_point timeLastConsumed;
     std::chrono::high_resolution_clock::time_point timeLastProduced;
     std::chrono::high_resolution_clock::time_point timeLastWork;
+    std::unique_ptr<WorkProfiler> workProfiler; //!< null unless profiling is enabled
 
     ///////////////////// port setup methods ///////////////////////
     void allocateInput(const std::string &name, const DType &dtype, const std::string &domain);
     void allocateOutput(const std::string &name, const DType &dtype, const std::string &domain);
     void allocateSignal(const std::string &name);
     void allocateSlot(const std::string &name);
+    void addSlotCall(const std::string &name, const Callable &call);
+    void setupProbeSlot(const std::string &slotName, const std::string &callName, const std::string &signalName);
     template <typename PortsType, typename NamedPortsType, typename IndexedPortsType, typename PortNamesType>
     void allocatePort(PortsType &ports, NamedPortsType &namedPorts, IndexedPortsType &indexedPorts, PortNamesType &portNames,
         const std::string &name, const DType &dtype, const std::string &domain, const bool automatic = false);
@@ -116,10 +227,12 @@ public:
     BufferManager::Sptr getBufferManagerNoLock(const std::string &name, const std::string &domain, const bool isInput);
     void setOutputBufferManager(const std::string &name, const BufferManager::Sptr &manager);
     void ensureOutputBufferManagerNoLock(const std::string &name);
+    void adaptOutputBufferManager(const std::string &name, OutputPort &port, const size_t bytesProduced);
 
     ///////////////////// work helper methods ///////////////////////
     void workTask(void);
+    void burstTasks(void);
     bool preWorkTasks(void);
     void postWorkTasks(void);
-    void handleSlotCalls(InputPort &);
+    void handleSlotCalls(SlotDispatch &);
 };
@@ -96,7 +96,38 @@ void Pothos::WorkerActor::allocateSignal(const std::string &name)
 void Pothos::WorkerActor::allocateSlot(const std::string &name)
 {
     this->allocateInput(name, "", "");
-    this->inputs[name]->_isSlot = true;
+    auto port = this->inputs[name].get();
+    port->_isSlot = true;
+
+    //resolve the slot handle and the calls which were registered so far
+    std::unique_ptr<SlotDispatch> slot(new SlotDispatch(name, port));
+    const auto range = block->_calls.equal_range(name);
+    for (auto it = range.first; it != range.second; ++it) slot->calls.push_back(it->second);
+    this->slotTable.push_back(std::move(slot));
+}
+
+void Pothos::WorkerActor::addSlotCall(const std::string &name, const Callable &call)
+{
+    for (auto &slot : this->slotTable)
+    {
+        if (slot->callName != name) continue;
+        slot->calls.push_back(call);
+        slot->overloads.clear();
+    }
+}
+
+void Pothos::WorkerActor::setupProbeSlot(const std::string &slotName, const std::string &callName, const std::string &signalName)
+{
+    for (auto &slot : this->slotTable)
+    {
+        if (slot->port->name() != slotName) continue;
+        slot->callName = callName;
+        slot->signalName = signalName;
+        slot->calls.clear();
+        slot->overloads.clear();
+        const auto range = block->_calls.equal_range(callName);
+        for (auto it = range.first; it != range.second; ++it) slot->calls.push_back(it->second);
+    }
 }
 
 void Pothos::WorkerActor::autoAllocateInput(const std::string &name)
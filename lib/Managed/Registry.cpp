@@ -1,30 +1,23 @@
 // Copyright (c) 2013-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Util/RegistrySnapshot.hpp"
 #include <Pothos/Managed/Class.hpp>
 #include <Pothos/Managed/Exception.hpp>
-#include <Pothos/Util/SpinLockRW.hpp>
 #include <Pothos/Util/TypeInfo.hpp>
 #include <Pothos/Callable.hpp>
 #include <Pothos/Plugin.hpp>
 #include <Poco/Logger.h>
-#include <mutex>
 #include <map>
 
 /***********************************************************************
  * Global map structure for registry
  **********************************************************************/
-static Pothos::Util::SpinLockRW &getMapMutex(void)
+//singleton snapshot of all supported classes, read without locking
+typedef std::map<size_t, Pothos::ManagedClass> ClassMapType;
+static RegistrySnapshot<ClassMapType> &getClassMap(void)
 {
-    static Pothos::Util::SpinLockRW lock;
-    return lock;
-}
-
-//singleton global map for all supported classes
-typedef std::map<size_t, Pothos::Plugin> ClassMapType;
-static ClassMapType &getClassMap(void)
-{
-    static ClassMapType map;
+    static RegistrySnapshot<ClassMapType> map;
     return map;
 }
 
@@ -40,19 +33,21 @@ static void handlePluginEvent(const Pothos::Plugin &plugin, const std::string &e
         if (plugin.getObject().type() != typeid(Pothos::ManagedClass)) return;
         const auto &reg = plugin.getObject().extract<Pothos::ManagedClass>();
 
-        std::lock_guard<Pothos::Util::SpinLockRW> lock(getMapMutex());
-        if (event == "add")
-        {
-            getClassMap()[reg.type().hash_code()] = plugin;
-            getClassMap()[reg.pointerType().hash_code()] = plugin;
-            getClassMap()[reg.sharedType().hash_code()] = plugin;
-        }
-        if (event == "remove")
+        getClassMap().update([&](ClassMapType &map)
         {
-            getClassMap()[reg.type().hash_code()] = Pothos::Plugin();
-            getClassMap()[reg.pointerType().hash_code()] = Pothos::Plugin();
-            getClassMap()[reg.sharedType().hash_code()] = Pothos::Plugin();
-        }
+            if (event == "add")
+            {
+                map[reg.type().hash_code()] = reg;
+                map[reg.pointerType().hash_code()] = reg;
+                map[reg.sharedType().hash_code()] = reg;
+            }
+            if (event == "remove")
+            {
+                map.erase(reg.type().hash_code());
+                map.erase(reg.pointerType().hash_code());
+                map.erase(reg.sharedType().hash_code());
+            }
+        });
     }
     POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
     {
@@ -74,15 +69,14 @@ pothos_static_block(pothosManagedClassRegister)
  **********************************************************************/
 Pothos::ManagedClass Pothos::ManagedClass::lookup(const std::type_info &type)
 {
-    //find the plugin in the map, it will be null if not found
-    Pothos::Util::SpinLockRW::SharedLock lock(getMapMutex());
-    auto it = getClassMap().find(type.hash_code());
+    //find the class in the map
+    RegistrySnapshot<ClassMapType>::Reader map(getClassMap());
+    auto it = map->find(type.hash_code());
 
     //thow an error when the entry is not found
-    if (it == getClassMap().end()) throw ManagedClassLookupError(
+    if (it == map->end()) throw ManagedClassLookupError(
         "Pothos::ManagedClass::lookup("+Util::typeInfoToString(type)+")",
         "no registration found");
 
-    //extract the managed class
-    return it->second.getObject().extract<Pothos::ManagedClass>();
+    return it->second;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 #include <complex>
 #include <sstream>
+#include <thread>
 
 class NeverHeardOfFooBar {};
 
@@ -60,6 +61,24 @@ POTHOS_TEST_BLOCK("/object/tests", test_object_mutable)
     POTHOS_TEST_THROWS(intObj.ref<int>(), Pothos::ObjectConvertError);
 }
 
+POTHOS_TEST_BLOCK("/object/tests", test_object_container_pool)
+{
+    //small containers made on another thread are freed on this one
+    std::vector<Pothos::Object> objs;
+    std::thread([&objs]{
+        for (int i = 0; i < 1000; i++) objs.emplace_back(i);
+    }).join();
+    for (int i = 0; i < 1000; i++) POTHOS_TEST_EQUAL(objs[i].extract<int>(), i);
+
+    //copies of pooled containers are shared
+    const auto copy = objs.back();
+    POTHOS_TEST_TRUE(copy == objs.back());
+    POTHOS_TEST_EQUAL(&copy.extract<int>(), &objs.back().extract<int>());
+    objs.clear();
+    POTHOS_TEST_EQUAL(copy.extract<int>(), 999);
+    POTHOS_TEST_TRUE(copy.unique());
+}
+
 Pothos::Object someFunctionTakesObject(const Pothos::Object &obj)
 {
     return obj;
@@ -2,40 +2,43 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "TypesHashCombine.hpp"
+#include "ConvertChain.hpp"
+#include "Util/RegistrySnapshot.hpp"
 #include <Pothos/Object/ObjectImpl.hpp>
 #include <Pothos/Object/Exception.hpp>
-#include <Pothos/Util/SpinLockRW.hpp>
 #include <Pothos/Util/TypeInfo.hpp>
 #include <Pothos/Callable.hpp>
 #include <Pothos/Plugin.hpp>
 #include <Poco/Logger.h>
 #include <Poco/Format.h>
-#include <mutex>
+#include <atomic>
 #include <set>
 #include <map>
 
 /***********************************************************************
  * Global map structure for conversions
  **********************************************************************/
-static Pothos::Util::SpinLockRW &getMapMutex(void)
+struct ConvertTables
 {
-    static Pothos::Util::SpinLockRW lock;
-    return lock;
-}
+    //map of all supported conversions (the calls are cheap to copy)
+    std::map<size_t, Pothos::Callable> convertMap;
+
+    //given an input type (hash), what types can it can convert to?
+    std::map<size_t, std::set<size_t>> ioMap;
+};
 
-//singleton global map for all supported conversions
-typedef std::map<size_t, Pothos::Plugin> ConvertMapType;
-static ConvertMapType &getConvertMap(void)
+//singleton snapshot of the conversions, read without locking
+static RegistrySnapshot<ConvertTables> &getConvertTables(void)
 {
-    static ConvertMapType map;
-    return map;
+    static RegistrySnapshot<ConvertTables> tables;
+    return tables;
 }
 
-//given an input type (hash), what types can it can convert to?
-static std::map<size_t, std::set<size_t>> &getConvertIoMap(void)
+//incremented for every change to the conversions
+static std::atomic<size_t> &getConvertGenerationCounter(void)
 {
-    static std::map<size_t, std::set<size_t>> map;
-    return map;
+    static std::atomic<size_t> generation(0);
+    return generation;
 }
 
 /***********************************************************************
@@ -56,17 +59,20 @@ static void handleConvertPluginEvent(const Pothos::Plugin &plugin, const std::st
         const std::type_info &inputType = call.type(0);
         const std::type_info &outputType = call.type(-1);
 
-        std::lock_guard<Pothos::Util::SpinLockRW> lock(getMapMutex());
-        if (event == "add")
+        getConvertTables().update([&](ConvertTables &tables)
         {
-            getConvertMap()[typesHashCombine(inputType, outputType)] = plugin;
-            getConvertIoMap()[inputType.hash_code()].insert(outputType.hash_code());
-        }
-        if (event == "remove")
-        {
-            getConvertMap()[typesHashCombine(inputType, outputType)] = Pothos::Plugin();
-            getConvertIoMap()[inputType.hash_code()].erase(outputType.hash_code());
-        }
+            if (event == "add")
+            {
+                tables.convertMap[typesHashCombine(inputType, outputType)] = call;
+                tables.ioMap[inputType.hash_code()].insert(outputType.hash_code());
+            }
+            if (event == "remove")
+            {
+                tables.convertMap.erase(typesHashCombine(inputType, outputType));
+                tables.ioMap[inputType.hash_code()].erase(outputType.hash_code());
+            }
+        });
+        getConvertGenerationCounter()++;
     }
     POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
     {
@@ -86,39 +92,80 @@ pothos_static_block(pothosObjectConvertRegister)
 /***********************************************************************
  * The conversion implementation
  **********************************************************************/
-static Pothos::Object convertObject(const Pothos::Object &inputObj, const std::type_info &outputType)
+//! Find the direct conversion, or two conversions through an intermediate type.
+//! The second call is null for a direct conversion.
+static bool findConvertCalls(const ConvertTables &tables,
+    const std::type_info &inputType, const std::type_info &outputType,
+    const Pothos::Callable *&call1, const Pothos::Callable *&call2)
 {
-    //find the plugin in the map, it will be null if not found
-    Pothos::Util::SpinLockRW::SharedLock lock(getMapMutex());
-    auto it = getConvertMap().find(typesHashCombine(inputObj.type(), outputType));
+    call1 = call2 = nullptr;
+    auto it = tables.convertMap.find(typesHashCombine(inputType, outputType));
+    if (it != tables.convertMap.end())
+    {
+        call1 = &it->second;
+        return true;
+    }
 
     //try an intermediate conversion
-    if (it == getConvertMap().end())
+    auto itIo = tables.ioMap.find(inputType.hash_code());
+    if (itIo != tables.ioMap.end()) for (const size_t intermHash : itIo->second)
     {
-        auto itIo = getConvertIoMap().find(inputObj.type().hash_code());
-        if (itIo != getConvertIoMap().end()) for (const size_t intermHash : itIo->second)
+        auto it1 = tables.convertMap.find(typesHashCombine(inputType.hash_code(), intermHash));
+        auto it2 = tables.convertMap.find(typesHashCombine(intermHash, outputType.hash_code()));
+        if (it1 != tables.convertMap.end() and it2 != tables.convertMap.end())
         {
-            auto it1 = getConvertMap().find(typesHashCombine(inputObj.type().hash_code(), intermHash));
-            auto it2 = getConvertMap().find(typesHashCombine(intermHash, outputType.hash_code()));
-            if (it1 != getConvertMap().end() and it2 != getConvertMap().end())
-            {
-                const auto &call1 = it1->second.getObject().extract<Pothos::Callable>();
-                const auto &call2 = it2->second.getObject().extract<Pothos::Callable>();
-                Pothos::Object intermediate = call1.opaqueCall(&inputObj, 1);
-                return call2.opaqueCall(&intermediate, 1);
-            }
+            call1 = &it1->second;
+            call2 = &it2->second;
+            return true;
         }
     }
+    return false;
+}
 
-    //thow an error when the conversion is not supported
-    if (it == getConvertMap().end()) throw Pothos::ObjectConvertError(
+static void throwConvertError(const std::type_info &inputType, const std::type_info &outputType)
+{
+    throw Pothos::ObjectConvertError(
         "Pothos::Object::convert()",
         Poco::format("doesnt support %s to %s",
-        inputObj.getTypeString(),
+        Pothos::Util::typeInfoToString(inputType),
         Pothos::Util::typeInfoToString(outputType)));
+}
+
+static Pothos::Object convertObject(const Pothos::Object &inputObj, const std::type_info &outputType)
+{
+    //call through the snapshot while the reader protects it,
+    //so the callables are not copied and their refcounts stay untouched
+    RegistrySnapshot<ConvertTables>::Reader tables(getConvertTables());
+    const Pothos::Callable *call1, *call2;
+    if (not findConvertCalls(*tables, inputObj.type(), outputType, call1, call2))
+    {
+        throwConvertError(inputObj.type(), outputType);
+    }
+
+    if (call2 == nullptr) return call1->opaqueCall(&inputObj, 1);
+    Pothos::Object intermediate = call1->opaqueCall(&inputObj, 1);
+    return call2->opaqueCall(&intermediate, 1);
+}
 
-    const auto &call = it->second.getObject().extract<Pothos::Callable>();
-    return call.opaqueCall(&inputObj, 1);
+size_t Pothos::Detail::getConvertGeneration(void)
+{
+    return getConvertGenerationCounter().load(std::memory_order_acquire);
+}
+
+std::vector<Pothos::Callable> Pothos::Detail::getConvertChain(const std::type_info &inputType, const std::type_info &outputType)
+{
+    std::vector<Pothos::Callable> chain;
+    if (inputType == outputType) return chain;
+
+    RegistrySnapshot<ConvertTables>::Reader tables(getConvertTables());
+    const Pothos::Callable *call1, *call2;
+    if (not findConvertCalls(*tables, inputType, outputType, call1, call2))
+    {
+        throwConvertError(inputType, outputType);
+    }
+    chain.push_back(*call1);
+    if (call2 != nullptr) chain.push_back(*call2);
+    return chain;
 }
 
 Pothos::Object Pothos::Object::convert(const std::type_info &type) const
@@ -137,20 +184,7 @@ bool Pothos::Object::canConvert(const std::type_info &type) const
 bool Pothos::Object::canConvert(const std::type_info &srcType, const std::type_info &dstType)
 {
     if (srcType == dstType) return true;
-    Pothos::Util::SpinLockRW::SharedLock lock(getMapMutex());
-    auto it = getConvertMap().find(typesHashCombine(srcType, dstType));
-
-    //try an intermediate conversion
-    if (it == getConvertMap().end())
-    {
-        auto itIo = getConvertIoMap().find(srcType.hash_code());
-        if (itIo != getConvertIoMap().end()) for (const size_t intermHash : itIo->second)
-        {
-            auto it1 = getConvertMap().find(typesHashCombine(srcType.hash_code(), intermHash));
-            auto it2 = getConvertMap().find(typesHashCombine(intermHash, dstType.hash_code()));
-            if (it1 != getConvertMap().end() and it2 != getConvertMap().end()) return true;
-        }
-    }
-
-    return (it != getConvertMap().end());
+    RegistrySnapshot<ConvertTables>::Reader tables(getConvertTables());
+    const Pothos::Callable *call1, *call2;
+    return findConvertCalls(*tables, srcType, dstType, call1, call2);
 }
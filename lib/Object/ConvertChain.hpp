@@ -0,0 +1,28 @@
+// Copyright (c) 2013-2020 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Callable/Callable.hpp>
+#include <typeinfo>
+#include <vector>
+
+namespace Pothos {
+namespace Detail {
+
+/*!
+ * The generation of the registered conversions.
+ * The generation changes when a conversion is added or removed,
+ * so that cached conversion chains can be checked for validity.
+ */
+size_t getConvertGeneration(void);
+
+/*!
+ * Get the conversion calls that turn the input type into the output type.
+ * The chain is empty for the same type and has two calls for an intermediate type.
+ * \throws ObjectConvertError when the conversion is not supported
+ */
+std::vector<Callable> getConvertChain(const std::type_info &inputType, const std::type_info &outputType);
+
+} //namespace Detail
+} //namespace Pothos
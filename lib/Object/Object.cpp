@@ -5,6 +5,7 @@
 #include <Pothos/Object/Exception.hpp>
 #include <Pothos/Util/TypeInfo.hpp>
 #include <Poco/Format.h>
+#include <new>
 #include <cassert>
 
 /***********************************************************************
@@ -36,6 +37,84 @@ Pothos::Detail::ObjectContainer::~ObjectContainer(void)
     return;
 }
 
+/***********************************************************************
+ * Small container allocation
+ *  - containers up to 64 bytes are kept in per-thread free lists,
+ *    one list per 16 byte size class, so that the Objects for numbers,
+ *    labels, and call arguments do not go through the heap each time
+ *  - a list holds a limited number of blocks, the rest go to the heap,
+ *    so blocks freed by another thread than their own do not pile up
+ **********************************************************************/
+static const size_t SmallClassBytes = 16;
+static const size_t NumSmallClasses = 4;
+static const size_t MaxCachedBlocks = 256;
+
+struct SmallBlock
+{
+    SmallBlock *next;
+};
+
+static thread_local SmallBlock *smallBlocks[NumSmallClasses];
+static thread_local size_t numSmallBlocks[NumSmallClasses];
+static thread_local bool smallBlocksExiting(false);
+
+struct SmallBlocksReleaser
+{
+    ~SmallBlocksReleaser(void)
+    {
+        smallBlocksExiting = true;
+        for (size_t i = 0; i < NumSmallClasses; i++)
+        {
+            while (smallBlocks[i] != nullptr)
+            {
+                auto block = smallBlocks[i];
+                smallBlocks[i] = block->next;
+                ::operator delete(block);
+            }
+            numSmallBlocks[i] = 0;
+        }
+    }
+};
+
+//! Can this thread cache blocks? Blocks are not cached during thread exit.
+static bool canCacheSmallBlocks(void)
+{
+    if (smallBlocksExiting) return false;
+    static thread_local SmallBlocksReleaser releaser;
+    (void)releaser;
+    return true;
+}
+
+void *Pothos::Detail::allocObjectContainer(const size_t size)
+{
+    const size_t index = (size-1)/SmallClassBytes;
+    if (index >= NumSmallClasses) return ::operator new(size);
+
+    //reuse a block from this thread's list
+    auto block = smallBlocks[index];
+    if (block != nullptr)
+    {
+        smallBlocks[index] = block->next;
+        numSmallBlocks[index]--;
+        return block;
+    }
+
+    //allocate the whole size class so the block can be reused by the class
+    return ::operator new((index+1)*SmallClassBytes);
+}
+
+void Pothos::Detail::freeObjectContainer(void *p, const size_t size)
+{
+    const size_t index = (size-1)/SmallClassBytes;
+    if (index >= NumSmallClasses or numSmallBlocks[index] >= MaxCachedBlocks or
+        not canCacheSmallBlocks()) return ::operator delete(p);
+
+    auto block = static_cast<SmallBlock *>(p);
+    block->next = smallBlocks[index];
+    smallBlocks[index] = block;
+    numSmallBlocks[index]++;
+}
+
 static void incr(Pothos::Detail::ObjectContainer *o)
 {
     if (o == nullptr) return;
@@ -1,24 +1,18 @@
 // Copyright (c) 2013-2018 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Util/RegistrySnapshot.hpp"
 #include <Pothos/Plugin/Registry.hpp>
 #include <Pothos/Plugin/Exception.hpp>
-#include <Pothos/Util/SpinLockRW.hpp>
 #include <Pothos/Callable.hpp> //gets call implementation
 #include <Poco/Logger.h>
 #include <cassert>
-#include <mutex>
+#include <memory>
 #include <map>
 
 /***********************************************************************
  * registry data structure
  **********************************************************************/
-static Pothos::Util::SpinLockRW &getRegistryMutex(void)
-{
-    static Pothos::Util::SpinLockRW lock;
-    return lock;
-}
-
 struct RegistryEntry
 {
     RegistryEntry(void):
@@ -26,7 +20,7 @@ struct RegistryEntry
     Pothos::Plugin plugin;
     bool hasPlugin;
     std::vector<std::string> nodeNamesOrdered; //so we know the order that they were added
-    std::map<std::string, RegistryEntry> nodes;
+    std::map<std::string, std::shared_ptr<RegistryEntry>> nodes; //shared between snapshots
 
     //count number of plugins here and deeper
     size_t getNumPlugins(void) const
@@ -35,18 +29,52 @@ struct RegistryEntry
         if (this->hasPlugin) count++;
         for (const auto &entry : this->nodes)
         {
-            count += entry.second.getNumPlugins();
+            count += entry.second->getNumPlugins();
         }
         return count;
     }
 };
 
-static RegistryEntry &getRegistryRoot(void)
+//singleton snapshot of the registry tree, read without locking
+static RegistrySnapshot<RegistryEntry> &getRegistryRoot(void)
 {
-    static RegistryEntry regRoot;
+    static RegistrySnapshot<RegistryEntry> regRoot;
     return regRoot;
 }
 
+//! Find the entry at the path, or null when the path has no entry
+static const RegistryEntry *findEntry(const RegistryEntry &root, const std::vector<std::string> &pathNodes)
+{
+    const RegistryEntry *entry = &root;
+    for (const auto &name : pathNodes)
+    {
+        //next node in the tree at this node name
+        auto it = entry->nodes.find(name);
+        if (it == entry->nodes.end()) return nullptr;
+        entry = it->second.get();
+    }
+    return entry;
+}
+
+//! Copy the entries along the path of a new snapshot so they can be modified,
+//! all other entries are still shared with the previous snapshots.
+static RegistryEntry &copyEntryPath(RegistryEntry &root, const std::vector<std::string> &pathNodes)
+{
+    RegistryEntry *entry = &root;
+    for (const auto &name : pathNodes)
+    {
+        auto &node = entry->nodes[name];
+        if (node) node.reset(new RegistryEntry(*node));
+        else
+        {
+            entry->nodeNamesOrdered.push_back(name);
+            node.reset(new RegistryEntry());
+        }
+        entry = node.get();
+    }
+    return *entry;
+}
+
 /***********************************************************************
  * plugin event handler
  **********************************************************************/
@@ -83,19 +111,20 @@ static void handlePluginEvent(const Pothos::Plugin &plugin, const std::string &e
     std::vector<Pothos::Plugin> parentPlugins;
 
     //traverse the tree - store a list of parent plugins
-    //we lock the mutex here for protection and make a plugin copy
+    //we read the snapshot here for protection and make a plugin copy
     {
-        Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
+        RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
         const std::vector<std::string> pathNodes = path.listNodes();
-        RegistryEntry *root = &getRegistryRoot();
+        const RegistryEntry *root = &*regRoot;
 
-        for (size_t i = 0; i+1 < pathNodes.size(); i++)
+        for (size_t i = 0; root != nullptr and i+1 < pathNodes.size(); i++)
         {
             parentPlugins.insert(parentPlugins.begin(), root->plugin);
             //next node in the tree at this node name
-            root = &root->nodes[pathNodes[i]];
+            auto it = root->nodes.find(pathNodes[i]);
+            root = (it == root->nodes.end())?nullptr:it->second.get();
         }
-        parentPlugins.insert(parentPlugins.begin(), root->plugin);
+        if (root != nullptr) parentPlugins.insert(parentPlugins.begin(), root->plugin);
     }
 
     //traverse back up the plugin tree -- calling all potential handlers
@@ -151,35 +180,27 @@ void Pothos::PluginRegistry::add(const Plugin &plugin_)
 
     poco_debug(Poco::Logger::get("Pothos.PluginRegistry.add"), plugin.toString());
 
+    getRegistryRoot().update([&](RegistryEntry &regRoot)
     {
-        std::lock_guard<Pothos::Util::SpinLockRW> lock(getRegistryMutex());
         const std::vector<std::string> pathNodes = path.listNodes();
-        RegistryEntry *root = &getRegistryRoot();
-
-        for (size_t i = 0; i < pathNodes.size(); i++)
-        {
-            auto it = std::find(root->nodeNamesOrdered.begin(), root->nodeNamesOrdered.end(), pathNodes[i]);
-            if (it == root->nodeNamesOrdered.end()) root->nodeNamesOrdered.push_back(pathNodes[i]);
-
-            //next node in the tree at this node name
-            root = &root->nodes[pathNodes[i]];
-        }
 
         //throw if the root already has a plugin
-        if (root->hasPlugin)
+        const auto existing = findEntry(regRoot, pathNodes);
+        if (existing != nullptr and existing->hasPlugin)
         {
             const auto newModulePath = getActiveModuleLoading().getFilePath();
-            const auto currentModulePath = root->plugin.getModule().getFilePath();
+            const auto currentModulePath = existing->plugin.getModule().getFilePath();
             throw Pothos::PluginRegistryError("Pothos::PluginRegistry::add("+path.toString()+")", Poco::format(
                 "plugin already registered\n\tLoading: %s, Conflicts: %s", newModulePath, currentModulePath));
         }
 
         //store the plugin and attach the module
+        auto &root = copyEntryPath(regRoot, pathNodes);
         plugin = Plugin(plugin.getPath(), plugin.getObject(), getActiveModuleLoading());
         updatePluginAssociation("add", plugin);
-        root->hasPlugin = true;
-        root->plugin = plugin;
-    }
+        root.hasPlugin = true;
+        root.plugin = plugin;
+    });
 
     handlePluginEvent(plugin, "add");
     handleMissedSubTreeEvents(plugin.getObject(), plugin.getPath());
@@ -187,18 +208,11 @@ void Pothos::PluginRegistry::add(const Plugin &plugin_)
 
 Pothos::Plugin Pothos::PluginRegistry::get(const PluginPath &path)
 {
-    Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
-    const std::vector<std::string> pathNodes = path.listNodes();
-    RegistryEntry *root = &getRegistryRoot();
-
-    for (size_t i = 0; i < pathNodes.size(); i++)
-    {
-        //next node in the tree at this node name
-        root = &root->nodes[pathNodes[i]];
-    }
+    RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
+    const auto root = findEntry(*regRoot, path.listNodes());
 
     //throw if the root does not have a plugin
-    if (not root->hasPlugin)
+    if (root == nullptr or not root->hasPlugin)
     {
         throw Pothos::PluginRegistryError("Pothos::PluginRegistry::get("+path.toString()+")", "plugin path not found");
     }
@@ -211,29 +225,24 @@ Pothos::Plugin Pothos::PluginRegistry::remove(const PluginPath &path)
     poco_debug(Poco::Logger::get("Pothos.PluginRegistry.remove"), path.toString());
 
     Plugin plugin;
+    getRegistryRoot().update([&](RegistryEntry &regRoot)
     {
-        std::lock_guard<Pothos::Util::SpinLockRW> lock(getRegistryMutex());
         const std::vector<std::string> pathNodes = path.listNodes();
-        RegistryEntry *root = &getRegistryRoot();
-
-        for (size_t i = 0; i < pathNodes.size(); i++)
-        {
-            //next node in the tree at this node name
-            root = &root->nodes[pathNodes[i]];
-        }
 
         //throw if the root does not have a plugin
-        if (not root->hasPlugin)
+        const auto existing = findEntry(regRoot, pathNodes);
+        if (existing == nullptr or not existing->hasPlugin)
         {
             throw Pothos::PluginRegistryError("Pothos::PluginRegistry::remove("+path.toString()+")", "plugin path not found");
         }
 
         //clear plugin entry and return result
-        plugin = root->plugin;
+        auto &root = copyEntryPath(regRoot, pathNodes);
+        plugin = root.plugin;
         updatePluginAssociation("remove", plugin);
-        root->hasPlugin = false;
-        root->plugin = Plugin(); //clears
-    }
+        root.hasPlugin = false;
+        root.plugin = Plugin(); //clears
+    });
 
     handlePluginEvent(plugin, "remove");
     return plugin;
@@ -241,50 +250,28 @@ Pothos::Plugin Pothos::PluginRegistry::remove(const PluginPath &path)
 
 bool Pothos::PluginRegistry::empty(const PluginPath &path)
 {
-    Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
-    const std::vector<std::string> pathNodes = path.listNodes();
-    RegistryEntry *root = &getRegistryRoot();
-
-    for (size_t i = 0; i < pathNodes.size(); i++)
-    {
-        //next node in the tree at this node name
-        root = &root->nodes[pathNodes[i]];
-    }
-
-    return not root->hasPlugin;
+    RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
+    const auto root = findEntry(*regRoot, path.listNodes());
+    return root == nullptr or not root->hasPlugin;
 }
 
 bool Pothos::PluginRegistry::exists(const PluginPath &path)
 {
-    Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
-    const std::vector<std::string> pathNodes = path.listNodes();
-    RegistryEntry *root = &getRegistryRoot();
-
-    for (size_t i = 0; i < pathNodes.size(); i++)
-    {
-        //next node in the tree at this node name
-        root = &root->nodes[pathNodes[i]];
-    }
-
-    return root->getNumPlugins() != 0;
+    RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
+    const auto root = findEntry(*regRoot, path.listNodes());
+    return root != nullptr and root->getNumPlugins() != 0;
 }
 
 std::vector<std::string> Pothos::PluginRegistry::list(const PluginPath &path)
 {
-    Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
-    const std::vector<std::string> pathNodes = path.listNodes();
-    RegistryEntry *root = &getRegistryRoot();
-
-    for (size_t i = 0; i < pathNodes.size(); i++)
-    {
-        //next node in the tree at this node name
-        root = &root->nodes[pathNodes[i]];
-    }
+    RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
+    const auto root = findEntry(*regRoot, path.listNodes());
 
     std::vector<std::string> nodes;
+    if (root == nullptr) return nodes;
     for (const auto &name : root->nodeNamesOrdered)
     {
-        if (root->nodes[name].getNumPlugins() != 0) nodes.push_back(name);
+        if (root->nodes.at(name)->getNumPlugins() != 0) nodes.push_back(name);
     }
     return nodes;
 }
@@ -308,15 +295,15 @@ static void loadInfoDump(const Pothos::PluginPath &path, const RegistryEntry &en
     for (const auto &name : entry.nodeNamesOrdered)
     {
         dump.subInfo.push_back(Pothos::PluginRegistryInfoDump());
-        loadInfoDump(path.join(name), entry.nodes.at(name), dump.subInfo.back());
+        loadInfoDump(path.join(name), *entry.nodes.at(name), dump.subInfo.back());
     }
 }
 
 Pothos::PluginRegistryInfoDump Pothos::PluginRegistry::dump(void)
 {
-    Pothos::Util::SpinLockRW::SharedLock lock(getRegistryMutex());
+    RegistrySnapshot<RegistryEntry>::Reader regRoot(getRegistryRoot());
     PluginRegistryInfoDump dump;
-    loadInfoDump(PluginPath(), getRegistryRoot(), dump);
+    loadInfoDump(PluginPath(), *regRoot, dump);
     return dump;
 }
 
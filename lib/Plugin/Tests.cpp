@@ -7,6 +7,8 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 POTHOS_TEST_BLOCK("/plugin/tests", test_plugin_path)
 {
@@ -57,3 +59,35 @@ POTHOS_TEST_BLOCK("/plugin/tests", test_plugin_registry)
     POTHOS_TEST_THROWS(Pothos::PluginRegistry::get(Pothos::PluginPath("/tests")), Pothos::PluginRegistryError);
     POTHOS_TEST_THROWS(Pothos::PluginRegistry::remove(Pothos::PluginPath("/tests/foo")), Pothos::PluginRegistryError);
 }
+
+POTHOS_TEST_BLOCK("/plugin/tests", test_plugin_registry_concurrent)
+{
+    //readers see a consistent registry while plugins are added and removed
+    Pothos::PluginRegistry::add(Pothos::Plugin("/tests/concurrent/fixed", Pothos::Object(int(42))));
+    std::atomic<bool> done(false);
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 4; i++) readers.emplace_back([&]
+    {
+        while (not done)
+        {
+            const auto plugin = Pothos::PluginRegistry::get(Pothos::PluginPath("/tests/concurrent/fixed"));
+            if (plugin.getObject().extract<int>() != 42) errors++;
+            Pothos::PluginRegistry::list(Pothos::PluginPath("/tests/concurrent"));
+        }
+    });
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        const Pothos::PluginPath path("/tests/concurrent/t"+std::to_string(i%10));
+        if (Pothos::PluginRegistry::empty(path)) Pothos::PluginRegistry::add(Pothos::Plugin(path));
+        else Pothos::PluginRegistry::remove(path);
+    }
+    done = true;
+    for (auto &reader : readers) reader.join();
+    POTHOS_TEST_EQUAL(errors.load(), 0);
+    POTHOS_TEST_FALSE(Pothos::PluginRegistry::exists(Pothos::PluginPath("/tests/concurrent/t0")));
+
+    Pothos::PluginRegistry::remove(Pothos::PluginPath("/tests/concurrent/fixed"));
+    POTHOS_TEST_FALSE(Pothos::PluginRegistry::exists(Pothos::PluginPath("/tests/concurrent")));
+}
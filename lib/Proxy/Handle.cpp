@@ -1,4 +1,4 @@
-// Copyright (c) 2013 Josh Blum
+// Copyright (c) 2013-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Proxy/Handle.hpp>
@@ -7,3 +7,17 @@ Pothos::ProxyHandle::~ProxyHandle(void)
 {
     return;
 }
+
+std::future<Pothos::Proxy> Pothos::ProxyHandle::callAsync(const std::string &name, const Proxy *args, const size_t numArgs)
+{
+    std::promise<Proxy> result;
+    try
+    {
+        result.set_value(this->call(name, args, numArgs));
+    }
+    catch (...)
+    {
+        result.set_exception(std::current_exception());
+    }
+    return result.get_future();
+}
@@ -1,16 +1,27 @@
 // Copyright (c) 2013-2017 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Remote/RemoteProxy.hpp"
+#include "Remote/RemoteProxyDatagram.hpp"
 #include <Pothos/Testing.hpp>
 #include <Pothos/Plugin.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Remote.hpp>
 #include <Pothos/Managed.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
 #include <Pothos/Util/Network.hpp>
 #include <Poco/Pipe.h>
 #include <Poco/PipeStream.h>
 #include <Poco/URI.h>
+#include <Poco/ByteOrder.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Net/SocketStream.h>
+#include <Poco/Net/SocketAddress.h>
 #include <iostream>
+#include <sstream>
 #include <future>
 #include <thread>
 #include <cstdlib>
@@ -18,6 +29,11 @@
 #include <algorithm>
 #include <cstdlib> //atoi
 
+#ifdef POCO_HAS_UNIX_SOCKET
+#include <sys/stat.h> //lstat
+#include <unistd.h> //geteuid
+#endif
+
 class SuperBar
 {
 public:
@@ -230,3 +246,370 @@ POTHOS_TEST_BLOCK("/proxy/remote/tests", test_multithread_safe)
     //therefore to be safe, we unregister these classes now
     Pothos::ManagedClass::unload("EchoTester");
 }
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_datagram_formats)
+{
+    Pothos::BufferChunk buff(Pothos::DType(typeid(int)), 300000);
+    for (size_t i = 0; i < buff.elements(); i++) buff.as<int *>()[i] = int(i);
+
+    Pothos::ObjectKwargs args;
+    args["small"] = Pothos::Object(42);
+    args["str"] = Pothos::Object(std::string("hello"));
+    args["buff"] = Pothos::Object(buff);
+
+    for (const int format : {int(PRPC_FORMAT_STREAM), int(PRPC_FORMAT_CHUNKED)})
+    {
+        //back to back datagrams stay in order
+        std::stringstream ss;
+        sendDatagram(ss, args, format);
+        sendDatagram(ss, args, format);
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            int recvFormat = 0;
+            const auto out = recvDatagram(ss, recvFormat);
+            POTHOS_TEST_EQUAL(recvFormat, format);
+            POTHOS_TEST_EQUAL(out.at("small").extract<int>(), 42);
+            POTHOS_TEST_EQUAL(out.at("str").extract<std::string>(), "hello");
+            const auto &outBuff = out.at("buff").extract<Pothos::BufferChunk>();
+            POTHOS_TEST_EQUAL(outBuff.length, buff.length);
+            POTHOS_TEST_EQUALA(outBuff.as<const int *>(), buff.as<const int *>(), buff.elements());
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_handler_aborted_datagram)
+{
+    //a chunked datagram that the sender aborted after the first chunk
+    std::stringstream is, os;
+    const uint32_t words[] = {
+        Poco::ByteOrder::toNetwork(uint32_t(0x50525032)), //PRP2
+        Poco::ByteOrder::toNetwork(uint32_t(4)), 0,
+        Poco::ByteOrder::toNetwork(~uint32_t(0)), //abort chunk
+        Poco::ByteOrder::toNetwork(uint32_t(0x32505250))}; //2PRP
+    is.write((const char *)words, sizeof(words));
+
+    //followed by a valid request on the same connection
+    Pothos::ObjectKwargs req;
+    req["action"] = Pothos::Object(std::string("RemoteProxyEnvironment"));
+    req["name"] = Pothos::Object(std::string("managed"));
+    req["tid"] = Pothos::Object(size_t(1));
+    sendDatagram(is, req, PRPC_FORMAT_CHUNKED);
+
+    //the aborted request is rejected without a reply
+    Pothos::RemoteHandler handler;
+    POTHOS_TEST_TRUE(not handler.runHandlerOnce(is, os));
+    POTHOS_TEST_EQUAL(os.str().size(), 0);
+
+    //and the next request is still served
+    POTHOS_TEST_TRUE(not handler.runHandlerOnce(is, os));
+    const auto reply = recvDatagram(os);
+    POTHOS_TEST_EQUAL(reply.at("tid").convert<size_t>(), 1);
+    POTHOS_TEST_EQUAL(reply.count("errorMsg"), 0);
+
+    //cleanup the environment
+    req.clear();
+    req["action"] = Pothos::Object(std::string("~RemoteProxyEnvironment"));
+    req["envID"] = reply.at("envID");
+    req["tid"] = Pothos::Object(size_t(2));
+    sendDatagram(is, req, PRPC_FORMAT_CHUNKED);
+    POTHOS_TEST_TRUE(handler.runHandlerOnce(is, os));
+}
+
+struct BufferTester
+{
+    static Pothos::BufferChunk reverse(const Pothos::BufferChunk &in)
+    {
+        Pothos::BufferChunk out(in.dtype, in.elements());
+        std::reverse_copy(in.as<const int *>(), in.as<const int *>()+in.elements(), out.as<int *>());
+        return out;
+    }
+};
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_buffer_args)
+{
+    Pothos::ManagedClass()
+        .registerClass<BufferTester>()
+        .registerStaticMethod(POTHOS_FCN_TUPLE(BufferTester, reverse))
+        .commit("BufferTester");
+
+    //an in-process handler has the runtime registration
+    Poco::Pipe p0, p1;
+    Poco::PipeInputStream is(p1);
+    Poco::PipeOutputStream os(p0);
+    std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed");
+        auto tester = env->findProxy("BufferTester");
+        for (const size_t numElems : {size_t(1), size_t(1000), size_t(1 << 20)})
+        {
+            Pothos::BufferChunk in(Pothos::DType(typeid(int)), numElems);
+            for (size_t i = 0; i < numElems; i++) in.as<int *>()[i] = int(i);
+            const auto out = tester.call<Pothos::BufferChunk>("reverse", in);
+            POTHOS_TEST_EQUAL(out.elements(), numElems);
+            POTHOS_TEST_EQUAL(out.as<const int *>()[0], int(numElems-1));
+            POTHOS_TEST_EQUAL(out.as<const int *>()[numElems-1], 0);
+        }
+    }
+    t0.join();
+
+    //the socket connection sends and receives buffers directly
+    Pothos::RemoteServer server("tcp://"+Pothos::Util::getWildcardAddr());
+    Pothos::RemoteClient client("tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort()));
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(client.getIoStream(), "managed");
+        Pothos::BufferChunk in(Pothos::DType(typeid(int)), 1 << 20);
+        for (size_t i = 0; i < in.elements(); i++) in.as<int *>()[i] = int(i);
+        const auto out = env->convertProxyToObject(env->convertObjectToProxy(Pothos::Object(in))).extract<Pothos::BufferChunk>();
+        POTHOS_TEST_EQUAL(out.length, in.length);
+        POTHOS_TEST_EQUALA(out.as<const int *>(), in.as<const int *>(), in.elements());
+    }
+
+    Pothos::ManagedClass::unload("BufferTester");
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_call_async)
+{
+    Pothos::ManagedClass()
+        .registerClass<EchoTester>()
+        .registerStaticMethod(POTHOS_FCN_TUPLE(EchoTester, echo))
+        .commit("EchoTester");
+
+    //the default implementation makes the call synchronously
+    {
+        auto env = Pothos::ProxyEnvironment::make("managed");
+        auto result = env->findProxy("EchoTester").callAsync("echo", 42);
+        POTHOS_TEST_EQUAL(result.get().convert<int>(), 42);
+    }
+
+    Poco::Pipe p0, p1;
+    Poco::PipeInputStream is(p1);
+    Poco::PipeOutputStream os(p0);
+    std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed");
+        auto echoTester = env->findProxy("EchoTester");
+
+        //pipeline many calls from one thread
+        std::vector<std::future<Pothos::Proxy>> futures;
+        for (int i = 0; i < 100; i++) futures.push_back(echoTester.callAsync("echo", i));
+
+        //replies are matched to the calls in any order
+        for (int i = 99; i >= 0; i--)
+        {
+            POTHOS_TEST_EQUAL(futures[i].get().convert<int>(), i);
+        }
+
+        //errors are reported through the future
+        auto bad = echoTester.callAsync("noSuchMethod");
+        POTHOS_TEST_THROWS(bad.get(), Pothos::ProxyHandleCallError);
+
+        //a converted proxy is the same object when used again
+        auto arg = env->makeProxy(123);
+        POTHOS_TEST_EQUAL(arg.convert<int>(), 123);
+        POTHOS_TEST_EQUAL(echoTester.call<int>("echo", arg), 123);
+        POTHOS_TEST_EQUAL(arg.compareTo(arg), 0);
+
+        //replies to dropped futures are discarded when received
+        auto remoteEnv = std::dynamic_pointer_cast<RemoteProxyEnvironment>(env);
+        for (int i = 0; i < 10; i++) echoTester.callAsync("echo", i);
+        POTHOS_TEST_EQUAL(echoTester.call("echo", 7).convert<int>(), 7);
+        POTHOS_TEST_TRUE(remoteEnv->ridToReply.empty());
+    }
+    t0.join();
+
+    Pothos::ManagedClass::unload("EchoTester");
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_archive_version)
+{
+    Poco::Pipe p0, p1;
+    Poco::PipeInputStream is(p1);
+    Poco::PipeOutputStream os(p0);
+    std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+    {
+        //both sides read version 3, so numeric vectors are sent as a block
+        auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed");
+        auto remoteEnv = std::dynamic_pointer_cast<RemoteProxyEnvironment>(env);
+        POTHOS_TEST_EQUAL(remoteEnv->archiveVersion, POTHOS_ARCHIVE_VERSION);
+
+        std::vector<int> x;
+        for (int i = 0; i < 1000; i++) x.push_back(i*7 - 300);
+        const auto y = env->makeProxy(x).convert<std::vector<int>>();
+        POTHOS_TEST_EQUALV(x, y);
+    }
+    t0.join();
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_batch)
+{
+    Pothos::ManagedClass()
+        .registerClass<EchoTester>()
+        .registerStaticMethod(POTHOS_FCN_TUPLE(EchoTester, echo))
+        .commit("EchoTester");
+
+    Poco::Pipe p0, p1;
+    Poco::PipeInputStream is(p1);
+    Poco::PipeOutputStream os(p0);
+    std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed");
+        auto remoteEnv = std::dynamic_pointer_cast<RemoteProxyEnvironment>(env);
+        POTHOS_TEST_TRUE(remoteEnv->batchRequests);
+
+        //each request in the batch gets its own reply
+        Pothos::ObjectKwargs request;
+        request["action"] = Pothos::Object("findProxy");
+        request["envID"] = Pothos::Object(remoteEnv->remoteID);
+        request["name"] = Pothos::Object("EchoTester");
+        Pothos::ObjectVector requests;
+        requests.push_back(Pothos::Object(request));
+        request["name"] = Pothos::Object("NoSuchClass");
+        requests.push_back(Pothos::Object(request));
+        Pothos::ObjectKwargs batch;
+        batch["action"] = Pothos::Object("batch");
+        batch["requests"] = Pothos::Object(requests);
+        const auto replies = remoteEnv->transact(batch).at("replies").extract<Pothos::ObjectVector>();
+        POTHOS_TEST_EQUAL(replies.size(), 2);
+        POTHOS_TEST_EQUAL(replies[0].extract<Pothos::ObjectKwargs>().count("handleID"), 1);
+        POTHOS_TEST_EQUAL(replies[1].extract<Pothos::ObjectKwargs>().count("errorMsg"), 1);
+        remoteEnv->releaseHandle(replies[0].extract<Pothos::ObjectKwargs>().at("handleID"));
+
+        //released handles are sent with the next request
+        auto echoTester = env->findProxy("EchoTester");
+        for (int i = 0; i < 100; i++)
+        {
+            POTHOS_TEST_EQUAL(echoTester.call<int>("echo", i), i);
+        }
+        POTHOS_TEST_TRUE(remoteEnv->discardReplies.empty());
+    }
+    t0.join();
+
+    //the client args opt out of batching and the chunked format
+    Poco::Pipe p2, p3;
+    Poco::PipeInputStream is3(p3);
+    Poco::PipeOutputStream os2(p2);
+    std::thread t1(&runRemoteProxy, std::ref(p2), std::ref(p3));
+    {
+        Pothos::ProxyEnvironmentArgs args;
+        args["wireFormat"] = "stream";
+        args["batch"] = "false";
+        auto env = Pothos::RemoteClient::makeEnvironment(is3, os2, "managed", args);
+        auto remoteEnv = std::dynamic_pointer_cast<RemoteProxyEnvironment>(env);
+        POTHOS_TEST_TRUE(not remoteEnv->batchRequests);
+        POTHOS_TEST_EQUAL(remoteEnv->wireFormat, PRPC_FORMAT_STREAM);
+        auto echoTester = env->findProxy("EchoTester");
+        POTHOS_TEST_EQUAL(echoTester.call("echo", 42).convert<int>(), 42);
+    }
+    t1.join();
+
+    Pothos::ManagedClass::unload("EchoTester");
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_stale_handle)
+{
+    Poco::Pipe p0, p1;
+    Poco::PipeInputStream is(p1);
+    Poco::PipeOutputStream os(p0);
+    std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+    {
+        auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed");
+        auto remoteEnv = std::dynamic_pointer_cast<RemoteProxyEnvironment>(env);
+
+        Pothos::ObjectKwargs req;
+        req["action"] = Pothos::Object("findProxy");
+        req["envID"] = Pothos::Object(remoteEnv->remoteID);
+        req["name"] = Pothos::Object("Pothos/BufferChunk");
+        const size_t handleID = remoteEnv->transact(req).at("handleID");
+        remoteEnv->releaseHandle(handleID);
+
+        //IDs fit in the size_t of a 32-bit client
+        POTHOS_TEST_TRUE((unsigned long long)(handleID) <= 0xffffffffull);
+        POTHOS_TEST_TRUE((unsigned long long)(remoteEnv->remoteID) <= 0xffffffffull);
+
+        //the release is sent with the next request, then the ID is invalid
+        auto chunkClass = env->findProxy("Pothos/BufferChunk");
+        req.clear();
+        req["action"] = Pothos::Object("toString");
+        req["handleID"] = Pothos::Object(handleID);
+        POTHOS_TEST_EQUAL(remoteEnv->transact(req).count("errorMsg"), 1);
+    }
+    t0.join();
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_multi_client)
+{
+    Pothos::RemoteServer server("tcp://"+Pothos::Util::getWildcardAddr());
+    const auto uri = "tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort());
+
+    //each client creates and releases objects on the server concurrently
+    auto clientTask = [uri](const size_t clientNo)
+    {
+        Pothos::RemoteClient client(uri);
+        auto env = Pothos::RemoteClient::makeEnvironment(client.getIoStream(), "managed");
+        auto chunkClass = env->findProxy("Pothos/BufferChunk");
+        for (size_t i = 0; i < 1000; i++)
+        {
+            const size_t length = clientNo*1000 + i + 1;
+            auto chunk = chunkClass(length);
+            if (chunk.get<size_t>("length") != length) return false;
+        }
+        return true;
+    };
+
+    std::vector<std::future<bool>> results;
+    for (size_t clientNo = 0; clientNo < 8; clientNo++)
+    {
+        results.push_back(std::async(std::launch::async, clientTask, clientNo));
+    }
+    for (auto &result : results) POTHOS_TEST_TRUE(result.get());
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_remote_local_socket)
+{
+    #ifdef POCO_HAS_UNIX_SOCKET
+    Pothos::RemoteServer server("tcp://"+Pothos::Util::getWildcardAddr());
+    const auto uri = "tcp://"+Pothos::Util::getLoopbackAddr(server.getActualPort());
+    const auto path = Pothos::RemoteServer::getLocalSocketPath(server.getActualPort());
+    POTHOS_TEST_TRUE(Poco::File(path).exists());
+
+    //the socket is in a directory that only this user can enter
+    struct stat st;
+    POTHOS_TEST_EQUAL(::lstat(Poco::Path(path).parent().toString().c_str(), &st), 0);
+    POTHOS_TEST_EQUAL(st.st_uid, ::geteuid());
+    POTHOS_TEST_EQUAL(st.st_mode & 077, 0);
+
+    //the server accepts environments over the local socket
+    {
+        Poco::Net::StreamSocket socket(Poco::Net::SocketAddress(Poco::Net::SocketAddress::UNIX_LOCAL, path));
+        Poco::Net::SocketStream socketStream(socket);
+        auto env = Pothos::RemoteClient::makeEnvironment(socketStream, "managed");
+        auto chunk = env->findProxy("Pothos/BufferChunk")(size_t(16));
+        POTHOS_TEST_EQUAL(chunk.get<size_t>("length"), 16);
+    }
+
+    //a loopback client connects through the local socket
+    {
+        Pothos::RemoteClient client(uri);
+        auto env = client.makeEnvironment("managed");
+        auto chunk = env->findProxy("Pothos/BufferChunk")(size_t(16));
+        POTHOS_TEST_EQUAL(chunk.get<size_t>("length"), 16);
+    }
+
+    //a stale socket file without a listener falls back to TCP
+    Poco::File(path).renameTo(path+".moved");
+    {
+        Poco::Net::ServerSocket stale(Poco::Net::SocketAddress(Poco::Net::SocketAddress::UNIX_LOCAL, path));
+        stale.close();
+    }
+    POTHOS_TEST_TRUE(Poco::File(path).exists());
+    {
+        Pothos::RemoteClient client(uri);
+        auto env = client.makeEnvironment("managed");
+        auto chunk = env->findProxy("Pothos/BufferChunk")(size_t(16));
+        POTHOS_TEST_EQUAL(chunk.get<size_t>("length"), 16);
+    }
+    Poco::File(path).remove();
+    Poco::File(path+".moved").renameTo(path);
+    #endif
+}
@@ -11,6 +11,13 @@
 #include <map>
 #include <cassert>
 
+#ifdef POCO_HAS_UNIX_SOCKET
+#include <sys/types.h>
+#include <sys/stat.h> //lstat
+#include <sys/socket.h> //getsockopt
+#include <unistd.h> //geteuid
+#endif
+
 /***********************************************************************
  * lookupIpFromNodeId implementation
  **********************************************************************/
@@ -92,6 +99,34 @@ static Poco::Net::IPAddress dnsLookup(const std::string &host, const long timeou
     return ipAddr;
 }
 
+/***********************************************************************
+ * Local socket ownership checks
+ **********************************************************************/
+#ifdef POCO_HAS_UNIX_SOCKET
+//! The socket file must be a socket created by this user
+static bool isOwnedSocketFile(const std::string &path)
+{
+    struct stat st;
+    if (::lstat(path.c_str(), &st) != 0) return false;
+    return S_ISSOCK(st.st_mode) and st.st_uid == ::geteuid();
+}
+
+//! The process on the other end must run as this user
+static bool isOwnedPeer(const int fd)
+{
+    #ifdef SO_PEERCRED
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) return false;
+    return cred.uid == ::geteuid();
+    #else
+    uid_t uid; gid_t gid;
+    if (::getpeereid(fd, &uid, &gid) != 0) return false;
+    return uid == ::geteuid();
+    #endif
+}
+#endif
+
 /***********************************************************************
  * RemoteClient implementation
  **********************************************************************/
@@ -127,6 +162,9 @@ struct Pothos::RemoteClient::Impl
             throw RemoteClientError("Pothos::RemoteClient("+uriStr+")", ex.displayText());
         }
 
+        //a server on this host also listens on a local socket
+        if (this->sa.host().isLoopback() and this->connectLocal(std::to_string(port), timeoutUs)) return;
+
         //try to connect to the server
         try
         {
@@ -139,6 +177,28 @@ struct Pothos::RemoteClient::Impl
 
         clientSocket.setNoDelay(true);
     }
+
+    //! Try the server's local socket, false to fall back to TCP
+    bool connectLocal(const std::string &port, const long timeoutUs)
+    {
+        #ifdef POCO_HAS_UNIX_SOCKET
+        const auto path = RemoteServer::getLocalSocketPath(port);
+        if (path.empty() or not isOwnedSocketFile(path)) return false;
+        try
+        {
+            clientSocket.connect(Poco::Net::SocketAddress(Poco::Net::SocketAddress::UNIX_LOCAL, path), Poco::Timespan(0, timeoutUs));
+            if (isOwnedPeer(clientSocket.impl()->sockfd())) return true;
+        }
+        catch (const Poco::Exception &)
+        {
+            //stale socket file, re-open as TCP
+        }
+        clientSocket.close();
+        #else
+        (void)port; (void)timeoutUs;
+        #endif
+        return false;
+    }
     Poco::Net::StreamSocket clientSocket;
     Poco::Net::SocketStream socketStream;
     const std::string uriStr;
@@ -10,48 +10,163 @@
 #include <sstream>
 #include <thread>
 #include <cstdint>
+#include <algorithm> //min
 
-Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs &reqArgs_)
+Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs &reqArgs)
+{
+    return this->recvReply(this->sendRequest(reqArgs));
+}
+
+/*!
+ * The state of an asynchronous request shared by the copies of its future.
+ * When the last copy is destroyed without waiting on the reply,
+ * the reply is discarded so that it does not stay in the reply cache.
+ */
+struct PendingReply
+{
+    PendingReply(const std::shared_ptr<RemoteProxyEnvironment> &env, const uint32_t rid):
+        env(env), rid(rid), received(false){}
+
+    ~PendingReply(void)
+    {
+        if (received) return;
+        try
+        {
+            env->discardReply(rid);
+        }
+        catch (const Pothos::Exception &ex)
+        {
+            if (not env->connectionActive) return;
+            poco_error(Poco::Logger::get("Pothos.RemoteProxyHandle"), "discard reply threw: "+ex.displayText());
+        }
+    }
+
+    Pothos::ObjectKwargs get(void)
+    {
+        received = true;
+        return env->recvReply(rid);
+    }
+
+    const std::shared_ptr<RemoteProxyEnvironment> env;
+    const uint32_t rid;
+    bool received;
+};
+
+std::shared_future<Pothos::ObjectKwargs> RemoteProxyEnvironment::transactAsync(const Pothos::ObjectKwargs &reqArgs)
+{
+    const auto rid = this->sendRequest(reqArgs);
+    auto env = std::static_pointer_cast<RemoteProxyEnvironment>(this->shared_from_this());
+    std::shared_ptr<PendingReply> pending(new PendingReply(env, rid));
+    return std::async(std::launch::deferred, [pending](void){return pending->get();});
+}
+
+void RemoteProxyEnvironment::discardReply(const uint32_t rid)
+{
+    Pothos::ObjectKwargs reply;
+    {
+        std::lock_guard<std::mutex> lock(isMutex);
+        auto it = ridToReply.find(rid);
+
+        //the reply is reaped by the thread that receives it
+        if (it == ridToReply.end())
+        {
+            discardReplies.insert(rid);
+            return;
+        }
+
+        //the reply was already received by another thread
+        reply = it->second;
+        ridToReply.erase(it);
+    }
+    this->reapReply(reply);
+}
+
+void RemoteProxyEnvironment::reapReply(const Pothos::ObjectKwargs &reply)
+{
+    //a batch reply has a reply for each request
+    const auto repliesIt = reply.find("replies");
+    if (repliesIt != reply.end())
+    {
+        for (const auto &subReply : repliesIt->second.extract<Pothos::ObjectVector>())
+        {
+            this->reapReply(subReply.extract<Pothos::ObjectKwargs>());
+        }
+        return;
+    }
+
+    //log the error that nobody will receive
+    auto errorMsgIt = reply.find("errorMsg");
+    if (errorMsgIt != reply.end())
+    {
+        poco_error(Poco::Logger::get("Pothos.RemoteProxyHandle"), "discarded reply: "+errorMsgIt->second.extract<std::string>());
+    }
+
+    //release the object that was created on the server for the reply
+    auto handleIt = reply.find("handleID");
+    if (handleIt != reply.end()) try
+    {
+        this->releaseHandle(handleIt->second.convert<size_t>());
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        if (not connectionActive) return;
+        poco_error(Poco::Logger::get("Pothos.RemoteProxyHandle"), "release handle threw: "+ex.displayText());
+    }
+}
+
+uint32_t RemoteProxyEnvironment::sendRequest(const Pothos::ObjectKwargs &reqArgs_)
 {
     if (not connectionActive)
     {
         throw Pothos::IOException("RemoteProxyEnvironment::transact()", "connection inactive");
     }
 
-    //add the thread ID to the args
-    //tid must be a fixed size type so it doesn't get truncated through serialization
-    const auto tid = uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    //add a unique request ID to the args, the server echos it in the reply
+    //the "tid" key is kept from when replies were matched by thread ID
+    //rid must be a fixed size type so it doesn't get truncated through serialization
+    const auto rid = uint32_t(nextRequestId++);
     auto reqArgs = reqArgs_;
-    reqArgs["tid"] = Pothos::Object(tid);
+    reqArgs["tid"] = Pothos::Object(rid);
 
     //send request object over output stream
     POTHOS_EXCEPTION_TRY
     {
         std::lock_guard<std::mutex> lock(osMutex);
-        sendDatagram(os, reqArgs);
+        this->flushReleases();
+        sendDatagram(os, reqArgs, wireFormat, archiveVersion);
     }
     POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
     {
         connectionActive = false;
         throw Pothos::IOException("RemoteProxyEnvironment::sendDatagram()", ex.message());
     }
+    return rid;
+}
 
+Pothos::ObjectKwargs RemoteProxyEnvironment::recvReply(const uint32_t rid)
+{
     //wait for reply object
     while (true)
     {
         std::unique_lock<std::mutex> lock(isMutex);
 
         //is there a reply in the cache?
-        auto it = tidToReply.find(tid);
-        if (it != tidToReply.end())
+        auto it = ridToReply.find(rid);
+        if (it != ridToReply.end())
         {
             auto reply = it->second;
-            tidToReply.erase(it);
+            ridToReply.erase(it);
             lock.unlock();
             isCond.notify_all();
             return reply;
         }
 
+        //the connection failed while waiting on another thread
+        if (not connectionActive)
+        {
+            throw Pothos::IOException("RemoteProxyEnvironment::recvDatagram()", "connection inactive");
+        }
+
         //a thread is blocking on the input stream wait here
         if (isBlocking)
         {
@@ -70,35 +185,115 @@ Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs
         }
         POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
         {
+            lock.lock();
             isBlocking = false;
-            isCond.notify_all();
             connectionActive = false;
+            lock.unlock();
+            isCond.notify_all();
             throw Pothos::IOException("RemoteProxyEnvironment::recvDatagram()", ex.message());
         }
         lock.lock();
         isBlocking = false;
 
-        //this is our thread ID, reply args
-        const size_t replyTid(replyArgs.at("tid"));
-        if (replyTid == tid)
+        //this is our request ID, reply args
+        const uint32_t replyRid(replyArgs.at("tid"));
+        if (replyRid == rid)
         {
             lock.unlock();
             isCond.notify_all();
             return replyArgs;
         }
 
+        //nobody is waiting on this reply, reap it outside of the lock
+        auto discardIt = discardReplies.find(replyRid);
+        if (discardIt != discardReplies.end())
+        {
+            discardReplies.erase(discardIt);
+            lock.unlock();
+            isCond.notify_all();
+            this->reapReply(replyArgs);
+            continue;
+        }
+
         //otherwise store to the reply cache
-        tidToReply[replyTid] = replyArgs;
+        ridToReply[replyRid] = replyArgs;
         lock.unlock();
         isCond.notify_all();
     }
 }
 
+void RemoteProxyEnvironment::releaseHandle(const size_t handleID)
+{
+    //create request
+    Pothos::ObjectKwargs req;
+    req["action"] = Pothos::Object("~RemoteProxyHandle");
+    req["handleID"] = Pothos::Object(handleID);
+
+    //wait for the server to release the handle
+    if (not batchRequests)
+    {
+        this->transact(req);
+        return;
+    }
+
+    //or release it with the next request
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    pendingReleases.push_back(handleID);
+}
+
+void RemoteProxyEnvironment::flushReleases(void)
+{
+    std::vector<size_t> handleIDs;
+    {
+        std::lock_guard<std::mutex> lock(releaseMutex);
+        handleIDs.swap(pendingReleases);
+    }
+    if (handleIDs.empty()) return;
+
+    //create a batch request with a release for each handle
+    Pothos::ObjectVector batch;
+    for (const auto handleID : handleIDs)
+    {
+        Pothos::ObjectKwargs release;
+        release["action"] = Pothos::Object("~RemoteProxyHandle");
+        release["handleID"] = Pothos::Object(handleID);
+        batch.push_back(Pothos::Object(release));
+    }
+    const auto rid = uint32_t(nextRequestId++);
+    Pothos::ObjectKwargs req;
+    req["action"] = Pothos::Object("batch");
+    req["requests"] = Pothos::Object(batch);
+    req["tid"] = Pothos::Object(rid);
+
+    //the reply is discarded when it is received
+    {
+        std::lock_guard<std::mutex> lock(isMutex);
+        discardReplies.insert(rid);
+    }
+    try
+    {
+        sendDatagram(os, req, wireFormat, archiveVersion);
+    }
+
+    //the releases were not sent, keep them for the next request
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(isMutex);
+            discardReplies.erase(rid);
+        }
+        std::lock_guard<std::mutex> lock(releaseMutex);
+        pendingReleases.insert(pendingReleases.begin(), handleIDs.begin(), handleIDs.end());
+        throw;
+    }
+}
+
 RemoteProxyEnvironment::RemoteProxyEnvironment(
     std::istream &is, std::ostream &os,
     const std::string &name, const Pothos::ProxyEnvironmentArgs &args
 ):
-    is(is), os(os), name(name), connectionActive(true), isBlocking(false)
+    is(is), os(os), name(name), connectionActive(true), wireFormat(PRPC_FORMAT_STREAM), archiveVersion(POTHOS_ARCHIVE_VERSION_COMPAT), inlineArgs(false), batchRequests(false),
+    isBlocking(false), nextRequestId(0)
 {
     //create request
     Pothos::ObjectKwargs req;
@@ -108,6 +303,22 @@ RemoteProxyEnvironment::RemoteProxyEnvironment(
     }
     req["action"] = Pothos::Object("RemoteProxyEnvironment");
     req["name"] = Pothos::Object(name);
+    req["inlineArgs"] = Pothos::Object(true);
+    req["archiveVersion"] = Pothos::Object(int(POTHOS_ARCHIVE_VERSION));
+
+    //the client args can opt out of the chunked format and batching
+    req.erase("wireFormat");
+    req.erase("batch");
+    const auto wireFormatArg = args.find("wireFormat");
+    const auto batchArg = args.find("batch");
+    if (wireFormatArg == args.end() or wireFormatArg->second != "stream")
+    {
+        req["wireFormat"] = Pothos::Object(int(PRPC_FORMAT_CHUNKED));
+    }
+    if (batchArg == args.end() or batchArg->second != "false")
+    {
+        req["batch"] = Pothos::Object(true);
+    }
 
     auto reply = this->transact(req);
 
@@ -121,6 +332,27 @@ RemoteProxyEnvironment::RemoteProxyEnvironment(
     upid = reply["upid"].convert<std::string>();
     nodeId = reply["nodeId"].convert<std::string>();
     peerAddr = reply["peerAddr"].convert<std::string>();
+
+    //servers that support the chunked format reply with it
+    auto wireFormatIt = reply.find("wireFormat");
+    if (wireFormatIt != reply.end())
+    {
+        wireFormat = std::min<int>(PRPC_FORMAT_CHUNKED, wireFormatIt->second.convert<int>());
+    }
+
+    //servers that read newer archive versions reply with the common version,
+    //older servers do not check the archive version and read the compat version
+    auto archiveVersionIt = reply.find("archiveVersion");
+    if (archiveVersionIt != reply.end())
+    {
+        archiveVersion = unsigned(std::min<int>(POTHOS_ARCHIVE_VERSION, archiveVersionIt->second.convert<int>()));
+    }
+
+    //servers that accept local objects as call arguments reply with it
+    inlineArgs = reply.count("inlineArgs") != 0;
+
+    //servers that accept batched requests reply with it
+    batchRequests = reply.count("batch") != 0;
 }
 
 RemoteProxyEnvironment::~RemoteProxyEnvironment(void)
@@ -147,6 +379,12 @@ Pothos::Proxy RemoteProxyEnvironment::makeHandle(const size_t remoteID)
     return Pothos::Proxy(new RemoteProxyHandle(env, remoteID));
 }
 
+Pothos::Proxy RemoteProxyEnvironment::makeLocalHandle(const Pothos::Object &local)
+{
+    auto env = std::dynamic_pointer_cast<RemoteProxyEnvironment>(this->shared_from_this());
+    return Pothos::Proxy(new RemoteProxyHandle(env, local));
+}
+
 std::shared_ptr<RemoteProxyHandle> RemoteProxyEnvironment::getHandle(const Pothos::Proxy &proxy)
 {
     //check if the proxy environment is for the same server
@@ -181,6 +419,15 @@ Pothos::Proxy RemoteProxyEnvironment::findProxy(const std::string &name)
 }
 
 Pothos::Proxy RemoteProxyEnvironment::convertObjectToProxy(const Pothos::Object &local)
+{
+    //the conversion is deferred until the handle is used,
+    //and temporary call arguments are sent along with the call
+    if (inlineArgs) return this->makeLocalHandle(local);
+
+    return this->makeHandle(this->convertObjectToRemoteID(local));
+}
+
+size_t RemoteProxyEnvironment::convertObjectToRemoteID(const Pothos::Object &local)
 {
     //create request
     Pothos::ObjectKwargs req;
@@ -195,19 +442,22 @@ Pothos::Proxy RemoteProxyEnvironment::convertObjectToProxy(const Pothos::Object
     if (errorMsgIt != reply.end()) throw Pothos::ProxyEnvironmentConvertError(
         "RemoteProxyEnvironment::convertObjectToProxy()", errorMsgIt->second.extract<std::string>());
 
-    //otherwise make a handle
-    return this->makeHandle(reply["handleID"]);
+    return reply["handleID"];
 }
 
 Pothos::Object RemoteProxyEnvironment::convertProxyToObject(const Pothos::Proxy &proxy)
 {
     auto handle = this->getHandle(proxy);
 
+    //the local object was never converted
+    Pothos::Object local;
+    if (handle->tryGetLocal(local)) return local;
+
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("convertProxyToObject");
     req["envID"] = Pothos::Object(this->remoteID);
-    req["handleID"] = Pothos::Object(handle->remoteID);
+    req["handleID"] = Pothos::Object(handle->getRemoteID());
 
     auto reply = this->transact(req);
 
@@ -7,6 +7,11 @@
 #include <Pothos/Object/Containers.hpp>
 #include <mutex>
 #include <condition_variable>
+#include <future>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <set>
 
 class RemoteProxyHandle;
 
@@ -24,6 +29,8 @@ public:
 
     Pothos::Proxy makeHandle(const size_t remoteID);
 
+    Pothos::Proxy makeLocalHandle(const Pothos::Object &local);
+
     std::shared_ptr<RemoteProxyHandle> getHandle(const Pothos::Proxy &proxy);
 
     std::string getNodeId(void) const
@@ -50,6 +57,9 @@ public:
 
     Pothos::Proxy convertObjectToProxy(const Pothos::Object &local);
 
+    //! Convert the local object on the server and return its ID
+    size_t convertObjectToRemoteID(const Pothos::Object &local);
+
     Pothos::Object convertProxyToObject(const Pothos::Proxy &proxy);
 
     void serialize(const Pothos::Proxy &, std::ostream &)
@@ -64,6 +74,34 @@ public:
 
     Pothos::ObjectKwargs transact(const Pothos::ObjectKwargs &request);
 
+    /*!
+     * Send the request without waiting for the reply.
+     * The returned future waits for the reply when accessed.
+     * The reply is discarded when the future is destroyed without access.
+     */
+    std::shared_future<Pothos::ObjectKwargs> transactAsync(const Pothos::ObjectKwargs &request);
+
+    //! Nobody will wait on the reply, reap it now or when it is received
+    void discardReply(const uint32_t rid);
+
+    //! Release the objects created for a discarded reply and log its errors
+    void reapReply(const Pothos::ObjectKwargs &reply);
+
+    //! Send the request and return its request ID
+    uint32_t sendRequest(const Pothos::ObjectKwargs &request);
+
+    //! Wait for the reply to the request with the given ID
+    Pothos::ObjectKwargs recvReply(const uint32_t rid);
+
+    /*!
+     * Release the handle on the server.
+     * Releases are coalesced and sent before the next request.
+     */
+    void releaseHandle(const size_t handleID);
+
+    //! Send the pending handle releases (call with the osMutex)
+    void flushReleases(void);
+
     size_t remoteID;
     std::string upid;
     std::string nodeId;
@@ -73,12 +111,21 @@ public:
     std::ostream &os;
     const std::string name;
     bool connectionActive;
+    int wireFormat; //!< the negotiated format for sending requests
+    unsigned int archiveVersion; //!< the negotiated archive version for sending requests
+    bool inlineArgs; //!< the server accepts local objects as call arguments
+    bool batchRequests; //!< the server accepts batched requests
 
     std::mutex osMutex;
     std::mutex isMutex;
     std::condition_variable isCond;
     bool isBlocking;
-    std::map<size_t, Pothos::ObjectKwargs> tidToReply;
+    std::atomic<uint32_t> nextRequestId;
+    std::map<uint32_t, Pothos::ObjectKwargs> ridToReply;
+    std::set<uint32_t> discardReplies; //!< request IDs with nobody waiting on the reply
+
+    std::mutex releaseMutex;
+    std::vector<size_t> pendingReleases;
 };
 
 /***********************************************************************
@@ -90,6 +137,12 @@ public:
 
     RemoteProxyHandle(std::shared_ptr<RemoteProxyEnvironment> env, const size_t remoteID);
 
+    /*!
+     * Create a handle for a local object that is converted on first use.
+     * A temporary argument is sent along with the call instead.
+     */
+    RemoteProxyHandle(std::shared_ptr<RemoteProxyEnvironment> env, const Pothos::Object &local);
+
     ~RemoteProxyHandle(void);
 
     Pothos::ProxyEnvironment::Sptr getEnvironment(void) const
@@ -99,12 +152,27 @@ public:
 
     Pothos::Proxy call(const std::string &name, const Pothos::Proxy *args, const size_t numArgs);
 
+    std::future<Pothos::Proxy> callAsync(const std::string &name, const Pothos::Proxy *args, const size_t numArgs);
+
     int compareTo(const Pothos::Proxy &proxy) const;
     size_t hashCode(void) const;
     std::string toString(void) const;
     std::string getClassName(void) const;
 
+    //! Get the ID of the object on the server, converting the local object if needed
+    size_t getRemoteID(void) const;
+
+    //! Get the local object when it has not been converted
+    bool tryGetLocal(Pothos::Object &local) const;
+
     std::shared_ptr<RemoteProxyEnvironment> env;
 
-    size_t remoteID;
+private:
+    Pothos::ObjectKwargs makeCallRequest(const std::string &name, const Pothos::Proxy *args, const size_t numArgs);
+    static Pothos::Proxy makeCallResult(const std::shared_ptr<RemoteProxyEnvironment> &env,
+        const std::string &name, const Pothos::ObjectKwargs &reply);
+
+    mutable std::mutex mutex;
+    mutable size_t remoteID; //!< 0 until the local object is converted
+    mutable Pothos::Object local;
 };
@@ -3,12 +3,31 @@
 
 #include "RemoteProxyDatagram.hpp"
 #include <Pothos/Exception.hpp>
+#include <Pothos/Object/Serialize.hpp>
+#include <Pothos/Object/Exception.hpp>
 #include <Poco/ByteOrder.h>
+#include <Poco/Net/SocketStream.h>
+#include <Poco/Net/StreamSocket.h>
 #include <streambuf>
 #include <iostream>
 #include <cstdint>
+#include <array>
+#include <vector>
 #include <algorithm> //min/max
 #include <cstring> //memcpy
+#include <cerrno>
+
+#ifdef POCO_OS_FAMILY_UNIX
+#include <sys/uio.h> //iovec
+#include <sys/socket.h> //sendmsg
+
+//a closed peer fails the send with EPIPE rather than raising SIGPIPE
+#ifdef MSG_NOSIGNAL
+static const int PothosRPCSendFlags = MSG_NOSIGNAL;
+#else
+static const int PothosRPCSendFlags = 0; //Poco sets SO_NOSIGPIPE on these systems
+#endif
+#endif
 
 /***********************************************************************
  * Header structure and constants
@@ -21,6 +40,23 @@
 
 static const uint32_t PothosRPCHeaderWord = POTHOS_PACKET_WORD32("PRPC");
 static const uint32_t PothosRPCTrailerWord = POTHOS_PACKET_WORD32("CPRP");
+static const uint32_t PothosRPCChunkedHeaderWord = POTHOS_PACKET_WORD32("PRP2");
+static const uint32_t PothosRPCChunkedTrailerWord = POTHOS_PACKET_WORD32("2PRP");
+
+//! The chunk length that marks the end of the payload
+static const uint32_t PothosRPCEndChunk = 0;
+
+//! The chunk length that marks a payload which failed to serialize
+static const uint32_t PothosRPCAbortChunk = ~uint32_t(0);
+
+//! Writes of at least this size are sent by reference in their own chunk
+static const size_t PothosRPCDirectSize = 4*1024;
+
+//! Small writes are collected into chunks of this size
+static const size_t PothosRPCStagingSize = 16*1024;
+
+//! The maximum size of the in-place receive buffer
+static const size_t PothosRPCRecvBufferSize = 64*1024;
 
 struct PothosRPCHeader
 {
@@ -33,19 +69,35 @@ struct PothosRPCTrailer
     uint32_t trailerWord;
 };
 
+/***********************************************************************
+ * Serialize with the archive version that the peer can read
+ **********************************************************************/
+static void serializeObject(std::ostream &os, const Pothos::Object &data, const unsigned int archiveVersion)
+{
+    try
+    {
+        Pothos::Archive::OStreamArchiver oa(os, archiveVersion);
+        oa << data;
+    }
+    catch (const Pothos::ArchiveException &ex)
+    {
+        throw Pothos::ObjectSerializeError("sendDatagram("+data.toString()+")", ex.what());
+    }
+}
+
 /***********************************************************************
  * Serialization streambuf
  **********************************************************************/
 class PRPCDatagramObuf : public std::streambuf
 {
 public:
-    PRPCDatagramObuf(std::ostream &os, const Pothos::Object &data):
+    PRPCDatagramObuf(std::ostream &os, const Pothos::Object &data, const unsigned int archiveVersion):
         _bytesWritten(0),
         _payloadData(1024)
     {
         //serialize to a temporary buffer
         std::ostream oser(this);
-        data.serialize(oser);
+        serializeObject(oser, data, archiveVersion);
 
         //load the header and trailer
         PothosRPCHeader header;
@@ -102,21 +154,15 @@ private:
 class PRPCDatagramIbuf : public std::streambuf
 {
 public:
-    PRPCDatagramIbuf(std::istream &is, Pothos::Object &data):
-        _bytesRead(0)
+    //! Receive the datagram after the header word
+    PRPCDatagramIbuf(std::istream &is, Pothos::Object &data)
     {
-        //read the header
-        PothosRPCHeader header;
-        is.read((char *)&header, sizeof(header));
+        //read the payload length
+        uint32_t payloadBytes = 0;
+        is.read((char *)&payloadBytes, sizeof(payloadBytes));
         if (is.eof()) throw Pothos::IOException("recvDatagram()", "stream end");
         if (not is) throw Pothos::IOException("recvDatagram()", "stream error");
-
-        //parse the header
-        if (Poco::ByteOrder::fromNetwork(header.headerWord) != PothosRPCHeaderWord)
-        {
-            throw Pothos::IOException("recvDatagram()", "headerWord fail");
-        }
-        _payloadData.resize(Poco::ByteOrder::fromNetwork(header.payloadBytes));
+        _payloadData.resize(Poco::ByteOrder::fromNetwork(payloadBytes));
 
         //read the payload
         is.read(_payloadData.data(), _payloadData.size());
@@ -135,67 +181,382 @@ public:
             throw Pothos::IOException("recvDatagram()", "trailerWord fail");
         }
 
-        //deserialize from temporary buffer
+        //deserialize in-place from the payload buffer
+        this->setg(_payloadData.data(), _payloadData.data(), _payloadData.data()+_payloadData.size());
         std::istream iser(this);
         data.deserialize(iser);
     }
 
-    int_type underflow(void)
+private:
+    std::vector<char_type> _payloadData;
+};
+
+/***********************************************************************
+ * Direct socket access for streams backed by a socket:
+ * The socket stream is flushed before writing to the socket,
+ * and its buffer is drained before reading from the socket,
+ * so the direct access keeps the stream in order.
+ **********************************************************************/
+static bool getSocket(std::ios_base &ios, Poco::Net::StreamSocket &socket)
+{
+    auto socketIOS = dynamic_cast<Poco::Net::SocketIOS *>(&ios);
+    if (socketIOS == nullptr) return false;
+    socket = socketIOS->socket();
+    return true;
+}
+
+struct PRPCSegment
+{
+    const void *buff;
+    size_t len;
+};
+
+static void writeSegments(std::ostream &os, Poco::Net::StreamSocket *socket, PRPCSegment *segs, size_t numSegs)
+{
+    if (socket == nullptr)
     {
-        if (this->showmanyc() == 0) return traits_type::eof();
-        const char c = _payloadData[_bytesRead];
-        return traits_type::to_int_type(c);
+        for (size_t i = 0; i < numSegs; i++) os.write((const char *)segs[i].buff, segs[i].len);
+        if (not os) throw Pothos::IOException("sendDatagram()", "stream error");
+        return;
     }
 
-    int_type uflow(void)
+    #ifdef POCO_OS_FAMILY_UNIX
+    //scatter-gather write, advance through the segments on partial writes
+    std::array<iovec, 8> iov;
+    while (numSegs != 0)
     {
-        if (this->showmanyc() == 0) return traits_type::eof();
-        const char c = _payloadData[_bytesRead++];
-        return traits_type::to_int_type(c);
+        const size_t numIov = std::min(numSegs, iov.size());
+        for (size_t i = 0; i < numIov; i++)
+        {
+            iov[i].iov_base = const_cast<void *>(segs[i].buff);
+            iov[i].iov_len = segs[i].len;
+        }
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = numIov;
+        const auto ret = ::sendmsg(socket->impl()->sockfd(), &msg, PothosRPCSendFlags);
+        if (ret < 0 and errno == EINTR) continue;
+        if (ret < 0) throw Pothos::IOException("sendDatagram()", std::strerror(errno));
+        size_t sent = size_t(ret);
+        while (numSegs != 0 and sent >= segs->len)
+        {
+            sent -= segs->len;
+            segs++; numSegs--;
+        }
+        if (sent != 0)
+        {
+            segs->buff = (const char *)segs->buff + sent;
+            segs->len -= sent;
+        }
     }
+    #else
+    for (size_t i = 0; i < numSegs; i++)
+    {
+        auto buff = (const char *)segs[i].buff;
+        size_t len = segs[i].len;
+        while (len != 0)
+        {
+            const auto ret = socket->sendBytes(buff, int(std::min<size_t>(len, 1 << 30)));
+            if (ret <= 0) throw Pothos::IOException("sendDatagram()", "socket send failed");
+            buff += ret; len -= size_t(ret);
+        }
+    }
+    #endif
+}
 
-    std::streamsize showmanyc(void)
+static void readBytes(std::istream &is, Poco::Net::StreamSocket *socket, char *buff, size_t len)
+{
+    //drain the bytes already buffered by the stream
+    const auto available = is.rdbuf()->in_avail();
+    if (socket == nullptr or available > 0)
     {
-        return _payloadData.size()-_bytesRead;
+        const size_t n = (socket == nullptr)?len:std::min<size_t>(len, size_t(available));
+        is.read(buff, n);
+        if (is.eof()) throw Pothos::IOException("recvDatagram()", "stream end");
+        if (not is) throw Pothos::IOException("recvDatagram()", "stream error");
+        buff += n; len -= n;
     }
 
-    int_type pbackfail(int_type c)
+    //then receive the rest directly from the socket
+    while (len != 0)
     {
-        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::eof();
-        if (_bytesRead == 0) return traits_type::eof(); //still at start
-        const char_type t = traits_type::to_char_type(c);
-        if (t != _payloadData[_bytesRead-1]) return traits_type::eof(); //wrong character
-        _bytesRead--;
+        const auto ret = socket->receiveBytes(buff, int(std::min<size_t>(len, 1 << 30)));
+        if (ret == 0) throw Pothos::IOException("recvDatagram()", "stream end");
+        if (ret < 0) throw Pothos::IOException("recvDatagram()", "stream error");
+        buff += ret; len -= size_t(ret);
+    }
+}
+
+/***********************************************************************
+ * Chunked serialization streambuf
+ **********************************************************************/
+class PRPCChunkedObuf : public std::streambuf
+{
+public:
+    PRPCChunkedObuf(std::ostream &os, const Pothos::Object &data, const unsigned int archiveVersion):
+        _os(os),
+        _socket(nullptr),
+        _started(false)
+    {
+        //flush buffered stream data before writing to the socket directly
+        if (getSocket(os, _streamSocket))
+        {
+            _socket = &_streamSocket;
+            _os.flush();
+        }
+        this->setp(_staging.data(), _staging.data()+_staging.size());
+
+        try
+        {
+            std::ostream oser(this);
+            serializeObject(oser, data, archiveVersion);
+        }
+        catch (...)
+        {
+            //nothing was sent, the stream remains usable
+            if (not _started) throw;
+
+            //otherwise terminate the datagram so the receiver stays in sync
+            this->setp(_staging.data(), _staging.data()+_staging.size());
+            this->sendChunks(nullptr, 0, true, PothosRPCAbortChunk);
+            throw;
+        }
+        this->sendChunks(nullptr, 0, true, PothosRPCEndChunk);
+        if (_socket == nullptr) _os.flush();
+    }
+
+    int_type overflow(int_type c)
+    {
+        this->sendChunks(nullptr, 0);
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        *this->pptr() = traits_type::to_char_type(c);
+        this->pbump(1);
         return c;
     }
 
-    std::streamsize xsgetn(char *s, std::streamsize n)
+    std::streamsize xsputn(const char *s, std::streamsize count)
     {
-        const auto available = this->showmanyc();
-        if (available == 0) return traits_type::eof();
-        n = std::min<std::streamsize>(n, available);
-        std::memcpy(s, _payloadData.data()+_bytesRead, n);
-        _bytesRead += n;
-        return n;
+        //large writes are sent by reference rather than copied into the staging buffer
+        if (size_t(count) >= PothosRPCDirectSize)
+        {
+            this->sendChunks(s, size_t(count));
+            return count;
+        }
+        return std::streambuf::xsputn(s, count);
     }
 
 private:
-    std::streamsize _bytesRead;
-    std::vector<char_type> _payloadData;
+
+    /*!
+     * Send the staged bytes and an optional direct buffer as chunks,
+     * with an optional end marker, in a single gather write.
+     */
+    void sendChunks(const char *direct, const size_t directLen, const bool end = false, const uint32_t endWord = PothosRPCEndChunk)
+    {
+        std::array<PRPCSegment, 7> segs;
+        size_t numSegs = 0;
+
+        if (not _started)
+        {
+            _words[0] = Poco::ByteOrder::toNetwork(PothosRPCChunkedHeaderWord);
+            segs[numSegs++] = {&_words[0], sizeof(uint32_t)};
+            _started = true;
+        }
+
+        const size_t stagedLen = size_t(this->pptr() - this->pbase());
+        if (stagedLen != 0)
+        {
+            _words[1] = Poco::ByteOrder::toNetwork(uint32_t(stagedLen));
+            segs[numSegs++] = {&_words[1], sizeof(uint32_t)};
+            segs[numSegs++] = {this->pbase(), stagedLen};
+        }
+
+        if (directLen != 0)
+        {
+            _words[2] = Poco::ByteOrder::toNetwork(uint32_t(directLen));
+            segs[numSegs++] = {&_words[2], sizeof(uint32_t)};
+            segs[numSegs++] = {direct, directLen};
+        }
+
+        if (end)
+        {
+            _words[3] = Poco::ByteOrder::toNetwork(endWord);
+            _words[4] = Poco::ByteOrder::toNetwork(PothosRPCChunkedTrailerWord);
+            segs[numSegs++] = {&_words[3], 2*sizeof(uint32_t)};
+        }
+
+        writeSegments(_os, _socket, segs.data(), numSegs);
+        this->setp(_staging.data(), _staging.data()+_staging.size());
+    }
+
+    std::ostream &_os;
+    Poco::Net::StreamSocket _streamSocket;
+    Poco::Net::StreamSocket *_socket;
+    bool _started;
+    uint32_t _words[5];
+    std::array<char_type, PothosRPCStagingSize> _staging;
+};
+
+/***********************************************************************
+ * Chunked deserialization streambuf
+ **********************************************************************/
+class PRPCChunkedIbuf : public std::streambuf
+{
+public:
+    //! Receive the datagram after the header word
+    PRPCChunkedIbuf(std::istream &is, Pothos::Object &data):
+        _is(is),
+        _socket(nullptr),
+        _chunkRemaining(0),
+        _done(false),
+        _aborted(false)
+    {
+        if (getSocket(is, _streamSocket)) _socket = &_streamSocket;
+
+        try
+        {
+            std::istream iser(this);
+            data.deserialize(iser);
+        }
+        catch (const Pothos::IOException &)
+        {
+            throw; //stream errors cannot be recovered
+        }
+        catch (...)
+        {
+            //consume the rest of the datagram to stay in sync
+            this->finish();
+            throw;
+        }
+        this->finish();
+    }
+
+    int_type underflow(void)
+    {
+        while (_chunkRemaining == 0)
+        {
+            if (_done) return traits_type::eof();
+            this->readChunkHeader();
+        }
+
+        //fill the receive buffer and deserialize from it in-place
+        const size_t len = std::min(_chunkRemaining, PothosRPCRecvBufferSize);
+        if (_buffer.size() < len) _buffer.resize(len);
+        readBytes(_is, _socket, _buffer.data(), len);
+        _chunkRemaining -= len;
+        this->setg(_buffer.data(), _buffer.data(), _buffer.data()+len);
+        return traits_type::to_int_type(_buffer[0]);
+    }
+
+    std::streamsize xsgetn(char *s, std::streamsize count)
+    {
+        std::streamsize total = 0;
+        while (total < count)
+        {
+            //copy out of the receive buffer first
+            const auto available = std::min<std::streamsize>(this->egptr() - this->gptr(), count - total);
+            if (available > 0)
+            {
+                std::memcpy(s + total, this->gptr(), size_t(available));
+                this->gbump(int(available));
+                total += available;
+                continue;
+            }
+
+            //large reads go directly into the destination
+            if (_chunkRemaining != 0 and size_t(count - total) >= PothosRPCDirectSize)
+            {
+                const size_t len = std::min(_chunkRemaining, size_t(count - total));
+                readBytes(_is, _socket, s + total, len);
+                _chunkRemaining -= len;
+                total += std::streamsize(len);
+                continue;
+            }
+
+            if (traits_type::eq_int_type(this->underflow(), traits_type::eof())) break;
+        }
+        return total;
+    }
+
+private:
+
+    void readChunkHeader(void)
+    {
+        uint32_t word = 0;
+        readBytes(_is, _socket, (char *)&word, sizeof(word));
+        word = Poco::ByteOrder::fromNetwork(word);
+        if (word == PothosRPCEndChunk) _done = true;
+        else if (word == PothosRPCAbortChunk) _done = _aborted = true;
+        else _chunkRemaining = size_t(word);
+    }
+
+    void finish(void)
+    {
+        //discard unread payload through the end marker
+        this->setg(nullptr, nullptr, nullptr);
+        while (not _done)
+        {
+            if (_chunkRemaining == 0) this->readChunkHeader();
+            else if (traits_type::eq_int_type(this->underflow(), traits_type::eof())) break;
+        }
+
+        //read and parse the trailer
+        uint32_t trailerWord = 0;
+        readBytes(_is, _socket, (char *)&trailerWord, sizeof(trailerWord));
+        if (Poco::ByteOrder::fromNetwork(trailerWord) != PothosRPCChunkedTrailerWord)
+        {
+            throw Pothos::IOException("recvDatagram()", "trailerWord fail");
+        }
+        if (_aborted) throw Pothos::DataFormatException("recvDatagram()", "sender aborted the datagram");
+    }
+
+    std::istream &_is;
+    Poco::Net::StreamSocket _streamSocket;
+    Poco::Net::StreamSocket *_socket;
+    size_t _chunkRemaining;
+    bool _done;
+    bool _aborted;
+    std::vector<char_type> _buffer;
 };
 
 /***********************************************************************
  * Wrapper calls for datagram interface
  **********************************************************************/
-void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs)
+void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs, const int format, const unsigned int archiveVersion)
 {
     Pothos::Object request(reqArgs);
-    PRPCDatagramObuf(os, request);
+    if (format == PRPC_FORMAT_CHUNKED) PRPCChunkedObuf(os, request, archiveVersion);
+    else PRPCDatagramObuf(os, request, archiveVersion);
 }
 
-Pothos::ObjectKwargs recvDatagram(std::istream &is)
+Pothos::ObjectKwargs recvDatagram(std::istream &is, int &format)
 {
+    //read the header word
+    uint32_t headerWord = 0;
+    is.read((char *)&headerWord, sizeof(headerWord));
+    if (is.eof()) throw Pothos::IOException("recvDatagram()", "stream end");
+    if (not is) throw Pothos::IOException("recvDatagram()", "stream error");
+
+    //parse the header word to determine the format
     Pothos::Object reply;
-    PRPCDatagramIbuf(is, reply);
+    headerWord = Poco::ByteOrder::fromNetwork(headerWord);
+    if (headerWord == PothosRPCHeaderWord)
+    {
+        format = PRPC_FORMAT_STREAM;
+        PRPCDatagramIbuf(is, reply);
+    }
+    else if (headerWord == PothosRPCChunkedHeaderWord)
+    {
+        format = PRPC_FORMAT_CHUNKED;
+        PRPCChunkedIbuf(is, reply);
+    }
+    else throw Pothos::IOException("recvDatagram()", "headerWord fail");
     return std::move(reply.ref<Pothos::ObjectKwargs>());
 }
+
+Pothos::ObjectKwargs recvDatagram(std::istream &is)
+{
+    int format = 0;
+    return recvDatagram(is, format);
+}
@@ -3,14 +3,42 @@
 
 #pragma once
 #include <Pothos/Object/Containers.hpp>
+#include <Pothos/Archive/StreamArchiver.hpp>
 #include <iosfwd>
 
+/*!
+ * The framing of a datagram on the wire.
+ * The receiver detects the format from the header word,
+ * so a handler can reply in the format of each request.
+ */
+enum PRPCWireFormat : int
+{
+    //! One length-prefixed payload (the original format)
+    PRPC_FORMAT_STREAM = 1,
+
+    /*!
+     * A sequence of length-prefixed chunks ending with an empty chunk.
+     * Large writes such as BufferChunk payloads are sent by reference
+     * as their own chunks with scatter-gather writes on sockets,
+     * and they are received directly into the deserialized object.
+     */
+    PRPC_FORMAT_CHUNKED = 2,
+};
+
 /*!
  * Serialize a request object to an output stream
+ * \param archiveVersion the archive version negotiated with the peer
  */
-void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs);
+void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs, const int format = PRPC_FORMAT_STREAM,
+    const unsigned int archiveVersion = POTHOS_ARCHIVE_VERSION_COMPAT);
 
 /*!
  * Deserialize a reply object from an input stream
  */
 Pothos::ObjectKwargs recvDatagram(std::istream &is);
+
+/*!
+ * Deserialize a reply object from an input stream
+ * \param [out] format the wire format of the received datagram
+ */
+Pothos::ObjectKwargs recvDatagram(std::istream &is, int &format);
@@ -12,16 +12,20 @@ RemoteProxyHandle::RemoteProxyHandle(std::shared_ptr<RemoteProxyEnvironment> env
     return;
 }
 
+RemoteProxyHandle::RemoteProxyHandle(std::shared_ptr<RemoteProxyEnvironment> env, const Pothos::Object &local):
+    env(env), remoteID(0), local(local)
+{
+    return;
+}
+
 RemoteProxyHandle::~RemoteProxyHandle(void)
 {
-    //create request
-    Pothos::ObjectKwargs req;
-    req["action"] = Pothos::Object("~RemoteProxyHandle");
-    req["handleID"] = Pothos::Object(this->remoteID);
+    //the local object was never converted on the server
+    if (this->remoteID == 0) return;
 
     try
     {
-        env->transact(req);
+        env->releaseHandle(this->remoteID);
     }
     catch(const Pothos::Exception &ex)
     {
@@ -30,30 +34,59 @@ RemoteProxyHandle::~RemoteProxyHandle(void)
     }
 }
 
-Pothos::Proxy RemoteProxyHandle::call(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
+size_t RemoteProxyHandle::getRemoteID(void) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->remoteID == 0)
+    {
+        this->remoteID = env->convertObjectToRemoteID(this->local);
+        this->local = Pothos::Object();
+    }
+    return this->remoteID;
+}
+
+bool RemoteProxyHandle::tryGetLocal(Pothos::Object &local) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->remoteID != 0) return false;
+    local = this->local;
+    return true;
+}
+
+Pothos::ObjectKwargs RemoteProxyHandle::makeCallRequest(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
 {
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("call");
-    req["handleID"] = Pothos::Object(this->remoteID);
+    req["handleID"] = Pothos::Object(this->getRemoteID());
     req["name"] = Pothos::Object(name);
     for (size_t i = 0; i < numArgs; i++)
     {
-        std::shared_ptr<RemoteProxyHandle> handle;
         try
         {
-            handle = env->getHandle(args[i]);
+            auto handle = env->getHandle(args[i]);
+
+            //An unconverted handle owned only by the args array is a temporary,
+            //so its local object is sent along with the call to save a round trip.
+            Pothos::Object local;
+            if (env->inlineArgs and handle.use_count() <= 2 and handle->tryGetLocal(local))
+            {
+                req["local"+std::to_string(i)] = local;
+            }
+            else req[std::to_string(i)] = Pothos::Object(handle->getRemoteID());
         }
         catch(const std::exception &ex)
         {
             throw Pothos::ProxyHandleCallError("RemoteProxyHandle::call("+name+")",
                 Poco::format("convert arg %z - %s", i, std::string(ex.what())));
         }
-        req[std::to_string(i)] = Pothos::Object(handle->remoteID);
     }
+    return req;
+}
 
-    auto reply = env->transact(req);
-
+Pothos::Proxy RemoteProxyHandle::makeCallResult(const std::shared_ptr<RemoteProxyEnvironment> &env,
+    const std::string &name, const Pothos::ObjectKwargs &reply)
+{
     //check for an error
     auto errorMsgIt = reply.find("errorMsg");
     if (errorMsgIt != reply.end()) throw Pothos::ProxyHandleCallError(
@@ -64,7 +97,32 @@ Pothos::Proxy RemoteProxyHandle::call(const std::string &name, const Pothos::Pro
     if (messageIt != reply.end()) throw Pothos::ProxyExceptionMessage(messageIt->second.extract<std::string>());
 
     //otherwise make a handle
-    return env->makeHandle(reply["handleID"]);
+    return env->makeHandle(reply.at("handleID").convert<size_t>());
+}
+
+Pothos::Proxy RemoteProxyHandle::call(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
+{
+    const auto reply = env->transact(this->makeCallRequest(name, args, numArgs));
+    return makeCallResult(env, name, reply);
+}
+
+std::future<Pothos::Proxy> RemoteProxyHandle::callAsync(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
+{
+    std::shared_future<Pothos::ObjectKwargs> reply;
+    try
+    {
+        reply = env->transactAsync(this->makeCallRequest(name, args, numArgs));
+    }
+    catch (...)
+    {
+        std::promise<Pothos::Proxy> result;
+        result.set_exception(std::current_exception());
+        return result.get_future();
+    }
+
+    //the reply is received when the future is accessed
+    auto remoteEnv = this->env;
+    return std::async(std::launch::deferred, [remoteEnv, name, reply](void){return makeCallResult(remoteEnv, name, reply.get());});
 }
 
 int RemoteProxyHandle::compareTo(const Pothos::Proxy &proxy) const
@@ -83,8 +141,8 @@ int RemoteProxyHandle::compareTo(const Pothos::Proxy &proxy) const
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("compareTo");
-    req["handleID"] = Pothos::Object(this->remoteID);
-    req["otherID"] = Pothos::Object(handle->remoteID);
+    req["handleID"] = Pothos::Object(this->getRemoteID());
+    req["otherID"] = Pothos::Object(handle->getRemoteID());
 
     auto reply = env->transact(req);
 
@@ -101,7 +159,7 @@ size_t RemoteProxyHandle::hashCode(void) const
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("hashCode");
-    req["handleID"] = Pothos::Object(this->remoteID);
+    req["handleID"] = Pothos::Object(this->getRemoteID());
 
     auto reply = env->transact(req);
 
@@ -113,7 +171,7 @@ std::string RemoteProxyHandle::toString(void) const
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("toString");
-    req["handleID"] = Pothos::Object(this->remoteID);
+    req["handleID"] = Pothos::Object(this->getRemoteID());
 
     auto reply = env->transact(req);
 
@@ -125,7 +183,7 @@ std::string RemoteProxyHandle::getClassName(void) const
     //create request
     Pothos::ObjectKwargs req;
     req["action"] = Pothos::Object("getClassName");
-    req["handleID"] = Pothos::Object(this->remoteID);
+    req["handleID"] = Pothos::Object(this->getRemoteID());
 
     auto reply = env->transact(req);
 
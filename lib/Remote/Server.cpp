@@ -9,6 +9,7 @@
 #include <Poco/StringTokenizer.h>
 #include <Poco/URI.h>
 #include <Poco/Net/SocketAddress.h>
+#include <Poco/Path.h>
 #include <Poco/String.h>
 #include <Poco/Message.h>
 #include <Poco/Net/RemoteSyslogChannel.h>
@@ -16,11 +17,40 @@
 #include <thread>
 #include <cassert>
 
+#ifdef POCO_HAS_UNIX_SOCKET
+#include <sys/types.h>
+#include <sys/stat.h> //mkdir, lstat
+#include <unistd.h> //geteuid
+#endif
+
 std::string Pothos::RemoteServer::getLocatorPort(void)
 {
     return "16415";
 }
 
+std::string Pothos::RemoteServer::getLocalSocketPath(const std::string &port)
+{
+    #ifdef POCO_HAS_UNIX_SOCKET
+    //the socket lives in a directory that only this user can enter,
+    //so that another user cannot create or replace the socket file
+    Poco::Path dirPath(Poco::Path::temp());
+    dirPath.pushDirectory("pothos-"+std::to_string(::geteuid()));
+    const auto dirStr = dirPath.toString();
+    ::mkdir(dirStr.c_str(), 0700); //an existing directory is checked below
+
+    //reject a directory created by someone else or opened up to others
+    struct stat st;
+    if (::lstat(dirStr.c_str(), &st) != 0) return "";
+    if (not S_ISDIR(st.st_mode)) return "";
+    if (st.st_uid != ::geteuid()) return "";
+    if ((st.st_mode & 077) != 0) return "";
+    return Poco::Path(dirPath, "proxy-"+port+".sock").toString();
+    #else
+    (void)port;
+    return "";
+    #endif
+}
+
 struct Pothos::RemoteServer::Impl
 {
     Impl(const Poco::ProcessHandle &ph):
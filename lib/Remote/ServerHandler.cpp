@@ -2,68 +2,150 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "RemoteProxyDatagram.hpp"
+#include <Pothos/Exception.hpp>
 #include <Pothos/Object.hpp>
 #include <Pothos/Object/Containers.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Remote/Handler.hpp>
 #include <Pothos/System/HostInfo.hpp>
 #include <Poco/Exception.h>
+#include <Poco/Logger.h>
 #include <Poco/Bugcheck.h>
 #include <iostream>
 #include <mutex>
-#include <map>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <utility> //swap
+#include <algorithm> //min
 
 /***********************************************************************
  * Active objects on the server
+ *  - the table is split into shards with a lock per shard
+ *  - released slots are re-used from a free list per shard
+ *  - an ID holds the shard, slot, and generation of the slot,
+ *    so that lookup is O(1) and stale IDs are detected
+ *  - IDs fit in 32 bits on every architecture, so that a 32-bit client
+ *    can hold the IDs of a 64-bit server in its size_t remote IDs
  **********************************************************************/
-static std::mutex &getObjectsMutex(void)
+static const size_t ObjectIdBits = 32;
+static const size_t ObjectShardBits = 4;
+static const size_t ObjectSlotBits = 20;
+static const size_t ObjectGenerationBits = ObjectIdBits - ObjectShardBits - ObjectSlotBits;
+
+class ServerObjectTable
 {
-    static std::mutex mutex;
-    return mutex;
-}
+public:
+    ServerObjectTable(void):
+        _nextShard(0)
+    {
+        return;
+    }
+
+    size_t insert(const Pothos::Object &obj)
+    {
+        const size_t shardIndex = _nextShard++ % NumShards;
+        auto &shard = _shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        size_t slotIndex = shard.slots.size();
+        if (not shard.freeSlots.empty())
+        {
+            slotIndex = shard.freeSlots.back();
+            shard.freeSlots.pop_back();
+        }
+        else if (slotIndex < (size_t(1) << ObjectSlotBits)) shard.slots.push_back(Slot());
+        else throw Pothos::Exception("ServerObjectTable::insert()", "too many objects");
+
+        auto &slot = shard.slots[slotIndex];
+        slot.object = obj;
+        return (slot.generation << (ObjectShardBits+ObjectSlotBits)) | (slotIndex << ObjectShardBits) | shardIndex;
+    }
+
+    Pothos::Object at(const size_t id)
+    {
+        auto &shard = _shards[id % NumShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto slot = this->getSlot(shard, id);
+        if (slot == nullptr) throw Pothos::Exception("ServerObjectTable::at()", "invalid object ID "+std::to_string(id));
+        return slot->object;
+    }
+
+    void erase(const size_t id)
+    {
+        //the object is destroyed outside of the lock
+        Pothos::Object object;
+        auto &shard = _shards[id % NumShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto slot = this->getSlot(shard, id);
+        if (slot == nullptr) return;
+        std::swap(object, slot->object);
 
-typedef std::map<size_t, Pothos::Object> ServerObjectsMapType;
-static ServerObjectsMapType &getObjectsMap(void)
+        //the next generation invalidates this ID, generation 0 is never used
+        slot->generation = (slot->generation + 1) & ((size_t(1) << ObjectGenerationBits) - 1);
+        if (slot->generation == 0) slot->generation = 1;
+        shard.freeSlots.push_back((id >> ObjectShardBits) & ((size_t(1) << ObjectSlotBits) - 1));
+    }
+
+private:
+    static const size_t NumShards = size_t(1) << ObjectShardBits;
+
+    struct Slot
+    {
+        Slot(void): generation(1){}
+        Pothos::Object object;
+        size_t generation;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::vector<Slot> slots;
+        std::vector<size_t> freeSlots;
+    };
+
+    static Slot *getSlot(Shard &shard, const size_t id)
+    {
+        const size_t slotIndex = (id >> ObjectShardBits) & ((size_t(1) << ObjectSlotBits) - 1);
+        const size_t generation = id >> (ObjectShardBits+ObjectSlotBits);
+        if (slotIndex >= shard.slots.size()) return nullptr;
+        auto &slot = shard.slots[slotIndex];
+        if (slot.generation != generation) return nullptr;
+        return &slot;
+    }
+
+    std::atomic<size_t> _nextShard;
+    std::array<Shard, NumShards> _shards;
+};
+
+static ServerObjectTable &getObjectTable(void)
 {
-    static ServerObjectsMapType map;
-    return map;
+    static ServerObjectTable table;
+    return table;
 }
 
 static Pothos::Object getNewObjectId(const Pothos::Object &obj)
 {
-    std::lock_guard<std::mutex> lock(getObjectsMutex());
-    static size_t id = 0;
-    getObjectsMap()[++id] = obj;
-    return Pothos::Object(id);
+    return Pothos::Object(getObjectTable().insert(obj));
 }
 
 static Pothos::Object getObjectAtId(const Pothos::Object &id)
 {
     const size_t key(id);
-    std::lock_guard<std::mutex> lock(getObjectsMutex());
-    return getObjectsMap()[key];
+    return getObjectTable().at(key);
 }
 
 static void removeObjectAtId(const Pothos::Object &id)
 {
     const size_t key(id);
-    std::lock_guard<std::mutex> lock(getObjectsMutex());
-    getObjectsMap().erase(key);
+    getObjectTable().erase(key);
 }
 
 /***********************************************************************
  * Handler implementation
  **********************************************************************/
-bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
+static void handleRequest(const Pothos::ObjectKwargs &reqArgs, Pothos::ObjectKwargs &replyArgs, bool &done, const std::string &peerAddr)
 {
-    bool done = false;
-
-    //deserialize the request
-    const auto reqArgs = recvDatagram(is);
-
-    //process the request and form the reply
-    Pothos::ObjectKwargs replyArgs;
-    replyArgs["tid"] = reqArgs.at("tid");
     POTHOS_EXCEPTION_TRY
     {
         const auto &action = reqArgs.at("action").extract<std::string>();
@@ -83,7 +165,22 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
             const auto info = Pothos::System::HostInfo::get();
             replyArgs["upid"] = Pothos::Object(Pothos::ProxyEnvironment::getLocalUniquePid());
             replyArgs["nodeId"] = Pothos::Object(info.nodeId);
-            replyArgs["peerAddr"] = Pothos::Object(_peerAddr);
+            replyArgs["peerAddr"] = Pothos::Object(peerAddr);
+
+            //advertise the chunked wire format to clients that support it
+            if (reqArgs.count("wireFormat") != 0) replyArgs["wireFormat"] = Pothos::Object(int(PRPC_FORMAT_CHUNKED));
+
+            //accept local objects as call arguments from clients that support it
+            if (reqArgs.count("inlineArgs") != 0) replyArgs["inlineArgs"] = Pothos::Object(true);
+
+            //reply with the archive version that both sides can read,
+            //the handler writes later replies in this version
+            const auto archiveVersionIt = reqArgs.find("archiveVersion");
+            if (archiveVersionIt != reqArgs.end()) replyArgs["archiveVersion"] = Pothos::Object(
+                std::min<int>(POTHOS_ARCHIVE_VERSION, archiveVersionIt->second.convert<int>()));
+
+            //accept batched requests from clients that support it
+            if (reqArgs.count("batch") != 0) replyArgs["batch"] = Pothos::Object(true);
         }
         else if (action == "~RemoteProxyEnvironment")
         {
@@ -122,9 +219,16 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
             size_t argNo = 0;
             while (true)
             {
-                auto it = reqArgs.find(std::to_string(argNo++));
-                if (it == reqArgs.end()) break;
-                args.push_back(getObjectAtId(it->second).extract<Pothos::Proxy>());
+                const auto argName = std::to_string(argNo++);
+                auto it = reqArgs.find(argName);
+                if (it != reqArgs.end()) args.push_back(getObjectAtId(it->second).extract<Pothos::Proxy>());
+
+                //a local object sent along with the call
+                else if ((it = reqArgs.find("local"+argName)) != reqArgs.end())
+                {
+                    args.push_back(proxy.getEnvironment()->convertObjectToProxy(it->second));
+                }
+                else break;
             }
 
             //make the call
@@ -160,6 +264,18 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
             const auto &proxy = getObjectAtId(reqArgs.at("handleID")).extract<Pothos::Proxy>();
             replyArgs["result"] = Pothos::Object(proxy.getClassName());
         }
+        else if (action == "batch")
+        {
+            //handle each request in order and reply with all of the replies
+            Pothos::ObjectVector replies;
+            for (const auto &request : reqArgs.at("requests").extract<Pothos::ObjectVector>())
+            {
+                Pothos::ObjectKwargs reply;
+                handleRequest(request.extract<Pothos::ObjectKwargs>(), reply, done, peerAddr);
+                replies.push_back(Pothos::Object(reply));
+            }
+            replyArgs["replies"] = Pothos::Object(replies);
+        }
         else
         {
             poco_bugcheck_msg(action.c_str());
@@ -169,20 +285,55 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
     {
         replyArgs["errorMsg"] = Pothos::Object(ex.displayText());
     }
+}
+
+bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
+{
+    bool done = false;
+
+    //deserialize the request
+    int wireFormat = PRPC_FORMAT_STREAM;
+    Pothos::ObjectKwargs reqArgs;
+    try
+    {
+        reqArgs = recvDatagram(is, wireFormat);
+    }
+    catch (const Pothos::IOException &)
+    {
+        throw; //the connection is broken
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        //the datagram was consumed in full (ex: an aborted chunked request),
+        //the request is rejected without a tid to reply to, keep serving
+        poco_error(Poco::Logger::get("Pothos.RemoteHandler"), "rejected request: "+ex.displayText());
+        return done;
+    }
+
+    //process the request and form the reply
+    Pothos::ObjectKwargs replyArgs;
+    replyArgs["tid"] = reqArgs.at("tid");
+    handleRequest(reqArgs, replyArgs, done, _peerAddr);
+
+    //serialize the reply in the format of the request
+    sendDatagram(os, replyArgs, wireFormat, _archiveVersion);
 
-    //serialize the reply
-    sendDatagram(os, replyArgs);
+    //the client reads the negotiated version after the handshake reply
+    const auto archiveVersionIt = replyArgs.find("archiveVersion");
+    if (archiveVersionIt != replyArgs.end()) _archiveVersion = unsigned(archiveVersionIt->second.convert<int>());
 
     return done;
 }
 
-Pothos::RemoteHandler::RemoteHandler(void)
+Pothos::RemoteHandler::RemoteHandler(void):
+    _archiveVersion(POTHOS_ARCHIVE_VERSION_COMPAT)
 {
     return;
 }
 
 Pothos::RemoteHandler::RemoteHandler(const std::string &peerAddr):
-    _peerAddr(peerAddr)
+    _peerAddr(peerAddr),
+    _archiveVersion(POTHOS_ARCHIVE_VERSION_COMPAT)
 {
     return;
 }
@@ -13,8 +13,11 @@
 #include <simdpp/dispatch/get_arch_raw_cpuid.h>
 #include <simdpp/dispatch/get_arch_linux_cpuinfo.h>
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <cstring>
+#include <limits>
 #include <type_traits>
 
 // SIMDPP_USER_ARCH_INFO used by SIMDPP_MAKE_DISPATCHER below
@@ -559,6 +562,143 @@ namespace detail
             (ScalarOutType*)out,
             (bufferLen*2));
     }
+
+    /*
+     * Interleaved <-> planar conversions work on blocks that fit in L1.
+     * Each block is type-converted with the SIMD overloads above,
+     * and (de)interleaved with a strided loop that the compiler
+     * vectorizes with the flags of each generated arch.
+     */
+    static constexpr size_t InterleaveBlockSize = 256;
+
+    template <typename InType, typename OutType>
+    static void simdConvertRealToComplex(
+        const InType* in,
+        OutType* out,
+        size_t bufferLen)
+    {
+        OutType block[InterleaveBlockSize];
+
+        for(size_t offset = 0; offset < bufferLen; offset += InterleaveBlockSize)
+        {
+            const size_t blockLen = std::min(InterleaveBlockSize, bufferLen - offset);
+            simdConvertBuffer<InType, OutType>(in + offset, block, blockLen);
+
+            OutType* outPtr = out + (2 * offset);
+            for(size_t i = 0; i < blockLen; ++i)
+            {
+                outPtr[(2 * i) + 0] = block[i];
+                outPtr[(2 * i) + 1] = OutType(0);
+            }
+        }
+    }
+
+    template <typename InType, typename OutType>
+    static void simdConvertComponents(
+        const InType* in,
+        OutType* outRe,
+        OutType* outIm,
+        size_t bufferLen)
+    {
+        OutType block[2 * InterleaveBlockSize];
+
+        for(size_t offset = 0; offset < bufferLen; offset += InterleaveBlockSize)
+        {
+            const size_t blockLen = std::min(InterleaveBlockSize, bufferLen - offset);
+            simdConvertBuffer<InType, OutType>(in + (2 * offset), block, (2 * blockLen));
+
+            for(size_t i = 0; i < blockLen; ++i)
+            {
+                outRe[offset + i] = block[(2 * i) + 0];
+                outIm[offset + i] = block[(2 * i) + 1];
+            }
+        }
+    }
+
+    template <typename InType, typename OutType>
+    static void simdConvertComponentsToComplex(
+        const InType* inRe,
+        const InType* inIm,
+        OutType* out,
+        size_t bufferLen)
+    {
+        OutType blockRe[InterleaveBlockSize];
+        OutType blockIm[InterleaveBlockSize];
+
+        for(size_t offset = 0; offset < bufferLen; offset += InterleaveBlockSize)
+        {
+            const size_t blockLen = std::min(InterleaveBlockSize, bufferLen - offset);
+            simdConvertBuffer<InType, OutType>(inRe + offset, blockRe, blockLen);
+            simdConvertBuffer<InType, OutType>(inIm + offset, blockIm, blockLen);
+
+            OutType* outPtr = out + (2 * offset);
+            for(size_t i = 0; i < blockLen; ++i)
+            {
+                outPtr[(2 * i) + 0] = blockRe[i];
+                outPtr[(2 * i) + 1] = blockIm[i];
+            }
+        }
+    }
+
+    /*
+     * Scaled conversions compute in*scale + offset in float when both
+     * types are exactly representable, otherwise in double.
+     * Rounding and saturation are template parameters so that each
+     * instantiation is a branch-free loop which the compiler vectorizes
+     * with the flags of each generated arch.
+     */
+    template <typename T>
+    struct FitsFloat: std::integral_constant<bool,
+        std::is_same<T, float>::value || (std::is_integral<T>::value && sizeof(T) <= 2)
+    > {};
+
+    template <typename InType, typename OutType>
+    using ScaleComputeType = typename std::conditional<
+        FitsFloat<InType>::value && FitsFloat<OutType>::value, float, double>::type;
+
+    template <typename InType, typename OutType, bool Round, bool Saturate>
+    static void simdScaleConvertBuffer(
+        const InType* in,
+        OutType* out,
+        size_t bufferLen,
+        ScaleComputeType<InType, OutType> scale,
+        ScaleComputeType<InType, OutType> offset)
+    {
+        using ComputeType = ScaleComputeType<InType, OutType>;
+        const auto lo = ComputeType(std::numeric_limits<OutType>::lowest());
+        const auto hi = ComputeType(std::numeric_limits<OutType>::max());
+
+        for(size_t i = 0; i < bufferLen; ++i)
+        {
+            ComputeType x = ComputeType(in[i]) * scale + offset;
+            if (Round) x = std::nearbyint(x);
+            if (Saturate) x = (x == x)? x : ComputeType(0); //NaN does not compare, map it to zero
+            if (Saturate) x = std::min(std::max(x, lo), hi);
+            out[i] = static_cast<OutType>(x);
+        }
+    }
+
+    template <typename InType, typename OutType>
+    static void simdScaleConvertBuffer(
+        const InType* in,
+        OutType* out,
+        size_t bufferLen,
+        double scale,
+        double offset,
+        int flags)
+    {
+        using ComputeType = ScaleComputeType<InType, OutType>;
+
+        //rounding and saturation only apply to integer outputs
+        if (!std::is_integral<OutType>::value) flags = Pothos::BufferChunk::CONVERT_TRUNCATE;
+        const bool round = (flags & Pothos::BufferChunk::CONVERT_ROUND) != 0;
+        const bool saturate = (flags & Pothos::BufferChunk::CONVERT_SATURATE) != 0;
+
+        if (round && saturate) simdScaleConvertBuffer<InType, OutType, true, true>(in, out, bufferLen, ComputeType(scale), ComputeType(offset));
+        else if (round) simdScaleConvertBuffer<InType, OutType, true, false>(in, out, bufferLen, ComputeType(scale), ComputeType(offset));
+        else if (saturate) simdScaleConvertBuffer<InType, OutType, false, true>(in, out, bufferLen, ComputeType(scale), ComputeType(offset));
+        else simdScaleConvertBuffer<InType, OutType, false, false>(in, out, bufferLen, ComputeType(scale), ComputeType(offset));
+    }
 }
 
 template <typename InType, typename OutType>
@@ -570,6 +710,47 @@ void simdConvertBuffer(const void* in, void* out, size_t bufferLen)
         bufferLen);
 }
 
+template <typename InType, typename OutType>
+void simdConvertRealToComplex(const void* in, void* out, size_t bufferLen)
+{
+    detail::simdConvertRealToComplex<InType, OutType>(
+        (const InType*)in,
+        (OutType*)out,
+        bufferLen);
+}
+
+template <typename InType, typename OutType>
+void simdConvertComponents(const void* in, void* outRe, void* outIm, size_t bufferLen)
+{
+    detail::simdConvertComponents<InType, OutType>(
+        (const InType*)in,
+        (OutType*)outRe,
+        (OutType*)outIm,
+        bufferLen);
+}
+
+template <typename InType, typename OutType>
+void simdConvertComponentsToComplex(const void* inRe, const void* inIm, void* out, size_t bufferLen)
+{
+    detail::simdConvertComponentsToComplex<InType, OutType>(
+        (const InType*)inRe,
+        (const InType*)inIm,
+        (OutType*)out,
+        bufferLen);
+}
+
+template <typename InType, typename OutType>
+void simdScaleConvertBuffer(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)
+{
+    detail::simdScaleConvertBuffer<InType, OutType>(
+        (const InType*)in,
+        (OutType*)out,
+        bufferLen,
+        scale,
+        offset,
+        flags);
+}
+
 }
 
 // This generates the underlying code that queries the runnable instruction
@@ -581,6 +762,30 @@ SIMDPP_MAKE_DISPATCHER(
     (void)(simdConvertBuffer)
     ((const void*) in, (void*) out, (size_t) bufferLen))
 
+SIMDPP_MAKE_DISPATCHER(
+    (template<typename InType, typename OutType>)
+    (<InType, OutType>)
+    (void)(simdConvertRealToComplex)
+    ((const void*) in, (void*) out, (size_t) bufferLen))
+
+SIMDPP_MAKE_DISPATCHER(
+    (template<typename InType, typename OutType>)
+    (<InType, OutType>)
+    (void)(simdConvertComponents)
+    ((const void*) in, (void*) outRe, (void*) outIm, (size_t) bufferLen))
+
+SIMDPP_MAKE_DISPATCHER(
+    (template<typename InType, typename OutType>)
+    (<InType, OutType>)
+    (void)(simdConvertComponentsToComplex)
+    ((const void*) inRe, (const void*) inIm, (void*) out, (size_t) bufferLen))
+
+SIMDPP_MAKE_DISPATCHER(
+    (template<typename InType, typename OutType>)
+    (<InType, OutType>)
+    (void)(simdScaleConvertBuffer)
+    ((const void*) in, (void*) out, (size_t) bufferLen, (double) scale, (double) offset, (int) flags))
+
 // Separate dispatcher macros because it there are only
 // underlying overloads for so many template specializations
 // at once.
@@ -629,3 +834,61 @@ INSTANTIATE_DISPATCHERS(unsigned long)
 INSTANTIATE_DISPATCHERS(unsigned long long)
 INSTANTIATE_DISPATCHERS(float)
 INSTANTIATE_DISPATCHERS(double)
+
+// The interleave dispatchers are instantiated for scalar type pairs,
+// the complex side of the conversion is implied by the function.
+#define INSTANTIATE_INTERLEAVE_DISPATCHER(fcn, T, params) \
+    SIMDPP_INSTANTIATE_DISPATCHER( \
+        (template void fcn<T, char> params), \
+        (template void fcn<T, std::int8_t> params), \
+        (template void fcn<T, std::int16_t> params), \
+        (template void fcn<T, std::int32_t> params), \
+        (template void fcn<T, long> params), \
+        (template void fcn<T, long long> params), \
+        (template void fcn<T, std::uint8_t> params), \
+        (template void fcn<T, std::uint16_t> params), \
+        (template void fcn<T, std::uint32_t> params), \
+        (template void fcn<T, unsigned long> params), \
+        (template void fcn<T, unsigned long long> params), \
+        (template void fcn<T, float> params), \
+        (template void fcn<T, double> params) \
+    )
+
+#define INSTANTIATE_INTERLEAVE_DISPATCHERS(T) \
+    INSTANTIATE_INTERLEAVE_DISPATCHER(simdConvertRealToComplex, T, \
+        (const void* in, void* out, size_t bufferLen)) \
+    INSTANTIATE_INTERLEAVE_DISPATCHER(simdConvertComponents, T, \
+        (const void* in, void* outRe, void* outIm, size_t bufferLen)) \
+    INSTANTIATE_INTERLEAVE_DISPATCHER(simdConvertComponentsToComplex, T, \
+        (const void* inRe, const void* inIm, void* out, size_t bufferLen))
+
+INSTANTIATE_INTERLEAVE_DISPATCHERS(char)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::int8_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::int16_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::int32_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(long)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(long long)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::uint8_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::uint16_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(std::uint32_t)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(unsigned long)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(unsigned long long)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(float)
+INSTANTIATE_INTERLEAVE_DISPATCHERS(double)
+
+// The scaled conversions cover the fixed point integer and floating point
+// scalar types, complex buffers are converted as interleaved scalars.
+#define INSTANTIATE_SCALE_DISPATCHERS(T) \
+    SIMDPP_INSTANTIATE_DISPATCHER( \
+        (template void simdScaleConvertBuffer<T, std::int8_t>(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)), \
+        (template void simdScaleConvertBuffer<T, std::int16_t>(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)), \
+        (template void simdScaleConvertBuffer<T, std::int32_t>(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)), \
+        (template void simdScaleConvertBuffer<T, float>(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)), \
+        (template void simdScaleConvertBuffer<T, double>(const void* in, void* out, size_t bufferLen, double scale, double offset, int flags)) \
+    )
+
+INSTANTIATE_SCALE_DISPATCHERS(std::int8_t)
+INSTANTIATE_SCALE_DISPATCHERS(std::int16_t)
+INSTANTIATE_SCALE_DISPATCHERS(std::int32_t)
+INSTANTIATE_SCALE_DISPATCHERS(float)
+INSTANTIATE_SCALE_DISPATCHERS(double)
@@ -9,3 +9,19 @@
 
 template <typename InType, typename OutType>
 void simdConvertBuffer(const void*, void*, size_t);
+
+// Real InType to interleaved std::complex<OutType>
+template <typename InType, typename OutType>
+void simdConvertRealToComplex(const void*, void*, size_t);
+
+// Interleaved std::complex<InType> to separate OutType planes
+template <typename InType, typename OutType>
+void simdConvertComponents(const void*, void*, void*, size_t);
+
+// Separate InType planes to interleaved std::complex<OutType>
+template <typename InType, typename OutType>
+void simdConvertComponentsToComplex(const void*, const void*, void*, size_t);
+
+// out = in*scale + offset, with BufferChunk::CONVERT_* flags for integer outputs
+template <typename InType, typename OutType>
+void simdScaleConvertBuffer(const void*, void*, size_t, double, double, int);
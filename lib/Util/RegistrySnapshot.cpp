@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Util/RegistrySnapshot.hpp"
+
+/***********************************************************************
+ * Hazard slot blocks are claimed by threads and never deleted,
+ * a block is reused by another thread after its owner thread exits.
+ **********************************************************************/
+struct HazardSlots
+{
+    HazardSlots(void):
+        inUse(true),
+        next(nullptr),
+        nextOwned(nullptr)
+    {
+        for (auto &slot : slots) slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    static const size_t NUM_SLOTS = 6;
+    std::atomic<const void *> slots[NUM_SLOTS];
+    std::atomic<bool> inUse;
+    HazardSlots *next; //!< the list of all blocks
+    HazardSlots *nextOwned; //!< more blocks for deeply nested readers
+    char padding[64]; //!< keep other blocks off of this cache line
+};
+
+static std::atomic<HazardSlots *> &getHazardSlotsList(void)
+{
+    static std::atomic<HazardSlots *> head(nullptr);
+    return head;
+}
+
+static HazardSlots *claimHazardSlots(void)
+{
+    auto &head = getHazardSlotsList();
+
+    //reuse a block from an exited thread
+    for (auto block = head.load(std::memory_order_acquire); block != nullptr; block = block->next)
+    {
+        bool expected = false;
+        if (block->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return block;
+    }
+
+    //or add a new block to the front of the list
+    auto block = new HazardSlots();
+    block->next = head.load(std::memory_order_relaxed);
+    while (not head.compare_exchange_weak(block->next, block,
+        std::memory_order_release, std::memory_order_relaxed)){}
+    return block;
+}
+
+/***********************************************************************
+ * Thread ownership of hazard slot blocks
+ **********************************************************************/
+static thread_local HazardSlots *threadSlots(nullptr);
+static thread_local bool threadExiting(false);
+
+struct ThreadSlotsReleaser
+{
+    ~ThreadSlotsReleaser(void)
+    {
+        threadExiting = true;
+        for (auto block = threadSlots; block != nullptr;)
+        {
+            auto nextOwned = block->nextOwned;
+            block->nextOwned = nullptr;
+            block->inUse.store(false, std::memory_order_release);
+            block = nextOwned;
+        }
+        threadSlots = nullptr;
+    }
+};
+
+static HazardSlots *getThreadSlots(void)
+{
+    if (threadSlots != nullptr) return threadSlots;
+    threadSlots = claimHazardSlots();
+
+    //blocks claimed after the releaser ran (static destructors) stay claimed
+    if (not threadExiting)
+    {
+        static thread_local ThreadSlotsReleaser releaser;
+        (void)releaser;
+    }
+    return threadSlots;
+}
+
+/***********************************************************************
+ * Hazard slot implementation
+ **********************************************************************/
+size_t RegistryHazards::acquire(const void *ptr)
+{
+    size_t index = 0;
+    for (auto block = getThreadSlots();; block = block->nextOwned)
+    {
+        for (auto &slot : block->slots)
+        {
+            if (slot.load(std::memory_order_relaxed) == nullptr)
+            {
+                slot.store(ptr, std::memory_order_seq_cst);
+                return index;
+            }
+            index++;
+        }
+        if (block->nextOwned == nullptr) block->nextOwned = claimHazardSlots();
+    }
+}
+
+void RegistryHazards::release(const size_t index)
+{
+    auto block = threadSlots;
+    for (size_t i = 0; i < index/HazardSlots::NUM_SLOTS; i++) block = block->nextOwned;
+    block->slots[index%HazardSlots::NUM_SLOTS].store(nullptr, std::memory_order_release);
+}
+
+bool RegistryHazards::isProtected(const void *ptr)
+{
+    for (auto block = getHazardSlotsList().load(std::memory_order_acquire); block != nullptr; block = block->next)
+    {
+        for (const auto &slot : block->slots)
+        {
+            if (slot.load(std::memory_order_seq_cst) == ptr) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2017-2017 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * Per-thread hazard slots which protect snapshots from deletion.
+ * Each thread only writes to its own slots (one cache line),
+ * so concurrent readers do not contend on a shared counter.
+ */
+namespace RegistryHazards
+{
+    //! Protect the pointer for the calling thread, return the slot index
+    size_t acquire(const void *ptr);
+
+    //! Release the slot returned by acquire
+    void release(const size_t index);
+
+    //! Is the pointer protected by any thread?
+    bool isProtected(const void *ptr);
+}
+
+/*!
+ * An immutable snapshot of a registry for frequent lock-free reads.
+ * The readers load the current snapshot with an atomic pointer load,
+ * and protect it with a hazard slot for the lifetime of the Reader.
+ * Writers (plugin load and unload) are serialized by a mutex,
+ * modify a copy of the current snapshot, and publish the copy.
+ * Replaced snapshots are deleted once no reader protects them.
+ */
+template <typename T>
+class RegistrySnapshot
+{
+public:
+    RegistrySnapshot(void):
+        _current(new T())
+    {
+        return;
+    }
+
+    ~RegistrySnapshot(void)
+    {
+        for (auto old : _retired) delete old;
+        delete _current.load();
+    }
+
+    //! Read access to the current snapshot
+    class Reader
+    {
+    public:
+        Reader(const RegistrySnapshot &registry)
+        {
+            //protect the snapshot, and check that it was not replaced in the meantime
+            _ptr = registry._current.load(std::memory_order_acquire);
+            while (true)
+            {
+                _slot = RegistryHazards::acquire(_ptr);
+                const auto current = registry._current.load(std::memory_order_seq_cst);
+                if (current == _ptr) break;
+                RegistryHazards::release(_slot);
+                _ptr = current;
+            }
+        }
+
+        ~Reader(void)
+        {
+            RegistryHazards::release(_slot);
+        }
+
+        const T &operator*(void) const
+        {
+            return *_ptr;
+        }
+
+        const T *operator->(void) const
+        {
+            return _ptr;
+        }
+
+    private:
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+        const T *_ptr;
+        size_t _slot;
+    };
+
+    /*!
+     * Modify a copy of the snapshot and publish it.
+     * Nothing is published when the update function throws.
+     */
+    template <typename Fcn>
+    void update(Fcn &&fcn)
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        std::unique_ptr<T> next(new T(*_current.load(std::memory_order_relaxed)));
+        fcn(*next);
+        _retired.push_back(_current.exchange(next.release(), std::memory_order_seq_cst));
+
+        //delete the replaced snapshots which are no longer read
+        for (auto it = _retired.begin(); it != _retired.end();)
+        {
+            if (RegistryHazards::isProtected(*it)) ++it;
+            else
+            {
+                delete *it;
+                it = _retired.erase(it);
+            }
+        }
+    }
+
+private:
+    std::atomic<T *> _current;
+    std::mutex _writerMutex;
+    std::vector<T *> _retired;
+};